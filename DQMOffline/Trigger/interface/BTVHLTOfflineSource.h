@@ -29,6 +29,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
 #include "DataFormats/Common/interface/TriggerResults.h"
+#include "DataFormats/Provenance/interface/ParameterSetID.h"
 #include "DataFormats/HLTReco/interface/TriggerEvent.h"
 #include "DataFormats/HLTReco/interface/TriggerObject.h"
 #include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
@@ -54,6 +55,27 @@ class BTVHLTOfflineSource : public DQMEDAnalyzer {
   virtual void bookHistograms(DQMStore::IBooker &, edm::Run const & run, edm::EventSetup const & c) override;
   virtual void dqmBeginRun(edm::Run const& run, edm::EventSetup const& c) override;
 
+  // online tag of one trigger type, matched once per event to the offline tags
+  struct TagMatch {
+    bool valid;
+    float csvOnline;
+    float pt;
+    float eta;
+    // CSV of the offline tags within DeltaR < 0.3, in collection order
+    std::vector<float> csvOffline;
+  };
+  void matchTags(const edm::Handle<reco::JetTagCollection>& online,
+                 const edm::Handle<reco::JetTagCollection>& offline,
+                 TagMatch& match) const;
+  // z of the first vertex of the collection, if there is one
+  struct VertexZ {
+    bool valid;
+    float z;
+  };
+  void leadingVertexZ(const edm::Event& iEvent,
+                      const edm::EDGetTokenT<std::vector<reco::Vertex> >& token,
+                      VertexZ& vertex) const;
+
   bool verbose_;
   std::string dirname_;
   std::string processname_;
@@ -87,6 +109,12 @@ class BTVHLTOfflineSource : public DQMEDAnalyzer {
   edm::Handle<edm::TriggerResults> triggerResults_;
   edm::TriggerNames triggerNames_;
   edm::Handle<trigger::TriggerEvent> triggerObj_;
+  // trigger names the path indices were last checked against
+  edm::ParameterSetID triggerNamesID_;
+
+  // per event scratch, shared by all paths of a trigger type
+  TagMatch pfMatch_;
+  TagMatch caloMatch_;
   
   class PathInfo {
     PathInfo():
@@ -95,7 +123,8 @@ class BTVHLTOfflineSource : public DQMEDAnalyzer {
       filterName_("unset"),
       processName_("unset"),
       objectType_(-1),
-      triggerType_("unset")
+      triggerType_("unset"),
+      triggerIndex_(-1)
       {};
   
   public:
@@ -121,7 +150,8 @@ class BTVHLTOfflineSource : public DQMEDAnalyzer {
       filterName_(filterName),
       processName_(processName),
       objectType_(type),
-      triggerType_(triggerType){};
+      triggerType_(triggerType),
+      triggerIndex_(-1){};
 
       MonitorElement * getMEhisto_CSV()               { return CSV_;}
       MonitorElement * getMEhisto_Pt()                { return Pt_; }
@@ -154,6 +184,12 @@ class BTVHLTOfflineSource : public DQMEDAnalyzer {
       const std::string getTriggerType(void ) const {
 	return triggerType_;
       }
+      unsigned int getTriggerIndex(void) const {
+	return triggerIndex_;
+      }
+      void setTriggerIndex(unsigned int index){
+	triggerIndex_ = index;
+      }
       const edm::InputTag getTag(void) const{
 	edm::InputTag tagName(filterName_,"",processName_);
 	return tagName;
@@ -171,6 +207,7 @@ class BTVHLTOfflineSource : public DQMEDAnalyzer {
       std::string processName_;
       int objectType_;
       std::string triggerType_;
+      unsigned int triggerIndex_;
 
       MonitorElement*  CSV_;
       MonitorElement*  Pt_;
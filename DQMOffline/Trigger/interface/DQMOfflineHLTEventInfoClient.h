@@ -7,6 +7,7 @@
 #include <FWCore/Framework/interface/EDAnalyzer.h>
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQMOffline/Trigger/interface/HLTSummaryAggregator.h"
 
 #include <memory>
 #include <iostream>
@@ -55,6 +56,8 @@ protected:
 private:
 
   void initialize();
+  /// refreshes the summaries from the subsystem bits which changed
+  void updateSummary();
   edm::ParameterSet parameters_;
 
   DQMStore* dbe_;  
@@ -66,13 +69,14 @@ private:
   // -------- member data --------
 
   MonitorElement * reportSummary_;
-  std::vector<MonitorElement*> reportSummaryContent_;
   MonitorElement * reportSummaryMap_;
 
   MonitorElement * CertificationSummary_;
-  std::vector<MonitorElement*> CertificationSummaryContent_;
   MonitorElement * CertificationSummaryMap_;
 
+  HLTSummaryAggregator summaryContents_;
+  std::vector<int> summaryMapBins_;   ///summary map y bin of each subsystem
+
 
 };
 
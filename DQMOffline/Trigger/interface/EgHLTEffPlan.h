@@ -0,0 +1,76 @@
+#ifndef DQMOFFLINE_TRIGGER_EGHLTEFFPLAN
+#define DQMOFFLINE_TRIGGER_EGHLTEFFPLAN
+
+//class: EffPlan
+//
+//aim: the EgHLTOfflineClient makes several thousand efficiency histograms, each of which
+//     needs a handful of DQMStore lookups by (long, concatenated) name before the division
+//     this class records the resolved (inputs, output) MonitorElements the first time the
+//     client runs so later calls (ie every end of lumi section) only redo the arithmetic
+//     if some inputs were missing when it was built, it is only valid as long as the number
+//     of source MonitorElements stays the same, the client rebuilds it otherwise
+//
+//implimentation: the divisions are done directly on the bin content and sumw2 arrays of the
+//                TH1Fs, in the order the entries were added (some outputs, the 2Leg ones, read
+//                other outputs), giving the same contents and errors as the TH1::Divide(..,"B"),
+//                TH1::Add and TH1::Multiply calls the client uses when it first creates them
+
+#include <vector>
+
+class MonitorElement;
+
+namespace egHLT {
+
+  class EffPlan {
+  public:
+    enum Type {
+      PASS_ALL,          //pass / all
+      PASS_FAIL,         //pass / (pass + fail)
+      PASS_FAIL_TAGTAG,  //(2*tagTag + passNotTag) / (2*tagTag + passNotTag + fail)
+      TWO_LEG            //leg1Eff^2 + 2*leg1Eff*(leg2NotLeg1 / all)
+    };
+
+  private:
+    struct Entry {
+      Type type;
+      MonitorElement* eff;
+      const MonitorElement* in[3];
+    };
+
+    std::vector<Entry> entries_;
+    bool isBuilt_;
+    bool isComplete_; //no input was missing when it was built
+    size_t nrSourceMEs_; //number of source MonitorElements when it was built
+
+    //scratch space reused between entries
+    mutable std::vector<double> numer_;
+    mutable std::vector<double> numerErr2_;
+    mutable std::vector<double> denom_;
+    mutable std::vector<double> denomErr2_;
+
+  public:
+    EffPlan():isBuilt_(false),isComplete_(true),nrSourceMEs_(0){}
+    ~EffPlan(){}
+
+    //for PASS_ALL and PASS_FAIL in1 is the pass histogram, for PASS_FAIL_TAGTAG in1,in2,in3 are
+    //passNotTag, fail and tagTag, for TWO_LEG they are leg1Eff, leg2NotLeg1 and all
+    void add(Type type,MonitorElement* eff,const MonitorElement* in1,const MonitorElement* in2,const MonitorElement* in3=0);
+    void setMissingInput(){isComplete_=false;}
+    void setBuilt(size_t nrSourceMEs){isBuilt_=true;nrSourceMEs_=nrSourceMEs;}
+    void clear(){entries_.clear();isBuilt_=false;isComplete_=true;nrSourceMEs_=0;}
+
+    bool isBuilt()const{return isBuilt_;}
+    bool isComplete()const{return isComplete_;}
+    size_t nrSourceMEs()const{return nrSourceMEs_;}
+    size_t size()const{return entries_.size();}
+
+    //recomputes every output histogram from the current input contents
+    void run()const;
+
+  private:
+    void runEntry_(const Entry& entry)const;
+  };
+
+}
+
+#endif
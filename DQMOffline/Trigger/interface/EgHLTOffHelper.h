@@ -52,6 +52,7 @@
 
 class EgammaHLTTrackIsolation;
 class HLTConfigProvider;
+class HLTMenuCache;
 class EcalSeverityLevelAlgo;
 
 namespace egHLT {
@@ -165,7 +166,8 @@ namespace egHLT {
     ~OffHelper();
     
     void setup(const edm::ParameterSet& conf, edm::ConsumesCollector && iC);
-    void setupTriggers(const HLTConfigProvider& config,const std::vector<std::string>& hltFiltersUsed, const TrigCodes& trigCodes);
+    void setupTriggers(const HLTConfigProvider& config,const std::vector<std::string>& hltFiltersUsed, const TrigCodes& trigCodes,
+		       const HLTMenuCache& menuCache);
 
     //int is the error code, 0 = no error
     //it should never throw, print to screen or crash, this is the only error reporting it does
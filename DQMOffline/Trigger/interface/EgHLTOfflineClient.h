@@ -26,6 +26,7 @@
 
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "DQMServices/Core/interface/DQMEDHarvester.h"
+#include "DQMOffline/Trigger/interface/EgHLTEffPlan.h"
 
 #include <vector>
 #include <string>
@@ -72,6 +73,9 @@ class EgHLTOfflineClient : public DQMEDHarvester {
   bool isSetup_;
   std::string hltTag_;
 
+  //the efficiency histograms made by runClient_, later calls just rerun it unless it has to be rebuilt
+  egHLT::EffPlan effPlan_;
+
 
   //disabling copying/assignment (in theory this is copyable but lets not just in case)
   EgHLTOfflineClient(const EgHLTOfflineClient& rhs){}
@@ -39,6 +39,8 @@
 #include "DQMOffline/Trigger/interface/EgHLTOffHelper.h"
 #include "DQMOffline/Trigger/interface/EgHLTOffEvt.h"
 #include "DQMOffline/Trigger/interface/EgHLTTrigCodes.h"
+#include "DQMOffline/Trigger/interface/HLTDQMTiming.h"
+#include "DQMOffline/Trigger/interface/HLTMenuCache.h"
 
 #include "DQMServices/Core/interface/DQMEDAnalyzer.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
@@ -88,6 +90,11 @@ class EgHLTOfflineSource : public DQMEDAnalyzer {
 
   bool filterInactiveTriggers_;
   std::string hltTag_;
+  // the active e/gamma filters of a menu, see filterTriggers
+  HLTMenuCache menuCache_;
+
+  HLTDQMTiming timing_;
+  enum TimingScope { kAnalyze, kEleFilterMon, kPhoFilterMon, kEleMonElems, kPhoMonElems };
 
   //disabling copying/assignment (copying this class would be bad, mkay)
   EgHLTOfflineSource(const EgHLTOfflineSource& rhs) = delete;
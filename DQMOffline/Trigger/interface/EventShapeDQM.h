@@ -19,6 +19,7 @@
 #include "DataFormats/HLTReco/interface/TriggerEventWithRefs.h"
 #include "DataFormats/HLTReco/interface/TriggerEventWithRefs.h"
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
+#include "DQMOffline/Trigger/interface/HLTPathMatcher.h"
 
 class EventShapeDQM: public DQMEDAnalyzer{
 public:
@@ -34,6 +35,7 @@ private:
 	edm::EDGetTokenT<reco::EvtPlaneCollection> theEPCollection_;
 
 	std::string triggerPath_;
+	HLTPathMatcher pathMatcher_;
 	int order_;
 	int EPidx_;
 	int EPlvl_;
@@ -0,0 +1,75 @@
+#ifndef FSQKinematicExpression_H
+#define FSQKinematicExpression_H
+
+// -*- C++ -*-
+//
+// Package:    DQMOffline/Trigger
+// Class:      FSQ::KinematicExpression
+//
+/**\class FSQ::KinematicExpression FSQKinematicExpression.h DQMOffline/Trigger/interface/FSQKinematicExpression.h
+
+ Description: native evaluation of the simple single object cuts and
+   drawables used by the FSQ handlers
+
+ Implementation:
+     Understands pt, eta, phi (with or without "()"), numbers, abs(),
+     unary -, + - * /, comparisons and && || !.  The expression is compiled
+     into a postfix program which is run column by column over a whole
+     KinematicBatch.  compile() returns false for anything else (methods
+     other than pt/eta/phi, at(i), ternaries, ...), the caller then keeps
+     using the reflection based StringCutObjectSelector/StringObjectFunction.
+*/
+//
+
+#include <string>
+#include <vector>
+
+namespace FSQ {
+
+// pt, eta and phi of a batch of candidates
+struct KinematicBatch {
+    std::vector<double> pt;
+    std::vector<double> eta;
+    std::vector<double> phi;
+
+    size_t size() const { return pt.size(); }
+    void resize(size_t n) { pt.resize(n); eta.resize(n); phi.resize(n); }
+    template <class T>
+    void set(size_t i, const T & cand) { pt[i] = cand.pt(); eta[i] = cand.eta(); phi[i] = cand.phi(); }
+};
+
+class KinematicExpression {
+    public:
+        enum Kind { Cut, Function };
+
+        KinematicExpression(): m_isCompiled(false) {}
+
+        // a Cut must be a comparison or a logical combination of them,
+        //  a Function an arithmetic expression, as for the reflection parsers
+        bool compile(const std::string & expression, Kind kind);
+        bool isCompiled() const { return m_isCompiled; }
+
+        // one value per candidate of the batch, 1/0 for cuts
+        void evaluate(const KinematicBatch & batch, std::vector<double> & values) const;
+
+    private:
+        enum OpCode { PushPt, PushEta, PushPhi, PushConst,
+                      Neg, Abs, Not,
+                      Add, Sub, Mul, Div,
+                      Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual,
+                      And, Or };
+        struct Op {
+            OpCode code;
+            double value;
+        };
+        class Parser;
+
+        bool m_isCompiled;
+        std::vector<Op> m_program;
+        // evaluation stack, one column per entry
+        mutable std::vector<std::vector<double> > m_stack;
+};
+
+}
+
+#endif
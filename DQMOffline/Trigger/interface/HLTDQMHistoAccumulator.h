@@ -0,0 +1,106 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTDQMHISTOACCUMULATOR_H
+#define DQMOFFLINE_TRIGGER_HLTDQMHISTOACCUMULATOR_H
+
+/*
+ Description: local, unweighted fill buffer for a booked 1D or 2D MonitorElement.
+
+ The fills are counted in a flat array with the binning of the booked histogram,
+ without going through ROOT or the DQMStore, and flush() adds the counts and the
+ fill statistics (entries, sum of x, x^2, ...) to the histogram. The bin
+ contents are the same as when filling the MonitorElement directly, as long as
+ they stay exactly representable (below 2^24 for the float histograms); the
+ mean and RMS only differ by the rounding of the summation order.
+
+ The bin lookup reproduces TAxis::FindFixBin: the uniform binning uses the same
+ expression, the variable binning a table of cells no wider than the narrowest
+ bin instead of a binary search, so that a value is at most one edge away from
+ the bin of its cell.
+
+ flush() must be called before the histogram is used, i.e. at the latest at the
+ end of each lumisection.
+*/
+
+#include <vector>
+
+class MonitorElement;
+class TAxis;
+
+class HLTDQMHistoAccumulator {
+public:
+  HLTDQMHistoAccumulator();
+  // me must be a booked 1D or 2D histogram, not a profile
+  explicit HLTDQMHistoAccumulator(MonitorElement* me);
+
+  bool isValid() const { return me_ != nullptr; }
+
+  // the fills of an accumulator without histogram are ignored
+  void fill(double x) {
+    if (!me_) return;
+    const int bin = xAxis_.bin(x);
+    ++counts_[bin];
+    ++entries_;
+    if (bin == 0 || bin > xAxis_.nBins()) return;
+    ++inRange_;
+    sumX_ += x; sumX2_ += x*x;
+  }
+  void fill(double x, double y) {
+    if (!me_) return;
+    const int binX = xAxis_.bin(x);
+    const int binY = yAxis_.bin(y);
+    ++counts_[binY*(xAxis_.nBins()+2) + binX];
+    ++entries_;
+    if (binX == 0 || binX > xAxis_.nBins() || binY == 0 || binY > yAxis_.nBins()) return;
+    ++inRange_;
+    sumX_ += x; sumX2_ += x*x; sumY_ += y; sumY2_ += y*y; sumXY_ += x*y;
+  }
+
+  // adds the pending fills to the MonitorElement and clears them
+  void flush();
+
+private:
+  class Axis {
+  public:
+    Axis();
+    void setup(const TAxis& axis);
+
+    int nBins() const { return nBins_; }
+    int bin(double x) const {
+      if (x < min_) return 0;
+      if (!(x < max_)) return nBins_+1;
+      if (edges_.empty()) return 1 + int(nBins_*(x-min_)/(max_-min_));
+      const unsigned int cell = (x-min_)*cellScale_;
+      int bin = cellBins_[cell < cellBins_.size() ? cell : cellBins_.size()-1];
+      // at most one step, unless the number of cells had to be capped
+      while (x >= edges_[bin]) ++bin;
+      while (x < edges_[bin-1]) --bin;
+      return bin;
+    }
+
+  private:
+    int nBins_;
+    double min_;
+    double max_;
+    // variable binning only: the bin edges and the bin of each cell
+    std::vector<double> edges_;
+    double cellScale_;
+    std::vector<int> cellBins_;
+  };
+
+  MonitorElement* me_;
+  Axis xAxis_;
+  Axis yAxis_;
+  bool is2D_;
+  // fills per global bin of the histogram
+  std::vector<unsigned int> counts_;
+  unsigned int entries_;
+  // the fill statistics only count the fills inside the axis ranges,
+  // as TH1::Fill does unless TH1::StatOverflows is set
+  unsigned int inRange_;
+  double sumX_;
+  double sumX2_;
+  double sumY_;
+  double sumY2_;
+  double sumXY_;
+};
+
+#endif
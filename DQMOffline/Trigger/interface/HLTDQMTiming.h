@@ -0,0 +1,84 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTDQMTIMING_H
+#define DQMOFFLINE_TRIGGER_HLTDQMTIMING_H
+
+/*
+ Description: opt-in cost instrumentation of the trigger DQM sources.
+
+ A module registers named scopes (analyze, one per sub-plotter, ...) and times
+ them with HLTDQMTiming::Scope. The thread CPU time spent in each scope is
+ published as a profile versus lumisection in HLT/Performance/<module label>,
+ together with the CPU time spent booking the histograms of the run.
+
+ The instrumentation is only compiled in with -DDQMOFFLINE_TRIGGER_TIMING,
+ e.g. by adding
+   <flags CXXFLAGS="-DDQMOFFLINE_TRIGGER_TIMING"/>
+ to the BuildFile.xml of the package. Without it the class is empty and all
+ of its methods are inline no-ops, so the instrumented modules behave and
+ perform exactly as before.
+*/
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <string>
+
+#ifdef DQMOFFLINE_TRIGGER_TIMING
+
+#include <vector>
+
+class MonitorElement;
+
+class HLTDQMTiming {
+public:
+  explicit HLTDQMTiming(const edm::ParameterSet& pset);
+
+  // scopes sharing a name share their histogram
+  unsigned int addScope(const std::string& name);
+  // forgets the scopes, for modules which rebuild their plotters every run
+  void clearScopes();
+
+  // brackets bookHistograms of the module, the scopes must be known by then
+  void beginBooking();
+  void bookHistograms(DQMStore::IBooker& iBooker);
+
+  class Scope {
+  public:
+    Scope(HLTDQMTiming& timing, unsigned int scope, unsigned int ls);
+    ~Scope();
+  private:
+    HLTDQMTiming& timing_;
+    unsigned int scope_;
+    unsigned int ls_;
+    double start_;
+  };
+
+private:
+  static double cpuTime();
+
+  std::string folder_;
+  std::vector<std::string> scopeNames_;
+  std::vector<MonitorElement*> scopeMEs_;
+  double bookingStart_;
+};
+
+#else
+
+class HLTDQMTiming {
+public:
+  explicit HLTDQMTiming(const edm::ParameterSet&) {}
+
+  unsigned int addScope(const std::string&) { return 0; }
+  void clearScopes() {}
+
+  void beginBooking() {}
+  void bookHistograms(DQMStore::IBooker&) {}
+
+  class Scope {
+  public:
+    Scope(HLTDQMTiming&, unsigned int, unsigned int) {}
+  };
+};
+
+#endif
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTDQMTRIGGERGATE_H
+#define DQMOFFLINE_TRIGGER_HLTDQMTRIGGERGATE_H
+
+/*
+ Description: drop-in replacement of GenericTriggerEventFlag for the event
+ selection of the DQM modules, configured by the same parameter set, which
+ avoids re-evaluating the selection from scratch in every event.
+
+ - DCS: the status of the partitions does not change within a lumisection, so
+   the DCS decision is taken on the first event of each lumisection and reused
+   for the others. It has to be taken on an event, the DcsStatus being an event
+   product.
+ - HLT: the path expressions are compiled into the TriggerResults indices of
+   the paths they select, once per menu (in practice once per run), so that
+   the decision of an event is a few bit tests.
+
+ Only the configurations with DCS and HLT path selections are compiled, the
+ HLT expressions being path names, with wildcards and an optional leading "~".
+ With L1 or GT selections, expressions read from the database or logical
+ expressions, the gate falls back to GenericTriggerEventFlag::accept().
+
+ Header only, as it is used by the modules of both the package library and the
+ plugins library.
+*/
+
+#include "CommonTools/TriggerUtils/interface/GenericTriggerEventFlag.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/TriggerResults.h"
+#include "DataFormats/Provenance/interface/LuminosityBlockID.h"
+#include "DataFormats/Provenance/interface/ParameterSetID.h"
+#include "DataFormats/Scalers/interface/DcsStatus.h"
+#include "FWCore/Common/interface/TriggerNames.h"
+#include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/RegexMatch.h"
+
+#include <string>
+#include <vector>
+
+class HLTDQMTriggerGate {
+public:
+  // the TriggerResults indices selected by one expression
+  struct PathTest {
+    PathTest(): negate(false) {}
+    std::vector<unsigned int> indices;
+    bool negate;
+  };
+
+  template <typename T>
+  HLTDQMTriggerGate(const edm::ParameterSet& config, edm::ConsumesCollector&& iC, T& module);
+
+  bool on() const { return flag_.on(); }
+  void initRun(const edm::Run& run, const edm::EventSetup& setup);
+  bool accept(const edm::Event& event, const edm::EventSetup& setup);
+
+  // as GenericTriggerEventFlag: an unknown path or a path in error counts as
+  // errorReply, the paths matching a wildcard are ORed, and only then is the
+  // result negated
+  static bool acceptPathTest(const PathTest& test, const edm::TriggerResults& results, bool errorReply);
+
+private:
+  static bool isCompilable(const edm::ParameterSet& config);
+  bool acceptDcs(const edm::Event& event);
+  bool acceptDcsPartitions(const edm::Event& event) const;
+  bool acceptHlt(const edm::Event& event);
+  void compileHlt(const edm::TriggerNames& triggerNames);
+
+  const bool compiled_;
+  const bool andOr_;
+
+  const bool onDcs_;
+  std::vector<int> dcsPartitions_;
+  bool andOrDcs_;
+  bool errorReplyDcs_;
+  edm::EDGetTokenT<DcsStatusCollection> dcsToken_;
+  edm::LuminosityBlockID dcsLumi_;
+  bool dcsAccept_;
+
+  const bool onHlt_;
+  std::vector<std::string> hltPaths_;
+  bool andOrHlt_;
+  bool errorReplyHlt_;
+  edm::EDGetTokenT<edm::TriggerResults> hltToken_;
+  // the menu hltTests_ were compiled for
+  edm::ParameterSetID triggerNamesID_;
+  std::vector<PathTest> hltTests_;
+
+  GenericTriggerEventFlag flag_;
+};
+
+template <typename T>
+HLTDQMTriggerGate::HLTDQMTriggerGate(const edm::ParameterSet& config, edm::ConsumesCollector&& iC, T& module):
+  compiled_(isCompilable(config)),
+  andOr_(config.exists("andOr") && config.getParameter<bool>("andOr")),
+  onDcs_(config.exists("dcsInputTag")),
+  andOrDcs_(false),
+  errorReplyDcs_(false),
+  dcsAccept_(false),
+  onHlt_(config.exists("hltInputTag")),
+  andOrHlt_(false),
+  errorReplyHlt_(false),
+  flag_(config, iC, module)
+{
+  if (!compiled_) return;
+  if (onDcs_) {
+    dcsPartitions_ = config.getParameter<std::vector<int> >("dcsPartitions");
+    andOrDcs_      = config.getParameter<bool>("andOrDcs");
+    errorReplyDcs_ = config.getParameter<bool>("errorReplyDcs");
+    dcsToken_      = iC.consumes<DcsStatusCollection>(config.getParameter<edm::InputTag>("dcsInputTag"));
+  }
+  if (onHlt_) {
+    hltPaths_      = config.getParameter<std::vector<std::string> >("hltPaths");
+    andOrHlt_      = config.getParameter<bool>("andOrHlt");
+    errorReplyHlt_ = config.getParameter<bool>("errorReplyHlt");
+    hltToken_      = iC.consumes<edm::TriggerResults>(config.getParameter<edm::InputTag>("hltInputTag"));
+  }
+}
+
+// the configurations whose decision is the same once compiled
+inline bool HLTDQMTriggerGate::isCompilable(const edm::ParameterSet& config) {
+  if (!config.exists("andOr")) return false;
+  if (config.exists("l1Algorithms") || config.exists("gtInputTag")) return false;
+  if (!config.exists("hltInputTag")) return true;
+  if (config.exists("hltDBKey") && !config.getParameter<std::string>("hltDBKey").empty()) return false;
+
+  // single path names, the logical expressions are left to GenericTriggerEventFlag
+  const std::vector<std::string> paths = config.getParameter<std::vector<std::string> >("hltPaths");
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const std::string& path = paths[i];
+    const size_t begin = (!path.empty() && path[0] == '~') ? 1 : 0;
+    if (path.size() == begin) return false;
+    if (path.find_first_of(" \t()", begin) != std::string::npos) return false;
+  }
+  return true;
+}
+
+inline void HLTDQMTriggerGate::initRun(const edm::Run& run, const edm::EventSetup& setup) {
+  if (!compiled_) {
+    flag_.initRun(run, setup);
+    return;
+  }
+  dcsLumi_ = edm::LuminosityBlockID();
+  triggerNamesID_ = edm::ParameterSetID();
+}
+
+inline bool HLTDQMTriggerGate::accept(const edm::Event& event, const edm::EventSetup& setup) {
+  if (!compiled_) return flag_.accept(event, setup);
+
+  if (andOr_) return acceptDcs(event) || acceptHlt(event);
+  return acceptDcs(event) && acceptHlt(event);
+}
+
+inline bool HLTDQMTriggerGate::acceptDcs(const edm::Event& event) {
+  // as in GenericTriggerEventFlag, a missing selection is neutral
+  if (!onDcs_ || dcsPartitions_.empty()) return !andOr_;
+
+  const edm::LuminosityBlockID lumi(event.id().run(), event.id().luminosityBlock());
+  if (lumi != dcsLumi_) {
+    dcsAccept_ = acceptDcsPartitions(event);
+    dcsLumi_ = lumi;
+  }
+  return dcsAccept_;
+}
+
+inline bool HLTDQMTriggerGate::acceptDcsPartitions(const edm::Event& event) const {
+  edm::Handle<DcsStatusCollection> dcsStatus;
+  event.getByToken(dcsToken_, dcsStatus);
+  if (!dcsStatus.isValid() || dcsStatus->empty()) return errorReplyDcs_;
+
+  const DcsStatus& status = dcsStatus->front();
+  for (size_t i = 0; i < dcsPartitions_.size(); ++i) {
+    bool ready = errorReplyDcs_;
+    switch (dcsPartitions_[i]) {
+    case DcsStatus::EBp   : case DcsStatus::EBm  : case DcsStatus::EEp    : case DcsStatus::EEm   :
+    case DcsStatus::HBHEa : case DcsStatus::HBHEb: case DcsStatus::HBHEc  : case DcsStatus::HF    :
+    case DcsStatus::HO    : case DcsStatus::RPC  : case DcsStatus::DT0    : case DcsStatus::DTp   :
+    case DcsStatus::DTm   : case DcsStatus::CSCp : case DcsStatus::CSCm   : case DcsStatus::CASTOR:
+    case DcsStatus::TIBTID: case DcsStatus::TOB  : case DcsStatus::TECp   : case DcsStatus::TECm  :
+    case DcsStatus::BPIX  : case DcsStatus::FPIX : case DcsStatus::ESp    : case DcsStatus::ESm   :
+      ready = status.ready(dcsPartitions_[i]);
+      break;
+    default:
+      break;
+    }
+    if (andOrDcs_ && ready) return true;
+    if (!andOrDcs_ && !ready) return false;
+  }
+  return !andOrDcs_;
+}
+
+inline bool HLTDQMTriggerGate::acceptHlt(const edm::Event& event) {
+  if (!onHlt_ || hltPaths_.empty()) return !andOr_;
+
+  edm::Handle<edm::TriggerResults> results;
+  event.getByToken(hltToken_, results);
+  if (!results.isValid()) return errorReplyHlt_;
+
+  if (results->parameterSetID() != triggerNamesID_) {
+    compileHlt(event.triggerNames(*results));
+    triggerNamesID_ = results->parameterSetID();
+  }
+
+  for (size_t i = 0; i < hltTests_.size(); ++i) {
+    const bool pass = acceptPathTest(hltTests_[i], *results, errorReplyHlt_);
+    if (andOrHlt_ && pass) return true;
+    if (!andOrHlt_ && !pass) return false;
+  }
+  return !andOrHlt_;
+}
+
+inline void HLTDQMTriggerGate::compileHlt(const edm::TriggerNames& triggerNames) {
+  hltTests_.clear();
+  hltTests_.resize(hltPaths_.size());
+  for (size_t i = 0; i < hltPaths_.size(); ++i) {
+    PathTest& test = hltTests_[i];
+    test.negate = hltPaths_[i][0] == '~';
+    const std::string path = hltPaths_[i].substr(test.negate ? 1 : 0);
+
+    if (edm::is_glob(path)) {
+      const std::vector<std::vector<std::string>::const_iterator> matches =
+        edm::regexMatch(triggerNames.triggerNames(), path);
+      for (size_t j = 0; j < matches.size(); ++j)
+        test.indices.push_back(matches[j] - triggerNames.triggerNames().begin());
+    }
+    else {
+      const unsigned int index = triggerNames.triggerIndex(path);
+      if (index < triggerNames.size()) test.indices.push_back(index);
+    }
+  }
+}
+
+inline bool HLTDQMTriggerGate::acceptPathTest(const PathTest& test, const edm::TriggerResults& results, bool errorReply) {
+  bool pass = test.indices.empty() ? errorReply : false;
+  for (size_t i = 0; i < test.indices.size(); ++i) {
+    const unsigned int index = test.indices[i];
+    pass = pass || (results.error(index) ? errorReply : results.accept(index));
+  }
+  return test.negate ? !pass : pass;
+}
+
+#endif
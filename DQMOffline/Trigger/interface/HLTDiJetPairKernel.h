@@ -0,0 +1,89 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTDIJETPAIRKERNEL_H
+#define DQMOFFLINE_TRIGGER_HLTDIJETPAIRKERNEL_H
+
+/*
+ Description: dijet pair quantities (delta eta, delta phi, invariant mass) over
+ a set of jets held as flat arrays (structure of arrays).
+
+ The jets are copied once per event with push_back, from anything with the
+ energy(), px(), py(), pz(), pt(), eta() and phi() accessors (reco jets,
+ trigger::TriggerObject, ...), in the order in which the pairs should be
+ visited. firstPair() then looks for the first pair passing pt, delta eta and
+ invariant mass thresholds: jets below the thresholds never start a row, and
+ each row computes the cut flags and the squared masses of all its pairs in one
+ branch-free loop over the arrays, which the compiler can vectorize, before
+ looking for the first pair passing them. The square root is only taken for
+ the pairs passing the other cuts.
+
+ The quantities are computed in double precision and with the same expressions
+ as the per pair code they replace, so the selected pairs are the same.
+*/
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+
+#include <cmath>
+#include <vector>
+
+class HLTDiJetPairKernel {
+public:
+  // the first jet of a pair must have pt >= minPtHigh, the second pt >= minPtLow
+  struct Cuts {
+    Cuts(): minPtHigh(0.), minPtLow(0.), minDeltaEta(0.), minInvMass(0.), etaOpposite(false) {}
+    double minPtHigh;
+    double minPtLow;
+    double minDeltaEta;
+    double minInvMass;
+    // both jets in opposite eta hemispheres
+    bool etaOpposite;
+  };
+
+  void clear();
+
+  template <class Jet>
+  void push_back(const Jet& jet) {
+    e_.push_back(jet.energy());
+    px_.push_back(jet.px());
+    py_.push_back(jet.py());
+    pz_.push_back(jet.pz());
+    pt_.push_back(jet.pt());
+    eta_.push_back(jet.eta());
+    phi_.push_back(jet.phi());
+  }
+
+  unsigned int size() const { return e_.size(); }
+
+  double energy(unsigned int i) const { return e_[i]; }
+  double pt(unsigned int i) const { return pt_[i]; }
+  double eta(unsigned int i) const { return eta_[i]; }
+  double phi(unsigned int i) const { return phi_[i]; }
+
+  double deltaEta(unsigned int i, unsigned int j) const { return eta_[i] - eta_[j]; }
+  double deltaPhi(unsigned int i, unsigned int j) const { return reco::deltaPhi(phi_[i], phi_[j]); }
+  double invMass(unsigned int i, unsigned int j) const { return std::sqrt(invMass2(i, j)); }
+
+  // first pair i < j, in the order of i then j, passing the cuts
+  bool firstPair(const Cuts& cuts, unsigned int& i, unsigned int& j) const;
+
+private:
+  double invMass2(unsigned int i, unsigned int j) const {
+    const double e  = e_[i]  + e_[j];
+    const double px = px_[i] + px_[j];
+    const double py = py_[i] + py_[j];
+    const double pz = pz_[i] + pz_[j];
+    return e*e - px*px - py*py - pz*pz;
+  }
+
+  std::vector<double> e_;
+  std::vector<double> px_;
+  std::vector<double> py_;
+  std::vector<double> pz_;
+  std::vector<double> pt_;
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+
+  // per row scratch of firstPair
+  mutable std::vector<double> rowMass2_;
+  mutable std::vector<char> rowPass_;
+};
+
+#endif
@@ -44,6 +44,8 @@
 #include "RecoEgamma/EgammaTools/interface/EffectiveAreas.h"
 
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "DQMOffline/Trigger/interface/HLTDQMHistoAccumulator.h"
+#include "DQMOffline/Trigger/interface/HLTElectronTnPColumns.h"
 
 #include <vector>
 #include "TFile.h"
@@ -79,6 +81,10 @@ class HLTElectronMatchAndPlot
 	       edm::Handle<reco::VertexCollection> &, edm::Handle<trigger::TriggerEvent> &, 
 	       edm::Handle<edm::TriggerResults> &);
   void endRun(const edm::Run &, const edm::EventSetup &);
+  // flushes the histogram fills of the lumisection into the MonitorElements
+  void endLuminosityBlock();
+  // records the matches of this filter, and the pairs if it is the last one
+  void setTnPColumns(HLTElectronTnPColumns *, unsigned int path, unsigned int filter);
 
   // Helper Methods
   void fillEdges(size_t & nBins, float * & edges, const std::vector<double>& binning);
@@ -90,9 +96,24 @@ class HLTElectronMatchAndPlot
   
  private:
 
+  // the fill buffers of the efficiency and fake rate plots, of one suffix
+  struct EfficiencyAccumulators {
+    HLTDQMHistoAccumulator eta, phi, turnOn, vertex, phiVsEta, charge;
+    HLTDQMHistoAccumulator fakerateEta, fakeratePhi, fakerateTurnOn, fakerateVertex, fakeratePhiVsEta;
+    void flush();
+  };
+  // the fill buffers of the tag and probe plots, of one suffix and one region
+  struct TnPAccumulators {
+    HLTDQMHistoAccumulator mass, eta, pt, vertex, phiVsEta, sigmaIetaIeta, hoe, isoPFCorrRel;
+    void flush();
+  };
+
   // Internal Methods
-  void book1D(DQMStore::IBooker &, std::string, std::string, std::string);
-  void book2D(DQMStore::IBooker &, std::string, std::string, std::string, std::string);
+  // book the histogram and bind the accumulator to it
+  void book1D(DQMStore::IBooker &, std::string, std::string, std::string,
+              HLTDQMHistoAccumulator &);
+  void book2D(DQMStore::IBooker &, std::string, std::string, std::string, std::string,
+              HLTDQMHistoAccumulator &);
   reco::GsfElectronCollection selectedElectrons(
     const reco::GsfElectronCollection &,
     const reco::BeamSpot &,
@@ -122,6 +143,14 @@ class HLTElectronMatchAndPlot
   std::string moduleLabel_;
   bool isLastFilter_;
   std::map<std::string, MonitorElement *> hists_;
+  // the fills go through these, see endLuminosityBlock; bound to their
+  // histogram in beginRun, those not booked for this filter ignore the fills
+  HLTDQMHistoAccumulator hltPt_, hltEta_, hltPhi_;
+  HLTDQMHistoAccumulator resolutionPt_, resolutionEta_, resolutionPhi_, deltaR_;
+  // indexed as EFFICIENCY_SUFFIXES
+  EfficiencyAccumulators efficiency_[2];
+  TnPAccumulators tnpEB_[2];
+  TnPAccumulators tnpEE_[2];
   
   // Selectors
   bool hasTargetRecoCuts;                                                                                                                                                                                                                                                    
@@ -140,6 +169,11 @@ class HLTElectronMatchAndPlot
   bool hasTriggerCuts_;
   EffectiveAreas effectiveAreas_;
 
+  // not owned, optional
+  HLTElectronTnPColumns * tnpColumns_;
+  unsigned int tnpPath_;
+  unsigned int tnpFilter_;
+
 };
 
 #endif
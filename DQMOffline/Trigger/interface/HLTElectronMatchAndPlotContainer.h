@@ -23,6 +23,8 @@
 #include "FWCore/Framework/interface/ConsumesCollector.h"
 
 #include "DQMOffline/Trigger/interface/HLTElectronMatchAndPlot.h"
+#include "DQMOffline/Trigger/interface/HLTDQMTiming.h"
+#include "DQMOffline/Trigger/interface/HLTElectronTnPColumns.h"
 
 #include "DataFormats/HLTReco/interface/TriggerEvent.h"
 #include "DataFormats/HLTReco/interface/TriggerEventWithRefs.h"
@@ -38,6 +40,7 @@
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include<memory>
 #include<vector>
 #include<string>
 
@@ -63,11 +66,21 @@ class HLTElectronMatchAndPlotContainer
   void beginRun(DQMStore::IBooker &, const edm::Run &, const edm::EventSetup &);
   void analyze(const edm::Event &, const edm::EventSetup &);
   void endRun(const edm::Run &, const edm::EventSetup &);
+  void endLuminosityBlock(const edm::LuminosityBlock &, const edm::EventSetup &);
 
  private:
 
   std::vector<HLTElectronMatchAndPlot> plotters_;
 
+  // timing scope 0 is analyze, scope i+1 the plotter i
+  HLTDQMTiming timing_;
+
+  // tag and probe ntuple, only with tnpColumnsFile; the filters of the path
+  // being added, handed to the columns with its last filter
+  std::unique_ptr<HLTElectronTnPColumns> tnpColumns_;
+  std::string tnpPathName_;
+  std::vector<std::string> tnpFilters_;
+
   edm::EDGetTokenT<double> rhoToken_;
   edm::EDGetTokenT<reco::ConversionCollection> convsToken_;
   edm::EDGetTokenT<reco::BeamSpot> bsToken_;
@@ -0,0 +1,77 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTELECTRONTNPCOLUMNS_H
+#define DQMOFFLINE_TRIGGER_HLTELECTRONTNPCOLUMNS_H
+
+/*
+ Description: optional flat ntuple of the electron tag-and-probe pairs, written
+ next to the DQM output, so that the efficiencies can be rebinned or refitted
+ without rerunning the DQM job.
+
+ There is one TTree per HLT path, with one row per tag-probe pair and one
+ branch (column) per quantity: run, lumi, event, the probe kinematics and
+ identification variables, the pair mass, the number of vertices and a bitmask
+ of the filters of the path the probe is matched to (bit i for the i-th
+ filter, as listed in the UserInfo of the tree, up to 32 filters). The
+ branches are split and compressed by ROOT, so that reading a few columns
+ only reads these.
+
+ All the stream copies of a module writing the same file share it. The rows
+ are buffered per copy and appended to the trees in batches, under a lock.
+*/
+
+#include "DataFormats/Provenance/interface/EventID.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class HLTElectronTnPColumns {
+public:
+  struct Row {
+    unsigned int run;
+    unsigned int lumi;
+    unsigned long long event;
+    unsigned int filterBits;
+    unsigned int nVertices;
+    float mass;
+    float tagPt;
+    float tagEta;
+    float probePt;
+    float probeEta;
+    float probePhi;
+    float probeSCEta;
+    float probeSigmaIetaIeta;
+    float probeHoE;
+    float probeIsoPFCorrRel;
+  };
+
+  HLTElectronTnPColumns(const std::string& fileName, unsigned int batchSize);
+  // writes the rows left
+  ~HLTElectronTnPColumns();
+
+  // returns the index of the path, filters in path order
+  unsigned int addPath(const std::string& path, const std::vector<std::string>& filters);
+
+  // clears the filter matches of the previous event
+  void beginEvent(const edm::EventID& id);
+  // electron is the index of the probe among the electrons of the plotters
+  void setPassed(unsigned int path, unsigned int filter, unsigned int electron);
+  // fills run, lumi, event and the filter bits of the probe
+  void fill(unsigned int path, unsigned int probe, Row& row);
+
+  void flush();
+
+  class Writer;
+
+private:
+  std::shared_ptr<Writer> writer_;
+  unsigned int batchSize_;
+  std::vector<std::string> paths_;
+  edm::EventID eventID_;
+  // per path, the filter bits of each electron of the event
+  std::vector<std::vector<unsigned int> > electronBits_;
+  // per path, the rows not written yet
+  std::vector<std::vector<Row> > rows_;
+  unsigned int nRows_;
+};
+
+#endif
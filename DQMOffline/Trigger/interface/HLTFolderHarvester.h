@@ -0,0 +1,79 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTFOLDERHARVESTER
+#define DQMOFFLINE_TRIGGER_HLTFOLDERHARVESTER
+
+// -*- C++ -*-
+//
+// Class: HLTFolderHarvester
+//
+/*
+ Description: shared end-of-job helper for the HLT harvesting clients which walk
+ the DQMStore folder tree and then do independent work per folder.
+
+ The folder list and the MonitorElements of each folder are read from the store
+ once, before the per-folder work.
+
+ Header only, as it is used by the clients of both the package library and the
+ plugins library.
+*/
+//
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include <string>
+#include <vector>
+
+class HLTFolderHarvester {
+public:
+  struct Folder {
+    std::string path;
+    std::vector<MonitorElement*> contents;
+
+    // the ME of this folder with the given name, or NULL
+    MonitorElement* find(const std::string& name) const {
+      for(MonitorElement* me: contents) {
+        if(me && me->getName() == name)
+          return me;
+      }
+      return NULL;
+    }
+  };
+
+  // snapshots a folder and its MonitorElements
+  template<typename Getter>
+  void addFolder(Getter& getter, const std::string& path) {
+    Folder folder;
+    folder.path = path;
+    folder.contents = getter.getContents(path);
+    folders_.push_back(folder);
+  }
+
+  // the direct subfolders of folder
+  template<typename Getter>
+  static std::vector<std::string> subdirs(Getter& getter, const std::string& folder) {
+    getter.setCurrentFolder(folder);
+    return getter.getSubdirs();
+  }
+
+  // folder and all its subfolders, depth first
+  template<typename Getter>
+  static std::vector<std::string> subdirsRecursive(Getter& getter, const std::string& folder) {
+    std::vector<std::string> found;
+    std::vector<std::string> toVisit(1, folder);
+    while(!toVisit.empty()) {
+      const std::string dir = toVisit.back();
+      toVisit.pop_back();
+      found.push_back(dir);
+      const std::vector<std::string> children = subdirs(getter, dir);
+      toVisit.insert(toVisit.end(), children.rbegin(), children.rend());
+    }
+    return found;
+  }
+
+  const std::vector<Folder>& folders() const { return folders_; }
+
+private:
+  std::vector<Folder> folders_;
+};
+
+#endif
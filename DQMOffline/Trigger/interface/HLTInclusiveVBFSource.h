@@ -20,6 +20,8 @@
 #include "DQMServices/Core/interface/DQMEDAnalyzer.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 
+#include "DQMOffline/Trigger/interface/HLTDiJetPairKernel.h"
+
 #include "DataFormats/Common/interface/TriggerResults.h"
 #include "DataFormats/HLTReco/interface/TriggerEvent.h"
 #include "DataFormats/HLTReco/interface/TriggerObject.h"
@@ -117,38 +119,22 @@ class HLTInclusiveVBFSource : public DQMEDAnalyzer {
   std::string pathname;
   std::string filtername;
 
-  double reco_ejet1; 
   //double reco_etjet1;
-  double reco_pxjet1;
-  double reco_pyjet1;
-  double reco_pzjet1;
   double reco_ptjet1;
   double reco_etajet1;
   double reco_phijet1;
   //
-  double reco_ejet2;
   //double reco_etjet2;
-  double reco_pxjet2;
-  double reco_pyjet2;
-  double reco_pzjet2;
   double reco_ptjet2;
   double reco_etajet2;
   double reco_phijet2;
   //  
-  double hlt_ejet1;
   //double hlt_etjet1;
-  double hlt_pxjet1;
-  double hlt_pyjet1;
-  double hlt_pzjet1;
   double hlt_ptjet1;
   double hlt_etajet1;
   double hlt_phijet1;
   //
-  double hlt_ejet2 ;
   //double hlt_etjet2;
-  double hlt_pxjet2;
-  double hlt_pyjet2;
-  double hlt_pzjet2;
   double hlt_ptjet2;
   double hlt_etajet2;
   double hlt_phijet2;
@@ -170,6 +156,11 @@ class HLTInclusiveVBFSource : public DQMEDAnalyzer {
   double hlt_deltaetajet;
   double hlt_deltaphijet;
   double hlt_invmassjet;
+
+  // offline jets passing the jet ID, and trigger objects of one filter
+  HLTDiJetPairKernel recoJets_;
+  HLTDiJetPairKernel hltJets_;
+  HLTDiJetPairKernel::Cuts recoCuts_;
   
   // helper class to store the data path
   
@@ -0,0 +1,44 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTMENUCACHE_H
+#define DQMOFFLINE_TRIGGER_HLTMENUCACHE_H
+
+/*
+ Description: cache of tables derived from an HLT menu (lists of path, filter
+ or module names), keyed by the ParameterSetID of the HLT process, so that an
+ expensive expansion of the menu is done once per menu instead of once per
+ module, stream and run.
+
+ The tables are kept in memory for the whole process, shared by all modules.
+ With a directory, they are also written there, one small text file per menu
+ and table, and read back by the next jobs on the same menu. The files are
+ written to a temporary name and renamed, so concurrent jobs only ever see
+ complete files; a file which cannot be read is simply recomputed.
+
+ Only derivations which depend on nothing but the menu may be cached.
+*/
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+class HLTConfigProvider;
+
+class HLTMenuCache {
+public:
+  typedef std::map<std::string, std::vector<std::string> > Tables;
+
+  // an empty directory keeps the cache in memory only
+  explicit HLTMenuCache(const std::string& directory = "");
+
+  // the tables stored under key for the menu of hltConfig, computed by make on a miss
+  Tables get(const HLTConfigProvider& hltConfig, const std::string& key,
+             const std::function<Tables()>& make) const;
+
+private:
+  bool read(const std::string& fileName, const std::string& header, Tables& tables) const;
+  void write(const std::string& fileName, const std::string& header, const Tables& tables) const;
+
+  std::string directory_;
+};
+
+#endif
@@ -55,6 +55,33 @@ const double NOMATCH = 999.;
 const std::string EFFICIENCY_SUFFIXES[2] = {"denom", "numer"};
 
 
+//////////////////////////////////////////////////////////////////////////////
+//////// Shared Muon View ////////////////////////////////////////////////////
+
+/// Per-event view of the reco muons, filled once by HLTMuonMatchAndPlotContainer
+/// and shared by all its plotters.  The arrays are indexed like the muon
+/// collection; track is the inner track for tracker muons, the outer track for
+/// standalone muons and 0 otherwise, d0 and z0 are taken w.r.t. the beam spot.
+/// selections holds, for each distinct target selection registered by the
+/// plotters, the indices of the muons passing it.
+struct HLTMuonView 
+{
+  std::vector<const reco::Muon *> muons;
+  std::vector<const reco::Track *> tracks;
+  std::vector<double> d0;
+  std::vector<double> z0;
+  std::vector<double> pt;
+  std::vector<double> eta;
+  std::vector<double> phi;
+  std::vector<int> charge;
+  std::vector<std::vector<size_t> > selections;
+  size_t nVertices;
+
+  void fill(const reco::MuonCollection &, const reco::BeamSpot &, size_t);
+  size_t size() const { return muons.size(); }
+};
+
+
 //////////////////////////////////////////////////////////////////////////////
 //////// HLTMuonMatchAndPlot Class Definition ////////////////////////////////
 
@@ -68,11 +95,16 @@ class HLTMuonMatchAndPlot
 
   // Analyzer Methods
   void beginRun(DQMStore::IBooker &, const edm::Run &, const edm::EventSetup &);
-  void analyze(edm::Handle<reco::MuonCollection> &, edm::Handle<reco::BeamSpot> &, 
-	       edm::Handle<reco::VertexCollection> &, edm::Handle<trigger::TriggerEvent> &, 
-	       edm::Handle<edm::TriggerResults> &);
+  void analyze(const HLTMuonView &, const trigger::TriggerEvent &);
   void endRun(const edm::Run &, const edm::EventSetup &);
 
+  // Target selection, evaluated by the container into HLTMuonView::selections
+  bool hasTargetRecoCuts() const { return hasTargetRecoCuts_; }
+  const std::string & targetRecoCuts() const { return targetRecoCuts_; }
+  double targetD0Cut() const { return targetD0Cut_; }
+  double targetZ0Cut() const { return targetZ0Cut_; }
+  void setTargetSelection(size_t index) { targetSelection_ = index; }
+
   // Helper Methods
   void fillEdges(size_t & nBins, float * & edges, const std::vector<double>& binning);
   template <class T> void 
@@ -83,21 +115,24 @@ class HLTMuonMatchAndPlot
   
  private:
 
+  // Histogram slots, booked in beginRun.  The efficiency and fake rate ones
+  // exist once per EFFICIENCY_SUFFIXES entry; the mass ones are laid out
+  // eta, pt, vertex for each MassWindow.
+  enum Hist { HLT_PT, HLT_ETA, HLT_PHI, RESOLUTION_ETA, RESOLUTION_PHI, 
+              RESOLUTION_PT, DELTA_R, NR_HISTS };
+  enum EffHist { EFF_ETA, EFF_PHI, EFF_TURNON, EFF_VERTEX, EFF_PHIVSETA, 
+                 EFF_D0, EFF_Z0, EFF_CHARGE, 
+                 FAKE_ETA, FAKE_VERTEX, FAKE_PHI, FAKE_TURNON, 
+                 MASS_ETA_Z, MASS_PT_Z, MASS_VERTEX_Z, 
+                 MASS_ETA_JPSI, MASS_PT_JPSI, MASS_VERTEX_JPSI, NR_EFF_HISTS };
+  enum MassWindow { Z_WINDOW, JPSI_WINDOW, NR_MASS_WINDOWS };
+
   // Internal Methods
-  void book1D(DQMStore::IBooker &, std::string, std::string, std::string);
-  void book2D(DQMStore::IBooker &, std::string, std::string, std::string, std::string);
-  reco::MuonCollection selectedMuons(
-    const reco::MuonCollection &,
-    const reco::BeamSpot &,
-    bool,    
-    const StringCutObjectSelector<reco::Muon> &,
-    double, double);
-
-  trigger::TriggerObjectCollection selectedTriggerObjects(
-    const trigger::TriggerObjectCollection &,
-    const trigger::TriggerEvent &,
-    bool hasTriggerCuts,
-    const StringCutObjectSelector<trigger::TriggerObject> triggerSelector);
+  MonitorElement * book1D(DQMStore::IBooker &, std::string, std::string, std::string);
+  MonitorElement * book2D(DQMStore::IBooker &, std::string, std::string, std::string, std::string);
+  void selectedTriggerObjects(const trigger::TriggerEvent &, 
+                              trigger::TriggerObjectCollection &);
+  void matchTargetsToHlt(const HLTMuonView &, const std::vector<size_t> &);
  
   // Input from Configuration File
   std::string hltProcessName_;
@@ -106,32 +141,36 @@ class HLTMuonMatchAndPlot
   std::map<std::string, std::vector<double> > binParams_;
   std::map<std::string, double> plotCuts_;
   edm::ParameterSet targetParams_;
-  edm::ParameterSet probeParams_;
 
   // Member Variables
   std::string triggerLevel_;
   unsigned int cutMinPt_;
   std::string hltPath_;
   std::string moduleLabel_;
+  edm::InputTag filterTag_;
   bool isLastFilter_;
-  std::map<std::string, MonitorElement *> hists_;
+  double maxDeltaR_;
+  double maxEta_;
+  MonitorElement * hists_[NR_HISTS];
+  MonitorElement * effHists_[2][NR_EFF_HISTS];
   
   // Selectors
-  bool hasTargetRecoCuts;                                                                                                                                                                                                                                                    
-  bool hasProbeRecoCuts;
-    
-  StringCutObjectSelector<reco::Muon> targetMuonSelector_;
+  bool hasTargetRecoCuts_;
+  std::string targetRecoCuts_;
   double targetZ0Cut_; 
   double targetD0Cut_;
-  double targetptCutZ_;
-  double targetptCutJpsi_;
-  StringCutObjectSelector<reco::Muon> probeMuonSelector_;
-  double probeZ0Cut_; 
-  double probeD0Cut_;
+  double targetptCut_[NR_MASS_WINDOWS];
+  size_t targetSelection_;
 
   StringCutObjectSelector<trigger::TriggerObject> triggerSelector_;
   bool hasTriggerCuts_;
 
+  // Per-event scratch, kept to reuse the allocations
+  trigger::TriggerObjectCollection hltMuons_;
+  std::vector<size_t> matches_;
+  std::vector<size_t> hltMatches_;
+  std::vector<double> deltaRMatrix_;
+
 };
 
 #endif
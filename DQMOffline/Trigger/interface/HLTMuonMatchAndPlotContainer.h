@@ -34,6 +34,8 @@
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+
 #include<vector>
 #include<string>
 
@@ -62,7 +64,17 @@ class HLTMuonMatchAndPlotContainer
 
  private:
 
+  // A target selection shared by all the plotters configured with it
+  struct MuonSelection {
+    std::string recoCuts;
+    double d0Cut;
+    double z0Cut;
+    StringCutObjectSelector<reco::Muon> selector;
+  };
+
   std::vector<HLTMuonMatchAndPlot> plotters_;
+  std::vector<MuonSelection> selections_;
+  HLTMuonView view_;
 
   edm::EDGetTokenT<reco::BeamSpot> bsToken_;
   edm::EDGetTokenT<reco::MuonCollection> muonToken_;
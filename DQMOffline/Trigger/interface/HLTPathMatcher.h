@@ -0,0 +1,50 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTPATHMATCHER_H
+#define DQMOFFLINE_TRIGGER_HLTPATHMATCHER_H
+
+/*
+ Description: selects the HLT paths whose name contains a substring, or matches a
+ regular expression, and tells whether any of them fired in an event.
+
+ The selection is resolved into a list of path indices once per TriggerNames
+ parameterSetID, ie once per menu, so the per-event check only tests the
+ wasrun/accept bits of the selected paths.
+*/
+
+#include "DataFormats/Provenance/interface/ParameterSetID.h"
+
+#include <boost/regex.hpp>
+
+#include <string>
+#include <vector>
+
+namespace edm {
+  class TriggerNames;
+  class TriggerResults;
+}
+
+class HLTPathMatcher {
+public:
+  enum Mode { Substring, Regex };
+
+  explicit HLTPathMatcher(const std::string& pattern, Mode mode = Substring);
+
+  // indices of the selected paths, resolved again only when the menu changes
+  const std::vector<unsigned int>& indices(const edm::TriggerNames& triggerNames);
+
+  // true if any selected path was run and accepted the event
+  bool accept(const edm::TriggerNames& triggerNames, const edm::TriggerResults& triggerResults);
+
+  const std::string& pattern() const { return pattern_; }
+
+private:
+  bool matches(const std::string& pathName) const;
+
+  std::string pattern_;
+  Mode mode_;
+  boost::regex regex_;
+
+  edm::ParameterSetID parameterSetID_;
+  std::vector<unsigned int> indices_;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef DQMOFFLINE_TRIGGER_HLTSUMMARYAGGREGATOR
+#define DQMOFFLINE_TRIGGER_HLTSUMMARYAGGREGATOR
+
+/*
+ Description: keeps track of the per-subsystem certification bits (float MEs such
+ as HLT/EventInfo/reportSummaryContents/HLT_Muon) that the HLT summary clients
+ combine into reportSummary and the summary maps.
+
+ The MonitorElements are looked up once and kept; update() then only re-reads
+ their value and quality test status and flags the subsystems whose inputs
+ changed, so the clients can refresh their summaries at every lumi section and
+ only touch the bins that need it.
+*/
+
+#include <string>
+#include <vector>
+
+class DQMStore;
+class MonitorElement;
+
+class HLTSummaryAggregator {
+public:
+  explicit HLTSummaryAggregator(float defaultValue = 1.0);
+
+  // mePath is the full path of the subsystem bit, returns its index
+  unsigned int addSubsystem(const std::string& mePath);
+
+  // looks up the subsystem MEs which have not been found yet
+  void subscribe(DQMStore& store);
+
+  // forgets the MEs and cached values (ie at a new run)
+  void reset();
+
+  // re-reads the subscribed MEs, true if any subsystem changed since the last update
+  bool update();
+
+  unsigned int size() const { return subsystems_.size(); }
+  const std::string& path(unsigned int i) const { return subsystems_[i].path; }
+  bool found(unsigned int i) const { return subsystems_[i].me != 0; }
+  bool changed(unsigned int i) const { return subsystems_[i].changed; }
+  // the ME value, or the default one if it was not found
+  float value(unsigned int i) const { return subsystems_[i].value; }
+  unsigned int nrFound() const;
+
+private:
+  struct Subsystem {
+    std::string path;
+    MonitorElement* me;
+    float value;
+    int qStatus;
+    bool changed;
+  };
+
+  float defaultValue_;
+  bool isUpdated_;
+  std::vector<Subsystem> subsystems_;
+};
+
+#endif
@@ -3,6 +3,8 @@
 #define DQMOffline_Trigger_HLTTauDQMPath_h
 
 #include "DataFormats/Math/interface/LorentzVector.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DQMOffline/Trigger/interface/HLTTauDQMPlotter.h"
 
 #include <tuple>
 #include <vector>
@@ -17,7 +19,6 @@ namespace trigger {
   class TriggerEvent;
   class TriggerObject;
 }
-struct HLTTauDQMOfflineObjects;
 
 class HLTTauDQMPath {
 public:
@@ -35,6 +36,25 @@ public:
     const int id; // from TriggerTypeDefs.h
   };
 
+  // Everything needed per event about a filter, resolved when the menu is loaded
+  struct Filter {
+    std::string name;
+    std::string type;
+    size_t moduleIndex; // index (to edm::TriggerResults) of the filter
+    edm::InputTag tag;  // filter tag in the trigger event
+    // expected object multiplicities and trigger level
+    int nTaus;
+    int nElectrons;
+    int nMuons;
+    int nMET;
+    int level;
+    // roles used by the path plotter
+    bool isMETFilter;
+    bool isL3MuonFilter;
+    bool isElectronFilter;
+    bool isTauFilter;
+  };
+
   HLTTauDQMPath(const std::string& pathName, const std::string& hltProcess, bool doRefAnalysis, const HLTConfigProvider& HLTCP);
   ~HLTTauDQMPath();
 
@@ -49,17 +69,18 @@ public:
   const std::string& getPathName() const { return pathName_; }
   const unsigned int getPathIndex() const { return pathIndex_; }
 
-  size_t filtersSize() const { return filterIndices_.size(); }
-  const std::string& getFilterName(size_t i) const { return std::get<kName>(filterIndices_[i]); }
-  const std::string& getFilterType(size_t i) const { return std::get<kType>(filterIndices_[i]); }
-  int getFilterNTaus(size_t i) const { if(i < filterTauN_.size()) return filterTauN_[i]; else return 0;}
-  int getFilterNElectrons(size_t i) const {if(i < filterElectronN_.size()) return filterElectronN_[i]; else return 0;}
-  int getFilterNMuons(size_t i) const {if(i < filterMuonN_.size()) return filterMuonN_[i]; else return 0;}
-  int getFilterMET(size_t i) const {if(i < filterMET_.size()) return filterMET_[i]; else return 0;}
-  int getFilterLevel(size_t i) const {if(i < filterLevel_.size()) return filterLevel_[i]; else return 0;}
+  size_t filtersSize() const { return filters_.size(); }
+  const Filter& getFilter(size_t i) const { return filters_[i]; }
+  const std::string& getFilterName(size_t i) const { return filters_[i].name; }
+  const std::string& getFilterType(size_t i) const { return filters_[i].type; }
+  int getFilterNTaus(size_t i) const { if(i < filters_.size()) return filters_[i].nTaus; else return 0;}
+  int getFilterNElectrons(size_t i) const {if(i < filters_.size()) return filters_[i].nElectrons; else return 0;}
+  int getFilterNMuons(size_t i) const {if(i < filters_.size()) return filters_[i].nMuons; else return 0;}
+  int getFilterMET(size_t i) const {if(i < filters_.size()) return filters_[i].nMET; else return 0;}
+  int getFilterLevel(size_t i) const {if(i < filters_.size()) return filters_[i].level; else return 0;}
 
   bool isFirstFilterL1Seed() const { return isFirstL1Seed_; }
-  const std::string& getLastFilterName() const { return std::get<kName>(filterIndices_.back()); }
+  const std::string& getLastFilterName() const { return filters_.back().name; }
 
   bool hasL2Taus() const { return lastL2TauFilterIndex_ != kInvalidIndex; }
   bool hasL3Taus() const { return lastL3TauFilterIndex_ != kInvalidIndex; }
@@ -89,7 +110,7 @@ public:
   size_t getFirstL2CaloMETFilterIndex() const { return firstL2METFilterIndex_; }
 
   // index (to edm::TriggerResults) of a filter
-  size_t getFilterIndex(size_t i) const { return std::get<kModuleIndex>(filterIndices_[i]); }
+  size_t getFilterIndex(size_t i) const { return filters_[i].moduleIndex; }
 
   // Get objects associated to a filter, i is the "internal" index
   void getFilterObjects(const trigger::TriggerEvent& triggerEvent, size_t i, std::vector<Object>& retval) const;
@@ -103,12 +124,13 @@ private:
   const std::string hltProcess_;
   const bool doRefAnalysis_;
 
-  std::vector<FilterIndex> filterIndices_;
-  std::vector<int> filterTauN_;
-  std::vector<int> filterElectronN_;
-  std::vector<int> filterMuonN_;
-  std::vector<int> filterMET_;
-  std::vector<int> filterLevel_;
+  std::vector<Filter> filters_;
+
+  // offlineMatching scratch: trigger object indices per type, reference mask and columns
+  enum { kTauObjects, kElectronObjects, kMuonObjects, kMETObjects, kNObjectTypes };
+  mutable std::vector<size_t> typeObjects_[kNObjectTypes];
+  mutable std::vector<bool> offlineMask_;
+  mutable HLTTauDQMOfflineObjects::EtaPhi refEtaPhi_;
   const std::string pathName_;
   const unsigned int pathIndex_;
   size_t lastFilterBeforeL2TauIndex_;
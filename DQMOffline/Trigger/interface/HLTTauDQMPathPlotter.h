@@ -37,6 +37,8 @@ public:
 
   typedef std::tuple<std::string, size_t> FilterIndex;
 private:
+  const HLTTauDQMOfflineObjects *matchedFilterObjects(size_t i, int lastMatchedFilter, const trigger::TriggerEvent& triggerEvent, const HLTTauDQMOfflineObjects& refCollection);
+
   const int ptbins_;
   const int etabins_;
   const int phibins_;
@@ -48,6 +50,14 @@ private:
 
   HLTTauDQMPath hltPath_;
 
+  // per-event scratch
+  std::vector<HLTTauDQMPath::Object> triggerObjs_;
+  std::vector<HLTTauDQMPath::Object> matchedTriggerObjs_;
+  HLTTauDQMOfflineObjects matchedOfflineObjs_;
+  // offline objects matched to each filter in the current event, and the deltaR used
+  std::vector<HLTTauDQMOfflineObjects> filterMatches_;
+  std::vector<double> filterMatchDr_;
+
   MonitorElement *hAcceptedEvents_;
   MonitorElement *hTrigTauEt_;
   MonitorElement *hTrigTauEta_;
@@ -3,10 +3,10 @@
 #define HLTTauDQMPathSummaryPlotter_h
 
 #include "DQMOffline/Trigger/interface/HLTTauDQMPlotter.h"
+#include "DQMOffline/Trigger/interface/HLTTauDQMPath.h"
 
 #include<vector>
 
-class HLTTauDQMPath;
 namespace edm {
   class TriggerResults;
 }
@@ -34,6 +34,11 @@ private:
 
   std::vector<const HLTTauDQMPath *> pathObjects_;
 
+  // per-event scratch
+  std::vector<HLTTauDQMPath::Object> triggerObjs_;
+  std::vector<HLTTauDQMPath::Object> matchedTriggerObjs_;
+  HLTTauDQMOfflineObjects matchedOfflineObjs_;
+
   MonitorElement *all_events;
   MonitorElement *accepted_events;
 };
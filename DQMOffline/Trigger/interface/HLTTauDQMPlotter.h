@@ -17,16 +17,44 @@ typedef math::XYZTLorentzVectorD LV;
 typedef std::vector<LV> LVColl;
 
 struct HLTTauDQMOfflineObjects {
+  // eta and phi of a collection, so that the trigger object matching does
+  // not recompute them from the four-vectors for every trigger object
+  struct EtaPhi {
+    void fill(const std::vector<LV>& objects) {
+      eta.resize(objects.size());
+      phi.resize(objects.size());
+      for(size_t i=0; i<objects.size(); ++i) {
+        eta[i] = objects[i].eta();
+        phi[i] = objects[i].phi();
+      }
+    }
+    void clear() { eta.clear(); phi.clear(); }
+    std::vector<double> eta;
+    std::vector<double> phi;
+  };
+
   void clear() {
     electrons.clear();
     muons.clear();
     taus.clear();
     met.clear();
+    electronEtaPhi.clear();
+    muonEtaPhi.clear();
+    tauEtaPhi.clear();
   };
+  // to be called once the collections are filled
+  void buildEtaPhi() {
+    electronEtaPhi.fill(electrons);
+    muonEtaPhi.fill(muons);
+    tauEtaPhi.fill(taus);
+  }
   std::vector<LV> electrons;
   std::vector<LV> muons;
   std::vector<LV> taus;
   std::vector<LV> met;
+  EtaPhi electronEtaPhi;
+  EtaPhi muonEtaPhi;
+  EtaPhi tauEtaPhi;
 };
 
 //Virtual base class for HLT-Tau-DQM Plotters
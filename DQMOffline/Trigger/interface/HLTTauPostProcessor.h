@@ -7,6 +7,7 @@
 
 #include "DQMServices/Core/interface/DQMEDHarvester.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DQMOffline/Trigger/interface/HLTFolderHarvester.h"
 
 #include <string>
 
@@ -18,7 +19,7 @@ public:
   void dqmEndJob(DQMStore::IBooker& iBooker, DQMStore::IGetter& iGetter) override;
 
 private:
-  void plotFilterEfficiencies(DQMStore::IBooker& iBooker, DQMStore::IGetter& iGetter, const std::string& folder) const;
+  void plotFilterEfficiencies(DQMStore::IBooker& iBooker, const HLTFolderHarvester::Folder& folder) const;
 
   const std::string dqmBaseFolder_;
 };
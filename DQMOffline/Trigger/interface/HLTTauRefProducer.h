@@ -103,6 +103,10 @@ public:
   bool doTowers_;
   double ptMinTower_;
   double towerIsol_;
+  //scratch for the tower isolation: towers per eta-phi cell, cell of each tower, towers near the cone
+  std::vector<std::vector<unsigned int> > towerGrid_;
+  std::vector<int> towerGridCell_;
+  std::vector<unsigned int> towerCone_;
 
   edm::EDGetTokenT<reco::CaloMETCollection> MET_;
   bool doMET_;
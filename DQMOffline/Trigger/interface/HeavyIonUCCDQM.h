@@ -22,6 +22,7 @@
 #include "DataFormats/HLTReco/interface/TriggerEventWithRefs.h"
 #include "DataFormats/HLTReco/interface/TriggerEventWithRefs.h"
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
+#include "DQMOffline/Trigger/interface/HLTPathMatcher.h"
 
 class HeavyIonUCCDQM: public DQMEDAnalyzer{
 public:
@@ -38,6 +39,7 @@ private:
 	edm::EDGetTokenT<edmNew::DetSetVector<SiPixelCluster> > theSiPixelCluster;
 
 	std::string triggerPath_;
+	HLTPathMatcher pathMatcher_;
 
 	int nClusters;
 	int minClusters;
@@ -35,6 +35,7 @@
 #include "DataFormats/HLTReco/interface/TriggerEventWithRefs.h"
 #include "DataFormats/HLTReco/interface/TriggerEventWithRefs.h"
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
+#include "DQMOffline/Trigger/interface/HLTPathMatcher.h"
 
 class HotlineDQM: public DQMEDAnalyzer{
 
@@ -49,7 +50,37 @@ class HotlineDQM: public DQMEDAnalyzer{
   void analyze(edm::Event const& e, edm::EventSetup const& eSetup) override;
 
   private:
-  //variables from config file
+  // one monitored path, either the module parameters themselves or an entry of "hotlines"
+  struct Hotline {
+    explicit Hotline(const edm::ParameterSet& ps);
+
+    std::string triggerPath_;
+    HLTPathMatcher pathMatcher_;
+    edm::InputTag triggerFilter_;
+
+    bool useMuons, useMet, usePFMet, useHT, usePhotons;
+
+    // Histograms
+    MonitorElement* h_MuPt;
+    MonitorElement* h_PhotonPt;
+    MonitorElement* h_HT;
+    MonitorElement* h_MetPt;
+    MonitorElement* h_PFMetPt;
+
+    MonitorElement* h_OnlineMuPt;
+    MonitorElement* h_OnlinePhotonPt;
+    MonitorElement* h_OnlineHT;
+    MonitorElement* h_OnlineMetPt;
+    MonitorElement* h_OnlinePFMetPt;
+  };
+
+  void fillOnlineHistograms(Hotline& hotline, const trigger::TriggerEvent& triggerSummary);
+  void fillOfflineHistograms(edm::Event const& e);
+  // true if any of the hotlines (fired in the current event) has this mode
+  bool anyUses(bool Hotline::* use) const;
+  bool anyFiredUses(bool Hotline::* use) const;
+
+  //variables from config file, the offline collections are only consumed by the modes using them
   edm::EDGetTokenT<reco::MuonCollection> theMuonCollection_;
   edm::EDGetTokenT<reco::PFMETCollection> thePfMETCollection_;
   edm::EDGetTokenT<reco::CaloMETCollection> theMETCollection_;
@@ -58,23 +89,9 @@ class HotlineDQM: public DQMEDAnalyzer{
   edm::EDGetTokenT<edm::TriggerResults> triggerResults_;
   edm::EDGetTokenT<trigger::TriggerEvent> theTrigSummary_;
 
-  std::string triggerPath_;
-  edm::InputTag triggerFilter_;
-
-  bool useMuons, useMet, usePFMet, useHT, usePhotons;
-
-  // Histograms
-  MonitorElement* h_MuPt;
-  MonitorElement* h_PhotonPt;
-  MonitorElement* h_HT;
-  MonitorElement* h_MetPt;
-  MonitorElement* h_PFMetPt;
-
-  MonitorElement* h_OnlineMuPt;
-  MonitorElement* h_OnlinePhotonPt;
-  MonitorElement* h_OnlineHT;
-  MonitorElement* h_OnlineMetPt;
-  MonitorElement* h_OnlinePFMetPt;
+  std::vector<Hotline> hotlines_;
+  // hotlines whose path fired in the current event
+  std::vector<Hotline*> firedHotlines_;
 };
 
 #endif
@@ -16,6 +16,9 @@
 
 #include "DQMServices/Core/interface/DQMEDAnalyzer.h"
 
+#include "DQMOffline/Trigger/interface/HLTDQMTiming.h"
+#include "DQMOffline/Trigger/interface/HLTDQMHistoAccumulator.h"
+
 #include "FWCore/Common/interface/TriggerNames.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/EDAnalyzer.h"
@@ -75,6 +78,7 @@ class JetMETHLTOfflineSource : public DQMEDAnalyzer {
   virtual void analyze(const edm::Event&, const edm::EventSetup&) override;
   virtual void bookHistograms(DQMStore::IBooker &, edm::Run const & run, edm::EventSetup const & c) override;
   virtual void dqmBeginRun(edm::Run const& run, edm::EventSetup const& c) override;
+  virtual void endLuminosityBlock(edm::LuminosityBlock const& lumi, edm::EventSetup const& c) override;
 
   //helper functions
   virtual bool   isBarrel(double eta);
@@ -976,6 +980,10 @@ class JetMETHLTOfflineSource : public DQMEDAnalyzer {
   PathInfoCollection hltPathsAll_;
   PathInfoCollection hltPathsEff_;
 
+  // timing scope 0 is analyze, followed by one scope per path of
+  // hltPathsAll_ and then one per path of hltPathsEff_
+  HLTDQMTiming timing_;
+
   MonitorElement* rate_All;
   MonitorElement* rate_AllWrtMu;
   MonitorElement* rate_AllWrtMB;
@@ -985,5 +993,15 @@ class JetMETHLTOfflineSource : public DQMEDAnalyzer {
   MonitorElement* correlation_AllWrtMB;
   MonitorElement* PVZ;
   MonitorElement* NVertices;
+
+  // the trigger summary histograms above are filled through these, see endLuminosityBlock
+  HLTDQMHistoAccumulator rateAllAcc_;
+  HLTDQMHistoAccumulator rateAllWrtMuAcc_;
+  HLTDQMHistoAccumulator rateAllWrtMBAcc_;
+  HLTDQMHistoAccumulator correlationAllAcc_;
+  HLTDQMHistoAccumulator correlationAllWrtMuAcc_;
+  HLTDQMHistoAccumulator correlationAllWrtMBAcc_;
+  HLTDQMHistoAccumulator PVZAcc_;
+  HLTDQMHistoAccumulator NVerticesAcc_;
 };
 #endif
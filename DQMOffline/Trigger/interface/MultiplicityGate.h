@@ -0,0 +1,60 @@
+#ifndef DQMOFFLINE_TRIGGER_MULTIPLICITYGATE_H
+#define DQMOFFLINE_TRIGGER_MULTIPLICITYGATE_H
+
+/*
+ Description: "at least N objects of a collection pass a string cut" requirement
+ for the trigger monitoring modules.
+
+ The gate only counts: the objects are looked at in place, and counting stops as
+ soon as the required multiplicity is reached, or as soon as it can no longer be
+ reached with the objects left. With a required multiplicity of zero or less the
+ gate always accepts and the collection is not even read, which is why it should
+ be declared with mayConsume.
+*/
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+
+#include <string>
+#include <vector>
+
+template <class Object>
+class MultiplicityGate {
+public:
+  typedef std::vector<Object> Collection;
+
+  MultiplicityGate(const edm::EDGetTokenT<Collection>& token, const std::string& cut, int nRequired):
+    token_(token),
+    selector_(cut),
+    nRequired_(nRequired)
+  {}
+
+  bool isActive() const { return nRequired_ > 0; }
+
+  // true if at least nRequired objects of the collection pass the cut
+  bool accept(const edm::Event& iEvent) const {
+    if (!isActive()) return true;
+
+    edm::Handle<Collection> handle;
+    iEvent.getByToken(token_, handle);
+    const Collection& objects = *handle;
+
+    int nLeft = objects.size();
+    int nPassed = 0;
+    for (auto const& object : objects) {
+      if (nPassed + nLeft < nRequired_) return false;
+      --nLeft;
+      if (selector_(object) && ++nPassed >= nRequired_) return true;
+    }
+    return false;
+  }
+
+private:
+  edm::EDGetTokenT<Collection> token_;
+  StringCutObjectSelector<Object,true> selector_;
+  int nRequired_;
+};
+
+#endif
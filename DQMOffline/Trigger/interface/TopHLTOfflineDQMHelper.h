@@ -58,6 +58,46 @@ acceptHLT(const edm::Event& event, const edm::TriggerResults& triggerTable, cons
 #include "FWCore/Framework/interface/EventSetup.h"
 
 #include "DataFormats/METReco/interface/CaloMET.h"
+/**
+   \class   HadronicTopKernel TopHLTOfflineDQMHelper.h 
+
+   \brief   Search for the hadronic top quark and W boson jet combinations.
+   
+   Finds among the first nJets jets the three with the largest pt of their 
+   vectorial sum, and among those the pair with the invariant mass closest to 
+   the W boson mass. The jet momenta are copied to flat arrays and the jets are 
+   visited by decreasing pt, so that the search can stop as soon as the scalar 
+   pt sum of a triplet can no longer beat the best vectorial one. Used by 
+   CalculateHLT.
+*/
+
+class HadronicTopKernel {
+ public:
+  HadronicTopKernel();
+
+  /// run the search, false if there are less than three jets to combine
+  bool operator()(const std::vector<reco::Jet>& jets, unsigned int nJets, double wMass);
+
+  /// top quark mass estimate of the last successful search
+  double massTopQuark() const { return massTopQuark_; }
+  /// W boson mass estimate of the last successful search
+  double massWBoson() const { return massWBoson_; }
+  /// indices of the top quark jets, in increasing order
+  const int* topIndices() const { return topIndices_; }
+  /// indices of the W boson jets, in increasing order
+  const int* wIndices() const { return wIndices_; }
+
+ private:
+  /// jet momenta, in the order of the jet collection
+  std::vector<double> px_, py_, pt_;
+  /// jet indices by decreasing pt
+  std::vector<int> order_;
+  int topIndices_[3];
+  int wIndices_[2];
+  double massTopQuark_;
+  double massWBoson_;
+};
+
 /**
    \class   Calculate TopHLTOfflineDQMHelper.h 
 
@@ -117,6 +157,8 @@ class CalculateHLT {
   double tmassTopQuark_;
   /// cache of mlb estimate
   double mlb_;
+  /// jet combinatorics for the W boson and top quark mass estimates
+  HadronicTopKernel hadronicTop_;
 
 
 };
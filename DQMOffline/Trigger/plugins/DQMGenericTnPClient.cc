@@ -10,6 +10,7 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 
 #include "DQMOffline/Trigger/plugins/GenericTnPFitter.h"
+#include "DQMOffline/Trigger/interface/HLTFolderHarvester.h"
 
 #include<TString.h>
 #include<TPRegexp.h>
@@ -196,8 +197,7 @@ void DQMGenericTnPClient::findAllSubdirectories (std::string dir, std::set<std::
   if (pattern != "") {
     if (pattern.Contains(nonPerlWildcard)) pattern.ReplaceAll("*",".*");
     TPRegexp regexp(pattern);
-    dqmStore->cd(dir);
-    vector <string> foundDirs = dqmStore->getSubdirs();
+    vector <string> foundDirs = HLTFolderHarvester::subdirs(*dqmStore, dir);
     for(vector<string>::const_iterator iDir = foundDirs.begin();
         iDir != foundDirs.end(); ++iDir) {
       TString dirName = iDir->substr(iDir->rfind('/') + 1, iDir->length());
@@ -205,15 +205,10 @@ void DQMGenericTnPClient::findAllSubdirectories (std::string dir, std::set<std::
         findAllSubdirectories ( *iDir, myList);
     }
   }
-  else if (dqmStore->dirExists(dir)){
-    myList->insert(dir);
-    dqmStore->cd(dir);
-    findAllSubdirectories (dir, myList, "*");
-  } else {
-    
-    LogInfo ("DQMGenericClient") << "Trying to find sub-directories of " << dir
-                                 << " failed because " << dir  << " does not exist";
-                                 
+  else {
+    // the whole tree below dir in one walk
+    vector <string> foundDirs = HLTFolderHarvester::subdirsRecursive(*dqmStore, dir);
+    myList->insert(foundDirs.begin(), foundDirs.end());
   }
   return;
 }
@@ -1,111 +1,24 @@
 #ifndef METMONITOR_H
 #define METMONITOR_H
 
-#include <string>
-#include <vector>
-#include <map>
-
-#include "FWCore/Utilities/interface/EDGetToken.h"
-#include "FWCore/Framework/interface/Frameworkfwd.h"
-#include "FWCore/Framework/interface/Event.h"
-#include "FWCore/Framework/interface/MakerMacros.h"
-#include "FWCore/ParameterSet/interface/ParameterSet.h"
-#include "FWCore/ServiceRegistry/interface/Service.h"
-#include "DQMServices/Core/interface/MonitorElement.h"
-#include <DQMServices/Core/interface/DQMEDAnalyzer.h>
-
-#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
-#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
-#include "FWCore/ParameterSet/interface/Registry.h"
-
-#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "DQMOffline/Trigger/plugins/TriggerEfficiencyMonitor.h"
 
 //DataFormats
 #include "DataFormats/METReco/interface/PFMET.h"
 #include "DataFormats/METReco/interface/PFMETCollection.h"
 
-#include "DataFormats/JetReco/interface/PFJet.h"
-#include "DataFormats/JetReco/interface/PFJetCollection.h"
-#include "DataFormats/JetReco/interface/CaloJet.h"
-#include "DataFormats/JetReco/interface/CaloJetCollection.h"
-#include "DataFormats/MuonReco/interface/Muon.h"
-#include "DataFormats/MuonReco/interface/MuonFwd.h"
-#include "DataFormats/TrackReco/interface/Track.h"
-#include "DataFormats/TrackReco/interface/TrackFwd.h"
-#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
-#include "DataFormats/EgammaCandidates/interface/GsfElectronFwd.h"
-#include "DataFormats/EgammaCandidates/interface/Photon.h"
-#include "DataFormats/EgammaCandidates/interface/PhotonFwd.h"
-
-class GenericTriggerEventFlag;
-
-struct MEbinning {
-  int nbins;
-  double xmin;
-  double xmax;
+// PF MET trigger efficiency
+struct PFMETExtractor {
+  static const char* name()             { return "met"; }
+  static const char* title()            { return "PFMET"; }
+  static const char* axisLabel()        { return "PF MET"; }
+  static const char* folder()           { return "HLT/MET"; }
+  static const char* inputTag()         { return "pfMet"; }
+  static const char* descriptionLabel() { return "metMonitoring"; }
+  static float value(const reco::PFMET& met) { return met.pt(); }
+  static float phi  (const reco::PFMET& met) { return met.phi(); }
 };
 
-struct METME {
-  MonitorElement* numerator;
-  MonitorElement* denominator;
-};
-//
-// class declaration
-//
-
-class METMonitor : public DQMEDAnalyzer 
-{
-public:
-  METMonitor( const edm::ParameterSet& );
-  ~METMonitor();
-  static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
-  static void fillHistoPSetDescription(edm::ParameterSetDescription & pset);
-  static void fillHistoLSPSetDescription(edm::ParameterSetDescription & pset);
-
-protected:
-
-  void bookHistograms(DQMStore::IBooker &, edm::Run const &, edm::EventSetup const &) override;
-  void bookME(DQMStore::IBooker &, METME& me, std::string& histname, std::string& histtitle, int& nbins, double& xmin, double& xmax);
-  void bookME(DQMStore::IBooker &, METME& me, std::string& histname, std::string& histtitle, std::vector<double> binningX);
-  void bookME(DQMStore::IBooker &, METME& me, std::string& histname, std::string& histtitle, int& nbinsX, double& xmin, double& xmax, double& ymin, double& ymax);
-  void bookME(DQMStore::IBooker &, METME& me, std::string& histname, std::string& histtitle, int& nbinsX, double& xmin, double& xmax, int& nbinsY, double& ymin, double& ymax);
-  void bookME(DQMStore::IBooker &, METME& me, std::string& histname, std::string& histtitle, std::vector<double> binningX, std::vector<double> binningY);
-  void setMETitle(METME& me, std::string titleX, std::string titleY);
-
-  void analyze(edm::Event const& iEvent, edm::EventSetup const& iSetup) override;
-
-private:
-  static MEbinning getHistoPSet    (edm::ParameterSet pset);
-  static MEbinning getHistoLSPSet  (edm::ParameterSet pset);
-
-  std::string folderName_;
-  std::string histoSuffix_;
-
-  edm::EDGetTokenT<reco::PFMETCollection>       metToken_;
-  edm::EDGetTokenT<reco::PFJetCollection>       jetToken_;
-  edm::EDGetTokenT<reco::GsfElectronCollection> eleToken_;
-  edm::EDGetTokenT<reco::MuonCollection>        muoToken_;
-
-  std::vector<double> met_variable_binning_;
-  MEbinning           met_binning_;
-  MEbinning           ls_binning_;
-
-  METME metME_;
-  METME metME_variableBinning_;
-  METME metVsLS_;
-  METME metPhiME_;
-
-  GenericTriggerEventFlag* num_genTriggerEventFlag_;
-  GenericTriggerEventFlag* den_genTriggerEventFlag_;
-
-  StringCutObjectSelector<reco::MET,true>         metSelection_;
-  StringCutObjectSelector<reco::PFJet,true   >    jetSelection_;
-  StringCutObjectSelector<reco::GsfElectron,true> eleSelection_;
-  StringCutObjectSelector<reco::Muon,true>        muoSelection_;
-  int njets_;
-  int nelectrons_;
-  int nmuons_;
-
-};
+typedef TriggerEfficiencyMonitor<reco::PFMET, PFMETExtractor> METMonitor;
 
 #endif // METMONITOR_H
@@ -0,0 +1,50 @@
+// Trigger efficiency monitors of the leading object of a collection, built
+// on TriggerEfficiencyMonitor as METMonitor. The parameter names follow the
+// extractor name, eg "photon", "photonSelection", histoPSet.photonPSet.
+
+#include "DQMOffline/Trigger/plugins/TriggerEfficiencyMonitor.h"
+
+#include "DataFormats/EgammaCandidates/interface/Photon.h"
+#include "DataFormats/EgammaCandidates/interface/PhotonFwd.h"
+
+struct PFJetExtractor {
+  static const char* name()             { return "pfjet"; }
+  static const char* title()            { return "leading PF jet pt"; }
+  static const char* axisLabel()        { return "leading PF jet p_{T}"; }
+  static const char* folder()           { return "HLT/JetMET"; }
+  static const char* inputTag()         { return "ak4PFJetsCHS"; }
+  static const char* descriptionLabel() { return "pfJetEfficiencyMonitoring"; }
+  static float value(const reco::PFJet& jet) { return jet.pt(); }
+  static float phi  (const reco::PFJet& jet) { return jet.phi(); }
+};
+
+struct PhotonExtractor {
+  static const char* name()             { return "photon"; }
+  static const char* title()            { return "leading photon pt"; }
+  static const char* axisLabel()        { return "leading photon p_{T}"; }
+  static const char* folder()           { return "HLT/Photon"; }
+  static const char* inputTag()         { return "gedPhotons"; }
+  static const char* descriptionLabel() { return "photonEfficiencyMonitoring"; }
+  static float value(const reco::Photon& photon) { return photon.pt(); }
+  static float phi  (const reco::Photon& photon) { return photon.phi(); }
+};
+
+struct GsfElectronExtractor {
+  static const char* name()             { return "electron"; }
+  static const char* title()            { return "leading electron pt"; }
+  static const char* axisLabel()        { return "leading electron p_{T}"; }
+  static const char* folder()           { return "HLT/Electron"; }
+  static const char* inputTag()         { return "gedGsfElectrons"; }
+  static const char* descriptionLabel() { return "electronEfficiencyMonitoring"; }
+  static float value(const reco::GsfElectron& electron) { return electron.pt(); }
+  static float phi  (const reco::GsfElectron& electron) { return electron.phi(); }
+};
+
+typedef TriggerEfficiencyMonitor<reco::PFJet,       PFJetExtractor>       PFJetEfficiencyMonitor;
+typedef TriggerEfficiencyMonitor<reco::Photon,      PhotonExtractor>      PhotonEfficiencyMonitor;
+typedef TriggerEfficiencyMonitor<reco::GsfElectron, GsfElectronExtractor> GsfElectronEfficiencyMonitor;
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(PFJetEfficiencyMonitor);
+DEFINE_FWK_MODULE(PhotonEfficiencyMonitor);
+DEFINE_FWK_MODULE(GsfElectronEfficiencyMonitor);
@@ -0,0 +1,342 @@
+#ifndef TRIGGEREFFICIENCYMONITOR_H
+#define TRIGGEREFFICIENCYMONITOR_H
+
+/*
+ Description: trigger efficiency monitor of one variable of the leading object of
+ a collection, generalised from METMonitor.
+
+ The Extractor is a compile-time policy giving the monitored variable and phi of
+ the object (static value() and phi()), the prefix of the parameter and histogram
+ names (name(), eg "met" for met, metSelection, histoPSet.metPSet, met_numerator),
+ the titles and the fillDescriptions defaults. See PFMETExtractor in METMonitor.h.
+
+ The denominator is filled for the events passing the denominator trigger flag,
+ the variable selection and the jet/electron/muon multiplicity gates, the
+ numerator for those also passing the numerator trigger flag. Both are filled by
+ the same fill path, so a new monitor only needs an extractor and a typedef.
+*/
+
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include <DQMServices/Core/interface/DQMEDAnalyzer.h>
+
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "DQMOffline/Trigger/interface/HLTDQMTriggerGate.h"
+#include "DQMOffline/Trigger/interface/MultiplicityGate.h"
+
+#include "DataFormats/JetReco/interface/PFJet.h"
+#include "DataFormats/JetReco/interface/PFJetCollection.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/MuonReco/interface/MuonFwd.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectronFwd.h"
+
+struct MEbinning {
+  int nbins;
+  double xmin;
+  double xmax;
+};
+
+struct EfficiencyME {
+  MonitorElement* numerator;
+  MonitorElement* denominator;
+};
+
+//
+// class declaration
+//
+
+template <class Object, class Extractor>
+class TriggerEfficiencyMonitor : public DQMEDAnalyzer
+{
+public:
+  typedef std::vector<Object> Collection;
+
+  TriggerEfficiencyMonitor( const edm::ParameterSet& );
+  ~TriggerEfficiencyMonitor();
+  static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+  static void fillHistoPSetDescription(edm::ParameterSetDescription & pset);
+  static void fillHistoLSPSetDescription(edm::ParameterSetDescription & pset);
+
+protected:
+
+  void bookHistograms(DQMStore::IBooker &, edm::Run const &, edm::EventSetup const &) override;
+  void bookME(DQMStore::IBooker &, EfficiencyME& me, const std::string& histname, const std::string& histtitle, int nbins, double xmin, double xmax);
+  void bookME(DQMStore::IBooker &, EfficiencyME& me, const std::string& histname, const std::string& histtitle, const std::vector<double>& binningX);
+  void bookME(DQMStore::IBooker &, EfficiencyME& me, const std::string& histname, const std::string& histtitle, int nbinsX, double xmin, double xmax, double ymin, double ymax);
+  void setMETitle(EfficiencyME& me, const std::string& titleX, const std::string& titleY);
+
+  void analyze(edm::Event const& iEvent, edm::EventSetup const& iSetup) override;
+
+private:
+  static MEbinning getHistoPSet    (const edm::ParameterSet& pset);
+  static MEbinning getHistoLSPSet  (const edm::ParameterSet& pset);
+  static std::string parameterName (const char* suffix) { return std::string(Extractor::name())+suffix; }
+
+  // fills either the numerators or the denominators
+  void fill(MonitorElement* EfficiencyME::* histo, float value, float phi, int ls);
+
+  std::string folderName_;
+
+  edm::EDGetTokenT<Collection> objectToken_;
+
+  std::vector<double> variable_binning_;
+  MEbinning           binning_;
+  MEbinning           ls_binning_;
+  MEbinning           phi_binning_;
+
+  EfficiencyME variableME_;
+  EfficiencyME variableME_variableBinning_;
+  EfficiencyME variableVsLS_;
+  EfficiencyME phiME_;
+
+  // GenericTriggerEventFlag selections, with the DCS decision taken once per
+  // lumisection and the HLT paths compiled to TriggerResults indices
+  HLTDQMTriggerGate* num_genTriggerEventFlag_;
+  HLTDQMTriggerGate* den_genTriggerEventFlag_;
+
+  StringCutObjectSelector<Object,true> objectSelection_;
+  MultiplicityGate<reco::PFJet>       jetGate_;
+  MultiplicityGate<reco::GsfElectron> eleGate_;
+  MultiplicityGate<reco::Muon>        muoGate_;
+
+};
+
+// -----------------------------
+//  constructors and destructor
+// -----------------------------
+
+template <class Object, class Extractor>
+TriggerEfficiencyMonitor<Object,Extractor>::TriggerEfficiencyMonitor( const edm::ParameterSet& iConfig ) :
+  folderName_             ( iConfig.getParameter<std::string>("FolderName") )
+  , objectToken_          ( consumes<Collection>(iConfig.getParameter<edm::InputTag>(Extractor::name())) )
+  , variable_binning_     ( iConfig.getParameter<edm::ParameterSet>("histoPSet").getParameter<std::vector<double> >(parameterName("Binning")) )
+  , binning_              ( getHistoPSet   (iConfig.getParameter<edm::ParameterSet>("histoPSet").getParameter<edm::ParameterSet>(parameterName("PSet")) ) )
+  , ls_binning_           ( getHistoLSPSet (iConfig.getParameter<edm::ParameterSet>("histoPSet").getParameter<edm::ParameterSet>("lsPSet")     ) )
+  , phi_binning_          { 64, -3.2, 3.2 }
+  , num_genTriggerEventFlag_(new HLTDQMTriggerGate(iConfig.getParameter<edm::ParameterSet>("numGenericTriggerEventPSet"),consumesCollector(), *this))
+  , den_genTriggerEventFlag_(new HLTDQMTriggerGate(iConfig.getParameter<edm::ParameterSet>("denGenericTriggerEventPSet"),consumesCollector(), *this))
+  , objectSelection_ ( iConfig.getParameter<std::string>(parameterName("Selection")) )
+  , jetGate_ ( mayConsume<reco::PFJetCollection>      (iConfig.getParameter<edm::InputTag>("jets")      ),
+               iConfig.getParameter<std::string>("jetSelection"), iConfig.getParameter<int>("njets" ) )
+  , eleGate_ ( mayConsume<reco::GsfElectronCollection>(iConfig.getParameter<edm::InputTag>("electrons") ),
+               iConfig.getParameter<std::string>("eleSelection"), iConfig.getParameter<int>("nelectrons" ) )
+  , muoGate_ ( mayConsume<reco::MuonCollection>       (iConfig.getParameter<edm::InputTag>("muons")     ),
+               iConfig.getParameter<std::string>("muoSelection"), iConfig.getParameter<int>("nmuons" ) )
+{
+
+  variableME_.numerator   = nullptr;
+  variableME_.denominator = nullptr;
+  variableME_variableBinning_.numerator   = nullptr;
+  variableME_variableBinning_.denominator = nullptr;
+  variableVsLS_.numerator   = nullptr;
+  variableVsLS_.denominator = nullptr;
+  phiME_.numerator   = nullptr;
+  phiME_.denominator = nullptr;
+
+}
+
+template <class Object, class Extractor>
+TriggerEfficiencyMonitor<Object,Extractor>::~TriggerEfficiencyMonitor()
+{
+  if (num_genTriggerEventFlag_) delete num_genTriggerEventFlag_;
+  if (den_genTriggerEventFlag_) delete den_genTriggerEventFlag_;
+}
+
+template <class Object, class Extractor>
+MEbinning TriggerEfficiencyMonitor<Object,Extractor>::getHistoPSet(const edm::ParameterSet& pset)
+{
+  return MEbinning{
+    pset.getParameter<int32_t>("nbins"),
+      pset.getParameter<double>("xmin"),
+      pset.getParameter<double>("xmax"),
+      };
+}
+
+template <class Object, class Extractor>
+MEbinning TriggerEfficiencyMonitor<Object,Extractor>::getHistoLSPSet(const edm::ParameterSet& pset)
+{
+  return MEbinning{
+    pset.getParameter<int32_t>("nbins"),
+      0.,
+      double(pset.getParameter<int32_t>("nbins"))
+      };
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::setMETitle(EfficiencyME& me, const std::string& titleX, const std::string& titleY)
+{
+  me.numerator->setAxisTitle(titleX,1);
+  me.numerator->setAxisTitle(titleY,2);
+  me.denominator->setAxisTitle(titleX,1);
+  me.denominator->setAxisTitle(titleY,2);
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::bookME(DQMStore::IBooker &ibooker, EfficiencyME& me, const std::string& histname, const std::string& histtitle, int nbins, double min, double max)
+{
+  me.numerator   = ibooker.book1D(histname+"_numerator",   histtitle+" (numerator)",   nbins, min, max);
+  me.denominator = ibooker.book1D(histname+"_denominator", histtitle+" (denominator)", nbins, min, max);
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::bookME(DQMStore::IBooker &ibooker, EfficiencyME& me, const std::string& histname, const std::string& histtitle, const std::vector<double>& binning)
+{
+  int nbins = binning.size()-1;
+  std::vector<float> fbinning(binning.begin(),binning.end());
+  float* arr = &fbinning[0];
+  me.numerator   = ibooker.book1D(histname+"_numerator",   histtitle+" (numerator)",   nbins, arr);
+  me.denominator = ibooker.book1D(histname+"_denominator", histtitle+" (denominator)", nbins, arr);
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::bookME(DQMStore::IBooker &ibooker, EfficiencyME& me, const std::string& histname, const std::string& histtitle, int nbinsX, double xmin, double xmax, double ymin, double ymax)
+{
+  me.numerator   = ibooker.bookProfile(histname+"_numerator",   histtitle+" (numerator)",   nbinsX, xmin, xmax, ymin, ymax);
+  me.denominator = ibooker.bookProfile(histname+"_denominator", histtitle+" (denominator)", nbinsX, xmin, xmax, ymin, ymax);
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::bookHistograms(DQMStore::IBooker     & ibooker,
+                                                                edm::Run const        & iRun,
+                                                                edm::EventSetup const & iSetup)
+{
+  const std::string name  = Extractor::name();
+  const std::string title = Extractor::title();
+  const std::string axis  = Extractor::axisLabel();
+
+  ibooker.setCurrentFolder(folderName_);
+
+  bookME(ibooker,variableME_,name,title,binning_.nbins,binning_.xmin,binning_.xmax);
+  setMETitle(variableME_,axis+" [GeV]","events / [GeV]");
+
+  bookME(ibooker,variableME_variableBinning_,name+"_variable",title,variable_binning_);
+  setMETitle(variableME_variableBinning_,axis+" [GeV]","events / [GeV]");
+
+  bookME(ibooker,variableVsLS_,name+"VsLS",title+" vs LS",ls_binning_.nbins,ls_binning_.xmin,ls_binning_.xmax,binning_.xmin,binning_.xmax);
+  setMETitle(variableVsLS_,"LS",axis+" [GeV]");
+
+  bookME(ibooker,phiME_,name+"Phi",title+" phi",phi_binning_.nbins,phi_binning_.xmin,phi_binning_.xmax);
+  setMETitle(phiME_,axis+" #phi","events / 0.1 rad");
+
+  // Initialize the trigger gates
+  if ( num_genTriggerEventFlag_ && num_genTriggerEventFlag_->on() ) num_genTriggerEventFlag_->initRun( iRun, iSetup );
+  if ( den_genTriggerEventFlag_ && den_genTriggerEventFlag_->on() ) den_genTriggerEventFlag_->initRun( iRun, iSetup );
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::fill(MonitorElement* EfficiencyME::* histo, float value, float phi, int ls)
+{
+  (variableME_.*histo)                 -> Fill(value);
+  (variableME_variableBinning_.*histo) -> Fill(value);
+  (phiME_.*histo)                      -> Fill(phi);
+  (variableVsLS_.*histo)               -> Fill(ls, value);
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::analyze(edm::Event const& iEvent, edm::EventSetup const& iSetup)
+{
+  // Filter out events if Trigger Filtering is requested
+  if (den_genTriggerEventFlag_->on() && ! den_genTriggerEventFlag_->accept( iEvent, iSetup) ) return;
+
+  edm::Handle<Collection> handle;
+  iEvent.getByToken( objectToken_, handle );
+  if ( handle->empty() ) return;
+  const Object& object = handle->front();
+  if ( ! objectSelection_( object ) ) return;
+
+  // the collections are only read if a multiplicity is required
+  if ( ! jetGate_.accept( iEvent ) ) return;
+  if ( ! eleGate_.accept( iEvent ) ) return;
+  if ( ! muoGate_.accept( iEvent ) ) return;
+
+  // the variables are extracted once for both the denominator and the numerator
+  const float value = Extractor::value( object );
+  const float phi   = Extractor::phi( object );
+  const int   ls    = iEvent.id().luminosityBlock();
+
+  fill( &EfficiencyME::denominator, value, phi, ls );
+
+  // applying selection for numerator
+  if (num_genTriggerEventFlag_->on() && ! num_genTriggerEventFlag_->accept( iEvent, iSetup) ) return;
+
+  fill( &EfficiencyME::numerator, value, phi, ls );
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::fillHistoPSetDescription(edm::ParameterSetDescription & pset)
+{
+  pset.add<int>   ( "nbins");
+  pset.add<double>( "xmin" );
+  pset.add<double>( "xmax" );
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::fillHistoLSPSetDescription(edm::ParameterSetDescription & pset)
+{
+  pset.add<int>   ( "nbins", 2500);
+}
+
+template <class Object, class Extractor>
+void TriggerEfficiencyMonitor<Object,Extractor>::fillDescriptions(edm::ConfigurationDescriptions & descriptions)
+{
+  edm::ParameterSetDescription desc;
+  desc.add<std::string>  ( "FolderName", Extractor::folder() );
+
+  desc.add<edm::InputTag>( Extractor::name(), edm::InputTag(Extractor::inputTag()) );
+  desc.add<edm::InputTag>( "jets",     edm::InputTag("ak4PFJetsCHS") );
+  desc.add<edm::InputTag>( "electrons",edm::InputTag("gedGsfElectrons") );
+  desc.add<edm::InputTag>( "muons",    edm::InputTag("muons") );
+  desc.add<std::string>(parameterName("Selection"), "pt > 0");
+  desc.add<std::string>("jetSelection", "pt > 0");
+  desc.add<std::string>("eleSelection", "pt > 0");
+  desc.add<std::string>("muoSelection", "pt > 0");
+  desc.add<int>("njets",      0);
+  desc.add<int>("nelectrons", 0);
+  desc.add<int>("nmuons",     0);
+
+  edm::ParameterSetDescription genericTriggerEventPSet;
+  genericTriggerEventPSet.add<bool>("andOr");
+  genericTriggerEventPSet.add<edm::InputTag>("dcsInputTag", edm::InputTag("scalersRawToDigi") );
+  genericTriggerEventPSet.add<std::vector<int> >("dcsPartitions",{});
+  genericTriggerEventPSet.add<bool>("andOrDcs", false);
+  genericTriggerEventPSet.add<bool>("errorReplyDcs", true);
+  genericTriggerEventPSet.add<std::string>("dbLabel","");
+  genericTriggerEventPSet.add<bool>("andOrHlt", true);
+  genericTriggerEventPSet.add<edm::InputTag>("hltInputTag", edm::InputTag("TriggerResults::HLT") );
+  genericTriggerEventPSet.add<std::vector<std::string> >("hltPaths",{});
+  genericTriggerEventPSet.add<std::string>("hltDBKey","");
+  genericTriggerEventPSet.add<bool>("errorReplyHlt",false);
+  genericTriggerEventPSet.add<unsigned int>("verbosityLevel",1);
+
+  desc.add<edm::ParameterSetDescription>("numGenericTriggerEventPSet", genericTriggerEventPSet);
+  desc.add<edm::ParameterSetDescription>("denGenericTriggerEventPSet", genericTriggerEventPSet);
+
+  edm::ParameterSetDescription histoPSet;
+  edm::ParameterSetDescription variablePSet;
+  fillHistoPSetDescription(variablePSet);
+  histoPSet.add<edm::ParameterSetDescription>(parameterName("PSet"), variablePSet);
+  std::vector<double> bins = {0.,20.,40.,60.,80.,90.,100.,110.,120.,130.,140.,150.,160.,170.,180.,190.,200.,220.,240.,260.,280.,300.,350.,400.,450.,1000.};
+  histoPSet.add<std::vector<double> >(parameterName("Binning"), bins);
+
+  edm::ParameterSetDescription lsPSet;
+  fillHistoLSPSetDescription(lsPSet);
+  histoPSet.add<edm::ParameterSetDescription>("lsPSet", lsPSet);
+
+  desc.add<edm::ParameterSetDescription>("histoPSet",histoPSet);
+
+  descriptions.add(Extractor::descriptionLabel(), desc);
+}
+
+#endif // TRIGGEREFFICIENCYMONITOR_H
@@ -16,6 +16,8 @@ egHLTOffDQMSource = cms.EDAnalyzer("EgHLTOfflineSource",
                                  hltTag = cms.string("HLT"),
                                  TrigResults = cms.InputTag("TriggerResults","","HLT"),
                                  filterInactiveTriggers = cms.bool(True),
+                                 #directory where the active filters of each menu are cached between jobs, empty: in memory only
+                                 menuCacheDir = cms.untracked.string(""),
                                  EndcapRecHitCollection = cms.InputTag("reducedEcalRecHitsEE"),
                                  BarrelRecHitCollection = cms.InputTag("reducedEcalRecHitsEB"),
                                  ElectronCollection = cms.InputTag("gedGsfElectrons"),
@@ -481,9 +481,12 @@ def getDoublePFJet(thresholds, flavour=None, etaMin=-1, srcType="genJets" ):
 
     combinedObjectSortCriteria = "at(0).pt + at(1).pt"
     combinedObjectSelection = "1 == 1"
+    # sum of pt: the best pair search may skip pairs which cannot beat the best one found
+    combinedObjectSortMonotoneInPt = True
     if flavour != None and "FB" in flavour :
         combinedObjectSortCriteria = "("+combinedObjectSortCriteria+")*(  ? at(0).eta*at(1).eta < 0 ? 1 : 0 )"
         combinedObjectSelection = "at(0).eta*at(1).eta < 0"
+        combinedObjectSortMonotoneInPt = False
         
     if etaMin == None:
         etaMin = -1
@@ -514,6 +517,7 @@ def getDoublePFJet(thresholds, flavour=None, etaMin=-1, srcType="genJets" ):
             singleObjectDrawables =  cms.VPSet(),
             combinedObjectSelection =  cms.string(combinedObjectSelection),
             combinedObjectSortCriteria = cms.string(combinedObjectSortCriteria),
+            combinedObjectSortMonotoneInPt = cms.untracked.bool(combinedObjectSortMonotoneInPt),
             combinedObjectDimension = cms.int32(2),
             combinedObjectDrawables =  cms.VPSet(
                     #cms.PSet (name = cms.string("ptLead"), expression = cms.string("max(at(0).pt, at(1).pt())"), 
@@ -16,6 +16,16 @@ hltElectronOfflineAnalyzer = cms.EDAnalyzer("HLTElectronOfflineAnalyzer",
 #       "",
       ),
 
+    ## Count, per lumisection, the events reaching and passing each filter of
+    ## these paths (from TriggerResults only), in FolderName/FilterPassVsLS
+    filterPassVsLS = cms.untracked.bool(False),
+
+    ## If set, also write one row per tag-probe pair (probe variables, pair
+    ## mass, filters passed by the probe) to one tree per path in this file,
+    ## to redo the efficiencies offline with another binning
+    tnpColumnsFile = cms.untracked.string(""),
+    tnpColumnsBatchSize = cms.untracked.uint32(4096),
+
     ## All input tags are specified in this pset for convenience
     inputTags = cms.PSet(
     	electrons = cms.InputTag("gedGsfElectrons"), 
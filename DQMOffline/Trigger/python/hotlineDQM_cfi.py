@@ -1,134 +1,20 @@
 import FWCore.ParameterSet.Config as cms
 
-hotlineDQM_HT = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_HT2000_v'),
-     triggerFilter = cms.InputTag('hltHT2000', '', 'HLT'),
-
-     useHT = cms.bool(True)
-)
-
-hotlineDQM_HT_Tight = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_HT2500_v'),
-     triggerFilter = cms.InputTag('hltHT2500', '', 'HLT'),
-
-     useHT = cms.bool(True)
-)
-
-hotlineDQM_Photon = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_Photon500_v'),
-     triggerFilter = cms.InputTag('hltEG500HEFilter', '', 'HLT'),
-
-     usePhotons = cms.bool(True)
-)
-
-hotlineDQM_Photon_Tight = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_Photon600_v'),
-     triggerFilter = cms.InputTag('hltEG600HEFilter', '', 'HLT'),
-
-     usePhotons = cms.bool(True)
-)
-
-hotlineDQM_MET = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_MET600_v'),
-     triggerFilter = cms.InputTag('hltMETClean590', '', 'HLT'),
-
-     useMet = cms.bool(True)
-)
-
-hotlineDQM_MET_Tight = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_MET700_v'),
-     triggerFilter = cms.InputTag('hltMETClean690', '', 'HLT'),
-
-     useMet = cms.bool(True)
-)
-
-hotlineDQM_PFMET = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_PFMET500_v'),
-     triggerFilter = cms.InputTag('hltPFMET500Filter', '', 'HLT'),
+# all the hotline paths are monitored by one module, which reads the trigger
+# summary and the offline collections only in the events where one of them fired,
+# and only the offline collections used by the hotlines which fired
+def hotline(triggerPath, triggerFilter, **use):
+     return cms.PSet(
+          triggerPath = cms.string(triggerPath),
+          triggerFilter = cms.InputTag(triggerFilter, '', 'HLT'),
+          useMuons = cms.bool(use.get('useMuons', False)),
+          usePhotons = cms.bool(use.get('usePhotons', False)),
+          useMet = cms.bool(use.get('useMet', False)),
+          usePFMet = cms.bool(use.get('usePFMet', False)),
+          useHT = cms.bool(use.get('useHT', False))
+     )
 
-     usePFMet = cms.bool(True)
-)
-
-hotlineDQM_PFMET_Tight = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_PFMET600_v'),
-     triggerFilter = cms.InputTag('hltPFMET600Filter', '', 'HLT'),
-
-     usePFMet = cms.bool(True)
-)
-
-hotlineDQM_Muon = cms.EDAnalyzer('HotlineDQM',
+hotlineDQM = cms.EDAnalyzer('HotlineDQM',
      photonCollection = cms.InputTag('photons'),
      muonCollection = cms.InputTag('muons'),
      caloJetCollection = cms.InputTag('ak4CaloJets'),
@@ -138,26 +24,18 @@ hotlineDQM_Muon = cms.EDAnalyzer('HotlineDQM',
      triggerResults = cms.InputTag('TriggerResults','','HLT'),
      trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
 
-     triggerPath = cms.string('HLT_Mu300_v'),
-     triggerFilter = cms.InputTag('hltL3fL1sMu16orMu25L1f0L2f16QL3Filtered300Q', '', 'HLT'),
-
-     useMuons = cms.bool(True)
-)
-
-hotlineDQM_Muon_Tight = cms.EDAnalyzer('HotlineDQM',
-     photonCollection = cms.InputTag('photons'),
-     muonCollection = cms.InputTag('muons'),
-     caloJetCollection = cms.InputTag('ak4CaloJets'),
-     pfMetCollection = cms.InputTag('pfMet'),
-     caloMetCollection = cms.InputTag('caloMet'),
-
-     triggerResults = cms.InputTag('TriggerResults','','HLT'),
-     trigSummary = cms.InputTag('hltTriggerSummaryAOD','','HLT'),
-
-     triggerPath = cms.string('HLT_Mu350_v'),
-     triggerFilter = cms.InputTag('hltL3fL1sMu16orMu25L1f0L2f16QL3Filtered350Q', '', 'HLT'),
-
-     useMuons = cms.bool(True)
+     hotlines = cms.VPSet(
+          hotline('HLT_HT2000_v', 'hltHT2000', useHT = True),
+          hotline('HLT_HT2500_v', 'hltHT2500', useHT = True),
+          hotline('HLT_Photon500_v', 'hltEG500HEFilter', usePhotons = True),
+          hotline('HLT_Photon600_v', 'hltEG600HEFilter', usePhotons = True),
+          hotline('HLT_Mu300_v', 'hltL3fL1sMu16orMu25L1f0L2f16QL3Filtered300Q', useMuons = True),
+          hotline('HLT_Mu350_v', 'hltL3fL1sMu16orMu25L1f0L2f16QL3Filtered350Q', useMuons = True),
+          hotline('HLT_MET600_v', 'hltMETClean590', useMet = True),
+          hotline('HLT_MET700_v', 'hltMETClean690', useMet = True),
+          hotline('HLT_PFMET500_v', 'hltPFMET500Filter', usePFMet = True),
+          hotline('HLT_PFMET600_v', 'hltPFMET600Filter', usePFMet = True)
+     )
 )
 
-hotlineDQMSequence = cms.Sequence(hotlineDQM_HT*hotlineDQM_HT_Tight*hotlineDQM_Photon*hotlineDQM_Photon_Tight*hotlineDQM_Muon*hotlineDQM_Muon_Tight*hotlineDQM_MET*hotlineDQM_MET_Tight*hotlineDQM_PFMET*hotlineDQM_PFMET_Tight)
+hotlineDQMSequence = cms.Sequence(hotlineDQM)
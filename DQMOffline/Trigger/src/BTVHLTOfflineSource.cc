@@ -93,9 +93,12 @@ void BTVHLTOfflineSource::dqmBeginRun(const edm::Run& run, const edm::EventSetup
     if (!trigSelected) continue;
     
     hltPathsAll_.push_back(PathInfo(usedPrescale, pathname_, "dummy", processname_, objectType, triggerType)); 
+    hltPathsAll_.back().setTriggerIndex(i);
    }
   
-
+  // the indices come from the menu of the run, checked against the
+  // TriggerResults of the first event
+  triggerNamesID_ = edm::ParameterSetID();
 }
 
 void
@@ -112,6 +115,15 @@ BTVHLTOfflineSource::analyze(const edm::Event& iEvent, const edm::EventSetup& iS
   }
   
   triggerNames_ = iEvent.triggerNames(*triggerResults_);
+  if (triggerNames_.parameterSetID() != triggerNamesID_) {
+    // the TriggerResults may come from another menu than the HLTConfigProvider
+    for(PathInfoCollection::iterator v = hltPathsAll_.begin(); v!= hltPathsAll_.end(); ++v ){
+      unsigned index = v->getTriggerIndex();
+      if (index >= triggerNames_.size() || triggerNames_.triggerName(index) != v->getPath())
+        v->setTriggerIndex(triggerNames_.triggerIndex(v->getPath()));
+    }
+    triggerNamesID_ = triggerNames_.parameterSetID();
+  }
   
   iEvent.getByToken(triggerSummaryToken,triggerObj_);
   if(!triggerObj_.isValid()) {
@@ -126,102 +138,113 @@ BTVHLTOfflineSource::analyze(const edm::Event& iEvent, const edm::EventSetup& iS
   iEvent.getByToken(csvCaloTagsToken_, csvCaloTags);
   iEvent.getByToken(csvPfTagsToken_, csvPfTags);
   
-  Handle<reco::VertexCollection> VertexHandler;
-  
   Handle<reco::JetTagCollection> offlineJetTagHandlerPF;
   iEvent.getByToken(offlineCSVTokenPF_, offlineJetTagHandlerPF);
   
   Handle<reco::JetTagCollection> offlineJetTagHandlerCalo;
   iEvent.getByToken(offlineCSVTokenCalo_, offlineJetTagHandlerCalo);
   
-  Handle<reco::VertexCollection> offlineVertexHandler;
-  iEvent.getByToken(offlinePVToken_, offlineVertexHandler);
+  VertexZ offlinePV;
+  leadingVertexZ(iEvent, offlinePVToken_, offlinePV);
   
   if(verbose_ && iEvent.id().event()%10000==0)
     cout<<"Run = "<<iEvent.id().run()<<", LS = "<<iEvent.luminosityBlock()<<", Event = "<<iEvent.id().event()<<endl;  
   
-  if(!triggerResults_.isValid()) return;
+  // the online tags and vertices are the same for all the paths of a trigger
+  // type, match and fetch them once
+  matchTags(csvPfTags, offlineJetTagHandlerPF, pfMatch_);
+  matchTags(csvCaloTags, offlineJetTagHandlerCalo, caloMatch_);
+  
+  VertexZ pfPV, fastPV, caloPV;
+  pfPV.valid = fastPV.valid = caloPV.valid = false;
+  if (pfMatch_.valid) leadingVertexZ(iEvent, hltPFPVToken_, pfPV);
+  if (caloMatch_.valid) {
+    leadingVertexZ(iEvent, hltFastPVToken_, fastPV);
+    leadingVertexZ(iEvent, hltCaloPVToken_, caloPV);
+  }
    
   for(PathInfoCollection::iterator v = hltPathsAll_.begin(); v!= hltPathsAll_.end(); ++v ){
-    unsigned index = triggerNames_.triggerIndex(v->getPath()); 
-    if (index < triggerNames_.size() ){     
-     float DR  = 9999.;
-     if (csvPfTags.isValid() && v->getTriggerType() == "PF")
-     {
-      auto iter = csvPfTags->begin();
-      
-      float CSV_online = iter->second;
-      if (CSV_online<0) CSV_online = -0.05;
+    if (v->getTriggerIndex() >= triggerNames_.size()) continue;
     
-      v->getMEhisto_CSV()->Fill(CSV_online);  
-      v->getMEhisto_Pt()->Fill(iter->first->pt()); 
-      v->getMEhisto_Eta()->Fill(iter->first->eta());
+    if (pfMatch_.valid && v->getTriggerType() == "PF")
+    {
+      v->getMEhisto_CSV()->Fill(pfMatch_.csvOnline);  
+      v->getMEhisto_Pt()->Fill(pfMatch_.pt); 
+      v->getMEhisto_Eta()->Fill(pfMatch_.eta);
+      for (std::vector<float>::const_iterator csv = pfMatch_.csvOffline.begin(); csv != pfMatch_.csvOffline.end(); ++csv)
+        v->getMEhisto_CSV_RECOvsHLT()->Fill(*csv,pfMatch_.csvOnline);
       
-      DR  = 9999.;
-      if(offlineJetTagHandlerPF.isValid()){
-          for ( reco::JetTagCollection::const_iterator iterO = offlineJetTagHandlerPF->begin(); iterO != offlineJetTagHandlerPF->end(); iterO++ ){ 
-            float CSV_offline = iterO->second;
-            if (CSV_offline<0) CSV_offline = -0.05;
-            DR = reco::deltaR(iterO->first->eta(),iterO->first->phi(),iter->first->eta(),iter->first->phi());
-            if (DR<0.3) {
-               v->getMEhisto_CSV_RECOvsHLT()->Fill(CSV_offline,CSV_online); continue;
-               }
-          }
-      }
-    
-      iEvent.getByToken(hltPFPVToken_, VertexHandler);
-      if (VertexHandler.isValid())
+      if (pfPV.valid)
       { 
-        v->getMEhisto_PVz()->Fill(VertexHandler->begin()->z()); 
-        if (offlineVertexHandler.isValid()) v->getMEhisto_PVz_HLTMinusRECO()->Fill(VertexHandler->begin()->z()-offlineVertexHandler->begin()->z());
-        }
+        v->getMEhisto_PVz()->Fill(pfPV.z); 
+        if (offlinePV.valid) v->getMEhisto_PVz_HLTMinusRECO()->Fill(pfPV.z-offlinePV.z);
       }
-      
-     if (csvCaloTags.isValid() && v->getTriggerType() == "Calo" && !csvCaloTags->empty()) 
-     { 
-      auto iter = csvCaloTags->begin();
-      
-      float CSV_online = iter->second;
-      if (CSV_online<0) CSV_online = -0.05;
+    }
     
-      v->getMEhisto_CSV()->Fill(CSV_online);  
-      v->getMEhisto_Pt()->Fill(iter->first->pt()); 
-      v->getMEhisto_Eta()->Fill(iter->first->eta());
+    if (caloMatch_.valid && v->getTriggerType() == "Calo") 
+    { 
+      v->getMEhisto_CSV()->Fill(caloMatch_.csvOnline);  
+      v->getMEhisto_Pt()->Fill(caloMatch_.pt); 
+      v->getMEhisto_Eta()->Fill(caloMatch_.eta);
+      for (std::vector<float>::const_iterator csv = caloMatch_.csvOffline.begin(); csv != caloMatch_.csvOffline.end(); ++csv)
+        v->getMEhisto_CSV_RECOvsHLT()->Fill(*csv,caloMatch_.csvOnline);
       
-      DR  = 9999.;
-      if(offlineJetTagHandlerCalo.isValid()){
-          for ( reco::JetTagCollection::const_iterator iterO = offlineJetTagHandlerCalo->begin(); iterO != offlineJetTagHandlerCalo->end(); iterO++ )
-          {
-            float CSV_offline = iterO->second;
-            if (CSV_offline<0) CSV_offline = -0.05;
-            DR = reco::deltaR(iterO->first->eta(),iterO->first->phi(),iter->first->eta(),iter->first->phi());
-            if (DR<0.3) 
-            {
-                v->getMEhisto_CSV_RECOvsHLT()->Fill(CSV_offline,CSV_online); continue;
-            }  
-          }     
-      }
-      
-      iEvent.getByToken(hltFastPVToken_, VertexHandler);
-      if (VertexHandler.isValid()) 
+      if (fastPV.valid) 
       {
-        v->getMEhisto_PVz()->Fill(VertexHandler->begin()->z()); 
-	if (offlineVertexHandler.isValid()) v->getMEhisto_fastPVz_HLTMinusRECO()->Fill(VertexHandler->begin()->z()-offlineVertexHandler->begin()->z());
-       }
+        v->getMEhisto_PVz()->Fill(fastPV.z); 
+        if (offlinePV.valid) v->getMEhisto_fastPVz_HLTMinusRECO()->Fill(fastPV.z-offlinePV.z);
+      }
       
-      iEvent.getByToken(hltCaloPVToken_, VertexHandler);
-      if (VertexHandler.isValid())
+      if (caloPV.valid)
       {
-        v->getMEhisto_fastPVz()->Fill(VertexHandler->begin()->z()); 
-	if (offlineVertexHandler.isValid()) v->getMEhisto_PVz_HLTMinusRECO()->Fill(VertexHandler->begin()->z()-offlineVertexHandler->begin()->z());
-       }
-       
+        v->getMEhisto_fastPVz()->Fill(caloPV.z); 
+        if (offlinePV.valid) v->getMEhisto_PVz_HLTMinusRECO()->Fill(caloPV.z-offlinePV.z);
       }
-      
-      
     }
-   }
+  }
+  
+}
+
+void
+BTVHLTOfflineSource::matchTags(const edm::Handle<reco::JetTagCollection>& online,
+                               const edm::Handle<reco::JetTagCollection>& offline,
+                               TagMatch& match) const
+{
+  match.csvOffline.clear();
+  match.valid = online.isValid() && !online->empty();
+  if (!match.valid) return;
   
+  // only the first online tag is monitored
+  auto iter = online->begin();
+  match.csvOnline = iter->second;
+  if (match.csvOnline<0) match.csvOnline = -0.05;
+  const double eta = iter->first->eta();
+  const double phi = iter->first->phi();
+  match.pt  = iter->first->pt();
+  match.eta = eta;
+  
+  if (!offline.isValid()) return;
+  for ( reco::JetTagCollection::const_iterator iterO = offline->begin(); iterO != offline->end(); iterO++ ){ 
+    const double etaO = iterO->first->eta();
+    // cheap eta window before the full DeltaR
+    if (std::abs(etaO-eta) >= 0.3) continue;
+    if (reco::deltaR(etaO,iterO->first->phi(),eta,phi) < 0.3) {
+      float CSV_offline = iterO->second;
+      if (CSV_offline<0) CSV_offline = -0.05;
+      match.csvOffline.push_back(CSV_offline);
+    }
+  }
+}
+
+void
+BTVHLTOfflineSource::leadingVertexZ(const edm::Event& iEvent,
+                                    const edm::EDGetTokenT<std::vector<reco::Vertex> >& token,
+                                    VertexZ& vertex) const
+{
+  Handle<reco::VertexCollection> VertexHandler;
+  iEvent.getByToken(token, VertexHandler);
+  vertex.valid = VertexHandler.isValid() && !VertexHandler->empty();
+  vertex.z = vertex.valid ? VertexHandler->begin()->z() : 0.;
 }
 
 void 
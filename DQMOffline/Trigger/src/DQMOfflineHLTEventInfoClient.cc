@@ -112,6 +112,16 @@ void DQMOfflineHLTEventInfoClient::initialize(){
   
   prescaleEvt_ = parameters_.getUntrackedParameter<int>("prescaleEvt", -1);
   if(verbose_) cout << "DQM event prescale = " << prescaleEvt_ << " events(s)"<< endl;
+
+  // subsystem bits and the summary map bins they go to, JetMET and BJet have no bits yet
+  summaryContents_.addSubsystem("HLT/EventInfo/reportSummaryContents/HLT_Muon");
+  summaryMapBins_.push_back(1);
+  summaryContents_.addSubsystem("HLT/EventInfo/reportSummaryContents/HLT_Electron");
+  summaryMapBins_.push_back(2);
+  summaryContents_.addSubsystem("HLT/EventInfo/reportSummaryContents/HLT_Photon");
+  summaryMapBins_.push_back(3);
+  summaryContents_.addSubsystem("HLT/EventInfo/reportSummaryContents/HLT_Tau");
+  summaryMapBins_.push_back(6);
   /*
   */
   
@@ -191,10 +201,15 @@ void DQMOfflineHLTEventInfoClient::beginJob(){
   CertificationSummaryMap_->setBinLabel(6,"Tau",2);
   CertificationSummaryMap_->setBinLabel(1," ",1);
 
+  reportSummaryMap_->setBinContent(1,4,1);//JetMET
+  reportSummaryMap_->setBinContent(1,5,1);//BJet
+  CertificationSummaryMap_->setBinContent(1,4,1);//JetMET
+  CertificationSummaryMap_->setBinContent(1,5,1);//BJet
 }
 
 //--------------------------------------------------------
 void DQMOfflineHLTEventInfoClient::beginRun(const Run& r, const EventSetup& context) {
+  summaryContents_.reset();
 }
 
 //--------------------------------------------------------
@@ -204,6 +219,11 @@ void DQMOfflineHLTEventInfoClient::beginLuminosityBlock(const LuminosityBlock& l
 
 void DQMOfflineHLTEventInfoClient::endLuminosityBlock(const edm::LuminosityBlock& lumiSeg, 
                           const edm::EventSetup& c){
+  counterLS_++;
+  if (prescaleLS_<1) return;
+  if (counterLS_%prescaleLS_ != 0) return;
+
+  updateSummary();
 }
 
 //--------------------------------------------------------
@@ -220,31 +240,23 @@ void DQMOfflineHLTEventInfoClient::analyze(const Event& e, const EventSetup& con
 
 //--------------------------------------------------------
 void DQMOfflineHLTEventInfoClient::endRun(const Run& r, const EventSetup& context){
+  updateSummary();
+}
 
-  float summarySum = 0;
-  float reportSummary = 0;
-
-  dbe_->setCurrentFolder("HLT/EventInfo/reportSummaryContents");
-  MonitorElement* HLT_Muon = dbe_->get("HLT_Muon");
-  if(HLT_Muon) reportSummaryContent_.push_back(HLT_Muon);
-
-  MonitorElement * HLT_Electron = dbe_->get("HLT_Electron");
-  if(HLT_Electron) reportSummaryContent_.push_back(HLT_Electron);
-
-  MonitorElement * HLT_Photon = dbe_->get("HLT_Photon");
-  if(HLT_Photon) reportSummaryContent_.push_back(HLT_Photon);
-
-  MonitorElement * HLT_Tau = dbe_->get("HLT_Tau");
-  if(HLT_Tau) reportSummaryContent_.push_back(HLT_Tau);
+//--------------------------------------------------------
+void DQMOfflineHLTEventInfoClient::updateSummary(){
 
+  summaryContents_.subscribe(*dbe_);
+  if (!summaryContents_.update()) return;
 
-  int nSubsystems = reportSummaryContent_.size();
+  float summarySum = 0;
+  float reportSummary = 0;
 
-  for (int m = 0; m < nSubsystems; m++) {    
-    summarySum += (reportSummaryContent_[m])->getFloatValue();
+  for (unsigned int m = 0; m < summaryContents_.size(); m++) {    
+    if (summaryContents_.found(m)) summarySum += summaryContents_.value(m);
   }
 
-
+  int nSubsystems = summaryContents_.nrFound();
   if(nSubsystems > 0) {
     reportSummary = summarySum / nSubsystems;;
   }
@@ -255,31 +267,12 @@ void DQMOfflineHLTEventInfoClient::endRun(const Run& r, const EventSetup& contex
   reportSummary_->Fill(reportSummary);
   CertificationSummary_->Fill(reportSummary);
 
-  float muonValue = 1;
-  if(HLT_Muon) muonValue = HLT_Muon->getFloatValue();
-
-  float electronValue = 1;
-  if(HLT_Electron) electronValue = HLT_Electron->getFloatValue();
-
-  float photonValue = 1;
-  if(HLT_Photon) photonValue = HLT_Photon->getFloatValue();
-
-  float tauValue = 1;
-  if(HLT_Tau) tauValue = HLT_Tau->getFloatValue();
-
-  reportSummaryMap_->setBinContent(1,1,muonValue);//Muon
-  reportSummaryMap_->setBinContent(1,2,electronValue);//Electron
-  reportSummaryMap_->setBinContent(1,3,photonValue);//Photon
-  reportSummaryMap_->setBinContent(1,4,1);//JetMET
-  reportSummaryMap_->setBinContent(1,5,1);//BJet
-  reportSummaryMap_->setBinContent(1,6,tauValue);//Tau
-
-  CertificationSummaryMap_->setBinContent(1,1,muonValue);//Muon
-  CertificationSummaryMap_->setBinContent(1,2,electronValue);//Electron
-  CertificationSummaryMap_->setBinContent(1,3,photonValue);//Photon
-  CertificationSummaryMap_->setBinContent(1,4,1);//JetMET
-  CertificationSummaryMap_->setBinContent(1,5,1);//BJet
-  CertificationSummaryMap_->setBinContent(1,6,tauValue);//Tau
+  // subsystems without a bit count as good
+  for (unsigned int m = 0; m < summaryContents_.size(); m++) {
+    if (!summaryContents_.changed(m)) continue;
+    reportSummaryMap_->setBinContent(1,summaryMapBins_[m],summaryContents_.value(m));
+    CertificationSummaryMap_->setBinContent(1,summaryMapBins_[m],summaryContents_.value(m));
+  }
 }
 
 //--------------------------------------------------------
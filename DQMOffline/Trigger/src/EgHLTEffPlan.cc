@@ -0,0 +1,152 @@
+#include "DQMOffline/Trigger/interface/EgHLTEffPlan.h"
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include "TH1F.h"
+
+#include <cmath>
+
+namespace {
+  //the client always switches on sumw2 for its inputs but make sure as we read the array directly
+  double* sumw2Array(TH1F* hist)
+  {
+    if(hist->GetSumw2N()==0) hist->Sumw2();
+    return hist->GetSumw2()->GetArray();
+  }
+
+  //same as TH1::Divide(numer,denom,1,1,"B") bin by bin, including under/overflow
+  void binomialDivide(const double* numer,const double* numerErr2,
+		      const double* denom,const double* denomErr2,
+		      float* eff,double* effErr2,int nrCells)
+  {
+    for(int cellNr=0;cellNr<nrCells;cellNr++){
+      const double b1 = numer[cellNr];
+      const double b2 = denom[cellNr];
+      if(b2==0){
+	eff[cellNr]=0;
+	effErr2[cellNr]=0;
+	continue;
+      }
+      const double w = b1/b2;
+      eff[cellNr]=w;
+      effErr2[cellNr]= b1!=b2 ? std::abs(((1.-2.*w)*numerErr2[cellNr]+w*w*denomErr2[cellNr])/(b2*b2)) : 0.;
+    }
+  }
+}
+
+void egHLT::EffPlan::add(Type type,MonitorElement* eff,const MonitorElement* in1,const MonitorElement* in2,const MonitorElement* in3)
+{
+  if(eff==0 || in1==0 || in2==0) return;
+  if(type==PASS_FAIL_TAGTAG || type==TWO_LEG){
+    if(in3==0) return;
+  }
+  Entry entry;
+  entry.type=type;
+  entry.eff=eff;
+  entry.in[0]=in1;
+  entry.in[1]=in2;
+  entry.in[2]=in3;
+  entries_.push_back(entry);
+}
+
+void egHLT::EffPlan::run()const
+{
+  for(size_t entryNr=0;entryNr<entries_.size();entryNr++) runEntry_(entries_[entryNr]);
+}
+
+void egHLT::EffPlan::runEntry_(const Entry& entry)const
+{
+  TH1F* effHist = entry.eff->getTH1F();
+  TH1F* hist1 = entry.in[0]->getTH1F();
+  TH1F* hist2 = entry.in[1]->getTH1F();
+  TH1F* hist3 = entry.in[2]!=0 ? entry.in[2]->getTH1F() : 0;
+  if(effHist==0 || hist1==0 || hist2==0) return;
+  if((entry.type==PASS_FAIL_TAGTAG || entry.type==TWO_LEG) && hist3==0) return;
+
+  const int nrCells = effHist->GetNcells();
+  if(hist1->GetNcells()!=nrCells || hist2->GetNcells()!=nrCells) return;
+  if(hist3!=0 && hist3->GetNcells()!=nrCells) return;
+
+  numer_.resize(nrCells);
+  numerErr2_.resize(nrCells);
+  denom_.resize(nrCells);
+  denomErr2_.resize(nrCells);
+
+  float* eff = effHist->GetArray();
+  double* effErr2 = sumw2Array(effHist);
+  const float* val1 = hist1->GetArray();
+  const float* val2 = hist2->GetArray();
+  const double* err1 = sumw2Array(hist1);
+  const double* err2 = sumw2Array(hist2);
+  const float* val3 = hist3!=0 ? hist3->GetArray() : 0;
+  const double* err3 = hist3!=0 ? sumw2Array(hist3) : 0;
+
+  //the entries are those the client's TH1 calls leave: TH1::Divide keeps the entries of the
+  //histogram divided into, which is a clone of the pass histogram (plus the fail one for
+  //PASS_FAIL) or of the all histogram (TWO_LEG, where it is the sum of two such clones)
+  double nrEntries = 0.;
+
+  switch(entry.type){
+  case PASS_ALL:
+    for(int cellNr=0;cellNr<nrCells;cellNr++){
+      numer_[cellNr]=val1[cellNr];
+      numerErr2_[cellNr]=err1[cellNr];
+      denom_[cellNr]=val2[cellNr];
+      denomErr2_[cellNr]=err2[cellNr];
+    }
+    binomialDivide(&numer_[0],&numerErr2_[0],&denom_[0],&denomErr2_[0],eff,effErr2,nrCells);
+    nrEntries = hist1->GetEntries();
+    break;
+
+  case PASS_FAIL:
+    for(int cellNr=0;cellNr<nrCells;cellNr++){
+      numer_[cellNr]=val1[cellNr];
+      numerErr2_[cellNr]=err1[cellNr];
+      denom_[cellNr]=val1[cellNr]+val2[cellNr];
+      denomErr2_[cellNr]=err1[cellNr]+err2[cellNr];
+    }
+    binomialDivide(&numer_[0],&numerErr2_[0],&denom_[0],&denomErr2_[0],eff,effErr2,nrCells);
+    nrEntries = hist1->GetEntries()+hist2->GetEntries();
+    break;
+
+  case PASS_FAIL_TAGTAG: //hist1 = passNotTag, hist2 = fail, hist3 = tagTag
+    for(int cellNr=0;cellNr<nrCells;cellNr++){
+      numer_[cellNr]=2.*val3[cellNr]+val1[cellNr];
+      numerErr2_[cellNr]=4.*err3[cellNr]+err1[cellNr];
+      denom_[cellNr]=numer_[cellNr]+val2[cellNr];
+      denomErr2_[cellNr]=numerErr2_[cellNr]+err2[cellNr];
+    }
+    binomialDivide(&numer_[0],&numerErr2_[0],&denom_[0],&denomErr2_[0],eff,effErr2,nrCells);
+    nrEntries = hist1->GetEntries();
+    break;
+
+  case TWO_LEG: //hist1 = leg1Eff, hist2 = leg2NotLeg1, hist3 = all
+    for(int cellNr=0;cellNr<nrCells;cellNr++){
+      numer_[cellNr]=val2[cellNr];
+      numerErr2_[cellNr]=err2[cellNr];
+      denom_[cellNr]=val3[cellNr];
+      denomErr2_[cellNr]=err3[cellNr];
+    }
+    //leg2NotLeg1/all goes into the scratch numerator as we no longer need it
+    for(int cellNr=0;cellNr<nrCells;cellNr++){
+      const double b1 = numer_[cellNr];
+      const double b2 = denom_[cellNr];
+      const double w = b2!=0 ? b1/b2 : 0.;
+      numerErr2_[cellNr] = b2!=0 && b1!=b2 ? std::abs(((1.-2.*w)*numerErr2_[cellNr]+w*w*denomErr2_[cellNr])/(b2*b2)) : 0.;
+      numer_[cellNr] = w;
+    }
+    //leg1Eff*leg1Eff + 2*leg1Eff*leg2NotLeg1Eff with the TH1::Multiply, Scale and Add errors
+    for(int cellNr=0;cellNr<nrCells;cellNr++){
+      const double leg1 = val1[cellNr];
+      const double leg1Err2 = err1[cellNr];
+      const double leg2 = numer_[cellNr];
+      const double leg2Err2 = numerErr2_[cellNr];
+      eff[cellNr] = leg1*leg1 + 2.*leg1*leg2;
+      effErr2[cellNr] = 2.*leg1Err2*leg1*leg1 + 4.*(leg1Err2*leg2*leg2 + leg2Err2*leg1*leg1);
+    }
+    nrEntries = 2.*hist3->GetEntries();
+    break;
+  }
+  effHist->ResetStats();
+  effHist->SetEntries(nrEntries);
+}
@@ -20,8 +20,12 @@
 #include "DQMOffline/Trigger/interface/EgHLTTrigCodes.h"
 #include "DQMOffline/Trigger/interface/EgHLTTrigTools.h"
 #include "DQMOffline/Trigger/interface/EgHLTErrCodes.h"
+#include "DQMOffline/Trigger/interface/HLTMenuCache.h"
+
+#include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
 
 #include <iostream>
+#include <set>
 
 using namespace egHLT;
 
@@ -100,14 +104,47 @@ void OffHelper::setup(const edm::ParameterSet& conf, edm::ConsumesCollector && i
 
 //this code was taken out of OffHelper::setup due to HLTConfigProvider changes
 //it still assumes that this is called only once
-void OffHelper::setupTriggers(const HLTConfigProvider& hltConfig,const std::vector<std::string>& hltFiltersUsed, const TrigCodes& trigCodes)
+void OffHelper::setupTriggers(const HLTConfigProvider& hltConfig,const std::vector<std::string>& hltFiltersUsed, const TrigCodes& trigCodes,
+			      const HLTMenuCache& menuCache)
 {
   hltFiltersUsed_ = hltFiltersUsed; //expensive but only do this once and faster ways could make things less clear
   //now work out how many objects are requires to pass filter for it to accept
+  //the registry scan is done once per menu for the saveTags filters of all paths,
+  //which only depends on the menu, and the filters used are looked up in that table
+  HLTMenuCache::Tables minNrObjsTable = menuCache.get(hltConfig, "egHLTMinNrObjs", [&hltConfig]() {
+      std::set<std::string> filterSet;
+      for(size_t pathNr=0;pathNr<hltConfig.size();pathNr++){
+	const std::vector<std::string>& saveTagsModules = hltConfig.saveTagsModules(pathNr);
+	filterSet.insert(saveTagsModules.begin(),saveTagsModules.end());
+      }
+      HLTMenuCache::Tables tables;
+      std::vector<std::string>& filters = tables["filters"];
+      filters.assign(filterSet.begin(),filterSet.end());
+      const std::vector<int> minNrObjs = egHLT::trigTools::getMinNrObjsRequiredByFilter(filters);
+      std::vector<std::string>& minNrObjsStrs = tables["minNrObjs"];
+      for(size_t filterNr=0;filterNr<minNrObjs.size();filterNr++) minNrObjsStrs.push_back(std::to_string(minNrObjs[filterNr]));
+      return tables;
+    });
+  std::map<std::string,int> minNrObjsByFilter;
+  const std::vector<std::string>& tableFilters = minNrObjsTable["filters"];
+  const std::vector<std::string>& tableMinNrObjs = minNrObjsTable["minNrObjs"];
+  for(size_t filterNr=0;filterNr<tableFilters.size() && filterNr<tableMinNrObjs.size();filterNr++){
+    minNrObjsByFilter[tableFilters[filterNr]]=std::stoi(tableMinNrObjs[filterNr]);
+  }
+
+  //filters which are not saveTags modules of the menu (if any) still need the scan, all in one go
+  std::vector<std::string> filtersNotInTable;
+  for(size_t filterNr=0;filterNr<hltFiltersUsed_.size();filterNr++){
+    if(minNrObjsByFilter.find(hltFiltersUsed_[filterNr])==minNrObjsByFilter.end()) filtersNotInTable.push_back(hltFiltersUsed_[filterNr]);
+  }
+  if(!filtersNotInTable.empty()){
+    const std::vector<int> minNrObjs=egHLT::trigTools::getMinNrObjsRequiredByFilter(filtersNotInTable);
+    for(size_t filterNr=0;filterNr<filtersNotInTable.size();filterNr++) minNrObjsByFilter[filtersNotInTable[filterNr]]=minNrObjs[filterNr];
+  }
+
   hltFiltersUsedWithNrCandsCut_.clear();
-  std::vector<int> getMRObjs=egHLT::trigTools::getMinNrObjsRequiredByFilter(hltFiltersUsed_);
   for(size_t filterNr=0;filterNr<hltFiltersUsed_.size();filterNr++){
-    hltFiltersUsedWithNrCandsCut_.push_back(std::make_pair(hltFiltersUsed_[filterNr],getMRObjs[filterNr]));
+    hltFiltersUsedWithNrCandsCut_.push_back(std::make_pair(hltFiltersUsed_[filterNr],minNrObjsByFilter[hltFiltersUsed_[filterNr]]));
   }
 
   //now loading the cuts for every trigger into our vector which stores them
@@ -66,6 +66,7 @@ void EgHLTOfflineClient::dqmEndJob(DQMStore::IBooker& ibooker_, DQMStore::IGette
 
 void EgHLTOfflineClient::beginRun(const edm::Run& run, const edm::EventSetup& c)
 {
+  effPlan_.clear();
   if (!isSetup_) {
     if (filterInactiveTriggers_) {
       HLTConfigProvider hltConfig;
@@ -98,6 +99,16 @@ void EgHLTOfflineClient::dqmEndLuminosityBlock( DQMStore::IBooker & ibooker_,
 
 void EgHLTOfflineClient::runClient_(DQMStore::IBooker& ibooker, DQMStore::IGetter& igetter)
 {
+  //all the histograms were found and booked before, now we only need to redo the divisions
+  //unless some inputs were missing then and new source histograms have appeared since
+  const std::string sourceDir = dirName_ + "/Source_Histos";
+  if (effPlan_.isBuilt() &&
+      (effPlan_.isComplete() || igetter.getAllContents(sourceDir).size() == effPlan_.nrSourceMEs())) {
+    effPlan_.run();
+    return;
+  }
+  effPlan_.clear();
+  const size_t nrSourceMEs = igetter.getAllContents(sourceDir).size();
 
   ibooker.setCurrentFolder(dirName_ + "/Client_Histos");
 
@@ -189,6 +200,7 @@ void EgHLTOfflineClient::runClient_(DQMStore::IBooker& ibooker, DQMStore::IGette
   //----Morse-----
   ibooker.setCurrentFolder(dirName_);
   //----------
+  effPlan_.setBuilt(nrSourceMEs);
 }
 
 void EgHLTOfflineClient::createHLTvsOfflineHists(const std::string& filterName,
@@ -225,6 +237,7 @@ void EgHLTOfflineClient::createHLTvsOfflineHists(const std::string& filterName,
           FillHLTvsOfflineHist(filterName, effHistName, effHistTitle, numer, denom, ibooker, igetter);
       }
     }
+    else effPlan_.setMissingInput();
   }//end loop over varNames 
 }
 
@@ -248,6 +261,7 @@ MonitorElement* EgHLTOfflineClient::FillHLTvsOfflineHist(const std::string& filt
     *eff->getTH1F() = *h_eff;
     delete h_eff;
   }
+  effPlan_.add(egHLT::EffPlan::PASS_ALL, eff, numer, denom);
   return eff;
 }
 
@@ -273,6 +287,7 @@ void EgHLTOfflineClient::createN1EffHists(const std::string& filterName,
           igetter);
       //---------------------
     }
+    else effPlan_.setMissingInput();
   }//end loop over varNames 
 }
 
@@ -297,6 +312,7 @@ void EgHLTOfflineClient::createSingleEffHists(const std::string& filterName,
           igetter);
       //--------------------
     }
+    else effPlan_.setMissingInput();
   }//end loop over varNames 
 }
 
@@ -308,11 +324,13 @@ void EgHLTOfflineClient::createTrigTagProbeEffHists(const std::string& filterNam
     std::string allName(dirName_ + "/Source_Histos/" + filterName + "/" + filterName + "_trigTagProbe_" + objName + "_all_" + vsVarNames[varNr] + "_" + region);
     MonitorElement* all = igetter.get(allName);
     if (all == NULL) {
+      effPlan_.setMissingInput();
       continue;
     }
     std::string passName(dirName_ + "/Source_Histos/" + filterName + "/" + filterName + "_trigTagProbe_" + objName + "_pass_" + vsVarNames[varNr] + "_" + region);
     MonitorElement* pass = igetter.get(passName);
     if (pass == NULL) {
+      effPlan_.setMissingInput();
       continue;
     }
     //----Morse-----
@@ -345,18 +363,21 @@ void EgHLTOfflineClient::createTrigTagProbeEffHistsNewAlgo(const std::string& fi
     MonitorElement* passNotTag = igetter.get(passName);
     if (passNotTag == NULL) {
       //edm::LogInfo("EgHLTOfflineClient") <<" couldnt get hist "<<passName;
+      effPlan_.setMissingInput();
       continue;
     }
     std::string passTagTagName(dirName_+"/Source_Histos/"+filterName+"/"+filterName+"_trigTagProbe_"+objName+"_passTagTag_"+vsVarNames[varNr]+"_"+region);
     MonitorElement* passTagTag = igetter.get(passTagTagName);
     if (passTagTag == NULL) {
       //edm::LogInfo("EgHLTOfflineClient") <<" couldnt get hist "<<passTagTagName;
+      effPlan_.setMissingInput();
       continue;
     }
     std::string failName(dirName_+"/Source_Histos/"+filterName+"/"+filterName+"_trigTagProbe_"+objName+"_fail_"+vsVarNames[varNr]+"_"+region);
     MonitorElement* fail = igetter.get(failName);
     if (fail == NULL) {
       //edm::LogInfo("EgHLTOfflineClient") <<" couldnt get hist "<<failName;
+      effPlan_.setMissingInput();
       continue;
     }
     //----Morse-----
@@ -383,6 +404,7 @@ void EgHLTOfflineClient::createTrigTagProbeEffHists2Leg(const std::string& filte
     MonitorElement* all = igetter.get(allName);
     if (all == NULL) {
       edm::LogInfo("EgHLTOfflineClient") <<" couldnt get hist "<<allName;
+      effPlan_.setMissingInput();
       continue;
     }
 
@@ -390,6 +412,7 @@ void EgHLTOfflineClient::createTrigTagProbeEffHists2Leg(const std::string& filte
     MonitorElement* Leg2NotLeg1Source = igetter.get(Leg2NotLeg1SourceName);
     if (Leg2NotLeg1Source == NULL) {
       edm::LogInfo("EgHLTOfflineClient") <<" couldnt get hist "<<Leg2NotLeg1SourceName;
+      effPlan_.setMissingInput();
       continue;
     }
 
@@ -397,6 +420,7 @@ void EgHLTOfflineClient::createTrigTagProbeEffHists2Leg(const std::string& filte
     MonitorElement *Leg1Eff = igetter.get(Leg1EffName);
     if (Leg1Eff == NULL) {
       edm::LogInfo("EgHLTOfflineClient") <<" couldnt get hist "<<Leg1EffName;
+      effPlan_.setMissingInput();
       continue;
     }
 
@@ -429,11 +453,13 @@ void EgHLTOfflineClient::createLooseTightTrigEff(
       const std::string& looseTrig = splitString[1];
       MonitorElement* fail = igetter.get(dirName_ + "/Source_Histos/" + tightTrig + "_" + looseTrig + "_" + objName + "_failTrig_" + vsVarNames[varNr] + "_" + region);
       if (fail == NULL) {
+        effPlan_.setMissingInput();
         continue;
       }
 
       MonitorElement* pass = igetter.get(dirName_ + "/Source_Histos/" + tightTrig + "_" + looseTrig + "_" + objName + "_passTrig_" + vsVarNames[varNr] + "_" + region);
       if (pass == NULL) {
+        effPlan_.setMissingInput();
         continue;
       }
 
@@ -473,6 +499,7 @@ MonitorElement* EgHLTOfflineClient::makeEffMonElemFromPassAndAll(const std::stri
     *eff->getTH1F()=*effHist;
     delete effHist;
   }
+  effPlan_.add(egHLT::EffPlan::PASS_ALL, eff, pass, all);
   return eff;
 }
 
@@ -510,6 +537,7 @@ MonitorElement* EgHLTOfflineClient::makeEffMonElemFromPassAndFailAndTagTag(
     //*eff->getTGraphAsymmErrors()=*effHist;
     delete effHist;
   }
+  effPlan_.add(egHLT::EffPlan::PASS_FAIL_TAGTAG, eff, passNotTag, fail, tagtag);
   return eff;
 }
 
@@ -551,6 +579,7 @@ MonitorElement* EgHLTOfflineClient::makeEffMonElem2Leg(const std::string& filter
     *eff->getTH1F() = *effHist; 
     delete effHist;
   }
+  effPlan_.add(egHLT::EffPlan::TWO_LEG, eff, Leg1Eff, Leg2NotLeg1Source, all);
   return eff;
 }
 
@@ -577,5 +606,6 @@ MonitorElement* EgHLTOfflineClient::makeEffMonElemFromPassAndFail(const std::str
     *eff->getTH1F() = *effHist;
     delete effHist;
   }
+  effPlan_.add(egHLT::EffPlan::PASS_FAIL, eff, pass, fail);
   return eff;
 }
@@ -21,7 +21,9 @@
 using namespace egHLT;
 
 EgHLTOfflineSource::EgHLTOfflineSource(const edm::ParameterSet& iConfig):
-  nrEventsProcessed_(0)
+  nrEventsProcessed_(0),
+  menuCache_(iConfig.getUntrackedParameter<std::string>("menuCacheDir", "")),
+  timing_(iConfig)
 {
   binData_.setup(iConfig.getParameter<edm::ParameterSet>("binData"));
   cutMasks_.setup(iConfig.getParameter<edm::ParameterSet>("cutMasks"));
@@ -41,6 +43,13 @@ EgHLTOfflineSource::EgHLTOfflineSource(const edm::ParameterSet& iConfig):
 
  
   offEvtHelper_.setup(iConfig,  consumesCollector());
+
+  //in the order of TimingScope
+  timing_.addScope("analyze");
+  timing_.addScope("eleFilterMon");
+  timing_.addScope("phoFilterMon");
+  timing_.addScope("eleMonElems");
+  timing_.addScope("phoMonElems");
 }
 
 
@@ -63,6 +72,8 @@ EgHLTOfflineSource::~EgHLTOfflineSource()
 
 void EgHLTOfflineSource::bookHistograms(DQMStore::IBooker &iBooker, edm::Run const &run, edm::EventSetup const &c)
 {
+  timing_.beginBooking();
+
   iBooker.setCurrentFolder(dirName_);
 
   //the one monitor element the source fills directly
@@ -81,7 +92,7 @@ void EgHLTOfflineSource::bookHistograms(DQMStore::IBooker &iBooker, edm::Run con
   getHLTFilterNamesUsed(hltFiltersUsed);
   trigCodes.reset(TrigCodes::makeCodes(hltFiltersUsed));
   
-  offEvtHelper_.setupTriggers(hltConfig,hltFiltersUsed, *trigCodes);
+  offEvtHelper_.setupTriggers(hltConfig,hltFiltersUsed, *trigCodes, menuCache_);
 
   MonElemFuncs monElemFuncs(iBooker, *trigCodes);
 
@@ -133,11 +144,13 @@ void EgHLTOfflineSource::bookHistograms(DQMStore::IBooker &iBooker, edm::Run con
     // monElemFuncs.initTrigTagProbeHists(phoMonElems,phoHLTFilterNames_);
   }
   
+  timing_.bookHistograms(iBooker);
   iBooker.setCurrentFolder(dirName_);
 }
 
 void EgHLTOfflineSource::analyze(const edm::Event& iEvent,const edm::EventSetup& iSetup)
 { 
+  HLTDQMTiming::Scope analyzeTimer(timing_,kAnalyze,iEvent.luminosityBlock());
   const double weight=1.; //we have the ability to weight but its disabled for now - maybe use this for prescales?
   nrEventsProcessed_++;
   nrEventsProcessedMonElem_->Fill(nrEventsProcessed_);
@@ -148,24 +161,36 @@ void EgHLTOfflineSource::analyze(const edm::Event& iEvent,const edm::EventSetup&
   }
 
 
-  for(size_t pathNr=0;pathNr<eleFilterMonHists_.size();pathNr++){
-    eleFilterMonHists_[pathNr]->fill(offEvt_,weight);
-  } 
-  for(size_t pathNr=0;pathNr<phoFilterMonHists_.size();pathNr++){
-    phoFilterMonHists_[pathNr]->fill(offEvt_,weight);
+  {
+    HLTDQMTiming::Scope timer(timing_,kEleFilterMon,iEvent.luminosityBlock());
+    for(size_t pathNr=0;pathNr<eleFilterMonHists_.size();pathNr++){
+      eleFilterMonHists_[pathNr]->fill(offEvt_,weight);
+    } 
+  }
+  {
+    HLTDQMTiming::Scope timer(timing_,kPhoFilterMon,iEvent.luminosityBlock());
+    for(size_t pathNr=0;pathNr<phoFilterMonHists_.size();pathNr++){
+      phoFilterMonHists_[pathNr]->fill(offEvt_,weight);
+    }
   }
 
-  for(size_t monElemNr=0;monElemNr<eleMonElems_.size();monElemNr++){
-    const std::vector<OffEle>& eles = offEvt_.eles();
-    for(size_t eleNr=0;eleNr<eles.size();eleNr++){
-      eleMonElems_[monElemNr]->fill(eles[eleNr],offEvt_,weight);
+  {
+    HLTDQMTiming::Scope timer(timing_,kEleMonElems,iEvent.luminosityBlock());
+    for(size_t monElemNr=0;monElemNr<eleMonElems_.size();monElemNr++){
+      const std::vector<OffEle>& eles = offEvt_.eles();
+      for(size_t eleNr=0;eleNr<eles.size();eleNr++){
+        eleMonElems_[monElemNr]->fill(eles[eleNr],offEvt_,weight);
+      }
     }
   }
 
-  for(size_t monElemNr=0;monElemNr<phoMonElems_.size();monElemNr++){
-    const std::vector<OffPho>& phos = offEvt_.phos();
-    for(size_t phoNr=0;phoNr<phos.size();phoNr++){
-      phoMonElems_[monElemNr]->fill(phos[phoNr],offEvt_,weight);
+  {
+    HLTDQMTiming::Scope timer(timing_,kPhoMonElems,iEvent.luminosityBlock());
+    for(size_t monElemNr=0;monElemNr<phoMonElems_.size();monElemNr++){
+      const std::vector<OffPho>& phos = offEvt_.phos();
+      for(size_t phoNr=0;phoNr<phos.size();phoNr++){
+        phoMonElems_[monElemNr]->fill(phos[phoNr],offEvt_,weight);
+      }
     }
   }
 }
@@ -235,13 +260,16 @@ void EgHLTOfflineSource::getHLTFilterNamesUsed(std::vector<std::string>& filterN
 void EgHLTOfflineSource::filterTriggers(const HLTConfigProvider& hltConfig)
 {
   
-  std::vector<std::string> activeFilters;
-  std::vector<std::string> activeEleFilters;
-  std::vector<std::string> activeEle2LegFilters;
-  std::vector<std::string> activePhoFilters;
-  std::vector<std::string> activePho2LegFilters;
-  
-  trigTools::getActiveFilters(hltConfig,activeFilters,activeEleFilters,activeEle2LegFilters,activePhoFilters,activePho2LegFilters);
+  //getActiveFilters scans the whole parameter set registry for every e/gamma path,
+  //so its result is only worked out once per menu
+  HLTMenuCache::Tables active = menuCache_.get(hltConfig, "egHLTActiveFilters", [&hltConfig]() {
+      HLTMenuCache::Tables tables;
+      trigTools::getActiveFilters(hltConfig,tables["all"],tables["ele"],tables["ele2Leg"],tables["pho"],tables["pho2Leg"]);
+      return tables;
+    });
+  std::vector<std::string>& activeEleFilters = active["ele"];
+  std::vector<std::string>& activeEle2LegFilters = active["ele2Leg"];
+  std::vector<std::string>& activePhoFilters = active["pho"];
   
   trigTools::filterInactiveTriggers(eleHLTFilterNames_,activeEleFilters);
   trigTools::filterInactiveTriggers(phoHLTFilterNames_,activePhoFilters);
@@ -3,6 +3,7 @@
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
 
 #include <boost/algorithm/string.hpp>
+#include <unordered_map>
 using namespace egHLT;
 
 TrigCodes::TrigBitSet trigTools::getFiltersPassed(
@@ -47,44 +48,42 @@ std::vector<int> trigTools::getMinNrObjsRequiredByFilter(const std::vector<std::
   const std::string mag3("MinN");
   const std::string mag4("minN");
 
-  std::vector<std::string> filterEntryStrings;
-  filterEntryStrings.reserve(filterNames.size());
+  //the filters by the string of their module label entry, so that each pset costs one lookup
+  //however many filters are asked for (a filter may be asked for more than once)
+  std::unordered_map<std::string,std::vector<size_t> > filterNrsByEntry;
   for ( unsigned int i=0; i<filterNames.size(); i++) {
     const edm::Entry filterEntry(mag0,filterNames[i],true);
-    filterEntryStrings.push_back(filterEntry.toString());
+    filterNrsByEntry[filterEntry.toString()].push_back(i);
   }
 
-  //will return out of for loop once its found it to save time
   const edm::pset::Registry* psetRegistry = edm::pset::Registry::instance();
   if(psetRegistry==NULL) { retVal=std::vector<int>(filterNames.size(),-1); return retVal;}
   for(edm::pset::Registry::const_iterator psetIt=psetRegistry->begin();psetIt!=psetRegistry->end();++psetIt){ //loop over every pset for every module ever run
     const std::map<std::string,edm::Entry>& mapOfPara  = psetIt->second.tbl(); //contains the parameter name and value for all the parameters of the pset
     const std::map<std::string,edm::Entry>::const_iterator itToModLabel = mapOfPara.find(mag0); 
-    if(itToModLabel!=mapOfPara.end()){
-      std::string itString=itToModLabel->second.toString();
-
-      for ( unsigned int i=0; i<filterNames.size(); i++) {
-	if ( retVal[i] == -1 ) continue; //already done
-
-	if(itString==filterEntryStrings[i]){ //moduleName is the filter name, we have found filter, we will now return something
-	  std::map<std::string,edm::Entry>::const_iterator itToCandCut = mapOfPara.find(mag1);
-	  if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') retVal[i]=itToCandCut->second.getInt32();
-	  else{ //checks if nZcandcut exists and is int32, if not return -1
-	    itToCandCut = mapOfPara.find(mag2);
-	    if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') retVal[i]=itToCandCut->second.getInt32();
-	    else{ //checks if MinN exists and is int32, if not return -1
-	      itToCandCut = mapOfPara.find(mag3);
-	      if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') retVal[i]=itToCandCut->second.getInt32();
-	      else{ //checks if minN exists and is int32, if not return -1
-		itToCandCut = mapOfPara.find(mag4);
-		if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') retVal[i]= itToCandCut->second.getInt32();
-		else retVal[i]=-1;
-	      }
-	    }
-	  }
+    if(itToModLabel==mapOfPara.end()) continue;
+    const auto filterNrs = filterNrsByEntry.find(itToModLabel->second.toString());
+    if(filterNrs==filterNrsByEntry.end()) continue; //not one of our filters
+
+    //moduleName is the filter name, we have found filter, work out the min nr of objects
+    int minNrObjs=-1;
+    std::map<std::string,edm::Entry>::const_iterator itToCandCut = mapOfPara.find(mag1);
+    if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') minNrObjs=itToCandCut->second.getInt32();
+    else{ //checks if nZcandcut exists and is int32, if not return -1
+      itToCandCut = mapOfPara.find(mag2);
+      if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') minNrObjs=itToCandCut->second.getInt32();
+      else{ //checks if MinN exists and is int32, if not return -1
+	itToCandCut = mapOfPara.find(mag3);
+	if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') minNrObjs=itToCandCut->second.getInt32();
+	else{ //checks if minN exists and is int32, if not return -1
+	  itToCandCut = mapOfPara.find(mag4);
+	  if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') minNrObjs=itToCandCut->second.getInt32();
 	}
       }
     }
+    for(size_t filterNr : filterNrs->second){
+      if ( retVal[filterNr] != -1 ) retVal[filterNr]=minNrObjs; //once a filter has given -1 it stays at -1
+    }
   }
   for ( unsigned int i=0; i<filterNames.size(); i++) 
     if ( retVal[i]==-2 ) retVal[i]=-1;
@@ -5,7 +5,8 @@
 #include "DataFormats/HLTReco/interface/TriggerObject.h"
 #include "DQMOffline/Trigger/interface/EventShapeDQM.h"
 
-EventShapeDQM::EventShapeDQM(const edm::ParameterSet& ps)
+EventShapeDQM::EventShapeDQM(const edm::ParameterSet& ps):
+	pathMatcher_(ps.getParameter<std::string>("triggerPath"))
 {
 	triggerResults_ = consumes<edm::TriggerResults>(ps.getParameter<edm::InputTag>("triggerResults"));
 	theEPCollection_ = consumes<reco::EvtPlaneCollection>(ps.getParameter<edm::InputTag>("EPlabel"));
@@ -42,14 +43,7 @@ void EventShapeDQM::analyze(edm::Event const& e, edm::EventSetup const& eSetup)
 		return;
 	}
 
-	bool hasFired = false;
-	const edm::TriggerNames& trigNames = e.triggerNames(*hltresults);
-	unsigned int numTriggers = trigNames.size();
-	for( unsigned int hltIndex=0; hltIndex<numTriggers; ++hltIndex ) {
-		if (trigNames.triggerName(hltIndex).find(triggerPath_) != std::string::npos && hltresults->wasrun(hltIndex) && hltresults->accept(hltIndex)){
-			hasFired = true;
-		}
-	}
+	const bool hasFired = pathMatcher_.accept(e.triggerNames(*hltresults), *hltresults);
 
 	edm::Handle<reco::EvtPlaneCollection> ep_;
 	e.getByToken(theEPCollection_, ep_);
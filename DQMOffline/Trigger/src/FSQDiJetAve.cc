@@ -16,6 +16,7 @@
 //
 // system include files
 #include <memory>
+#include <algorithm>
 
 // user include files
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -29,6 +30,7 @@
 #include "FWCore/Framework/interface/ConsumesCollector.h"
 
 #include "DQMOffline/Trigger/interface/FSQDiJetAve.h"
+#include "DQMOffline/Trigger/interface/FSQKinematicExpression.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
@@ -112,16 +114,30 @@ class HandlerTemplate: public BaseHandler {
         std::string m_filterPartialName; //#("ForHFJECBase"); // Calo jet preFilter
 
         int m_combinedObjectDimension;
+        // the ranking is a symmetric function of the combined objects which does not
+        //  decrease when any of their pt increases (eg. sum of pt), allows to prune the search
+        bool m_pruneByPt;
 
         StringCutObjectSelector<TInputCandidateType>  m_singleObjectSelection;
         StringCutObjectSelector<std::vector<TOutputCandidateType> >  m_combinedObjectSelection;
         StringObjectFunction<std::vector<TOutputCandidateType> >     m_combinedObjectSortFunction;
-        std::map<std::string, std::shared_ptr<StringObjectFunction<std::vector<TOutputCandidateType> > > > m_plottersCombinedObject;
-        std::map<std::string, std::shared_ptr<StringObjectFunction<TInputCandidateType > > > m_plottersSingleObject;
-        /// xxx
-        static const int SingleObjectPlotter = 0;
-        static const int CombinedObjectPlotter = 1;
-        std::map<std::string, int > m_plotterType;
+        // native version of m_singleObjectSelection, used when it could be compiled
+        KinematicExpression m_singleObjectSelectionCompiled;
+        struct SingleObjectPlotter {
+            MonitorElement * histo;
+            std::shared_ptr<StringObjectFunction<TInputCandidateType> > function;
+            KinematicExpression compiled;  // used instead of function when compiled
+        };
+        struct CombinedObjectPlotter {
+            MonitorElement * histo;
+            std::shared_ptr<StringObjectFunction<std::vector<TOutputCandidateType> > > function;
+        };
+        std::vector<SingleObjectPlotter> m_singleObjectPlotters;
+        std::vector<CombinedObjectPlotter> m_combinedObjectPlotters;
+        // per event scratch of the single object preselection
+        KinematicBatch m_batch;
+        std::vector<double> m_values;
+        std::vector<size_t> m_selected;
         std::vector< edm::ParameterSet > m_combinedObjectDrawables;
         std::vector< edm::ParameterSet > m_singleObjectDrawables; // for all single objects passing preselection
         bool m_isSetup;
@@ -144,18 +160,23 @@ class HandlerTemplate: public BaseHandler {
              m_filterPartialName = iConfig.getParameter<std::string>("partialFilterName"); // std::string find is used to match filter
              m_pathPartialName  = iConfig.getParameter<std::string>("partialPathName");
              m_combinedObjectDimension = iConfig.getParameter<int>("combinedObjectDimension");
+             m_pruneByPt = iConfig.getUntrackedParameter<bool>("combinedObjectSortMonotoneInPt", false);
              m_combinedObjectDrawables = iConfig.getParameter<  std::vector< edm::ParameterSet > >("combinedObjectDrawables");
              m_singleObjectDrawables = iConfig.getParameter<  std::vector< edm::ParameterSet > >("singleObjectDrawables");
              m_isSetup = false;
+             m_singleObjectSelectionCompiled.compile(iConfig.getParameter<std::string>("singleObjectsPreselection"), 
+                                                     KinematicExpression::Cut);
         }
 
         void book(DQMStore::IBooker & booker){
             if(!m_isSetup){
                 booker.setCurrentFolder(m_dirname);
                 m_isSetup = true;
+                static const int SingleObjectDrawables = 0;
+                static const int CombinedObjectDrawables = 1;
                 std::vector< std::vector< edm::ParameterSet > * > todo(2, (std::vector< edm::ParameterSet > * )0);
-                todo[CombinedObjectPlotter]=&m_combinedObjectDrawables;
-                todo[SingleObjectPlotter]=&m_singleObjectDrawables;
+                todo[CombinedObjectDrawables]=&m_combinedObjectDrawables;
+                todo[SingleObjectDrawables]=&m_singleObjectDrawables;
                 for (size_t ti =0; ti<todo.size();++ti){
                     for (size_t i = 0; i < todo[ti]->size(); ++i){
                         std::string histoName = m_dqmhistolabel + "_" + todo[ti]->at(i).template getParameter<std::string>("name");
@@ -164,15 +185,21 @@ class HandlerTemplate: public BaseHandler {
                         double rangeLow  =  todo[ti]->at(i).template getParameter<double>("min");
                         double rangeHigh =  todo[ti]->at(i).template getParameter<double>("max");
                         m_histos[histoName] =  booker.book1D(histoName, histoName, bins, rangeLow, rangeHigh);
-                        m_plotterType[histoName] = ti;
-                        if (ti == CombinedObjectPlotter){
+                        if (ti == CombinedObjectDrawables){
                             StringObjectFunction<std::vector<TOutputCandidateType> > * func 
                                     = new StringObjectFunction<std::vector<TOutputCandidateType> >(expression);
-                            m_plottersCombinedObject[histoName] =  std::shared_ptr<StringObjectFunction<std::vector<TOutputCandidateType> > >(func);
+                            CombinedObjectPlotter plotter;
+                            plotter.histo = m_histos[histoName];
+                            plotter.function = std::shared_ptr<StringObjectFunction<std::vector<TOutputCandidateType> > >(func);
+                            m_combinedObjectPlotters.push_back(plotter);
                         } else {
                             StringObjectFunction< TInputCandidateType>  * func 
                                     = new StringObjectFunction< TInputCandidateType> (expression);
-                            m_plottersSingleObject[histoName] =  std::shared_ptr<StringObjectFunction<TInputCandidateType> > (func);
+                            SingleObjectPlotter plotter;
+                            plotter.histo = m_histos[histoName];
+                            plotter.function = std::shared_ptr<StringObjectFunction<TInputCandidateType> > (func);
+                            plotter.compiled.compile(expression, KinematicExpression::Function);
+                            m_singleObjectPlotters.push_back(plotter);
                         }
                     }   
                 }
@@ -188,36 +215,84 @@ class HandlerTemplate: public BaseHandler {
         //  - partial specialization not easy...:
         // http://stackoverflow.com/questions/21182729/specializing-single-method-in-a-big-template-class
         //#############################################################################
-        template <class T>
-        int count(const edm::Event& iEvent, InputTag &input, StringCutObjectSelector<T> & sel, float weight){
-           int ret = 0;
-           Handle<std::vector< T > > hIn;
+        int count(const edm::Event& iEvent, InputTag &input, float weight){
+           Handle<std::vector< TInputCandidateType > > hIn;
            iEvent.getByToken(m_tokens[input.encode()], hIn);
            if(!hIn.isValid()) {
               edm::LogError("FSQDiJetAve") << "product not found: "<<  input.encode();
               return -1;  // return nonsense value
            }
-           for (size_t i = 0; i<hIn->size(); ++i) {
-                bool preselection = sel(hIn->at(i));
-                if (preselection){
-                    fillSingleObjectPlots(hIn->at(i), weight);
-                    ret+=1;
+           const std::vector< TInputCandidateType > & in = *hIn;
+           preselect(in.size(), [&in](size_t i) -> const TInputCandidateType & { return in[i]; }, weight);
+           return m_selected.size();
+        }
+
+        //#############################################################################
+        // Single object preselection of the n objects returned by get(i). Leaves the
+        //  indices of the selected ones in m_selected. Expressions which could be
+        //  compiled are evaluated column-wise over m_batch, the others through
+        //  reflection, object by object. m_batch is filled from getKinematics(i),
+        //  anything with pt(), eta() and phi().
+        //#############################################################################
+        template <class Getter, class KinematicsGetter>
+        void select(size_t n, const Getter & get, const KinematicsGetter & getKinematics){
+            m_selected.clear();
+            if (n == 0) return;
+            bool needBatch = m_singleObjectSelectionCompiled.isCompiled();
+            for (size_t iPlot = 0; iPlot < m_singleObjectPlotters.size(); ++iPlot){
+                needBatch |= m_singleObjectPlotters[iPlot].compiled.isCompiled();
+            }
+            if (needBatch){
+                m_batch.resize(n);
+                for (size_t i = 0; i<n; ++i) m_batch.set(i, getKinematics(i));
+            }
+            if (m_singleObjectSelectionCompiled.isCompiled()){
+                m_singleObjectSelectionCompiled.evaluate(m_batch, m_values);
+                for (size_t i = 0; i<n; ++i){
+                    if (m_values[i] != 0) m_selected.push_back(i);
                 }
-           }
-           return ret;
+            } else {
+                for (size_t i = 0; i<n; ++i){
+                    if (m_singleObjectSelection(get(i))) m_selected.push_back(i);
+                }
+            }
+        }
+
+        template <class Getter>
+        void select(size_t n, const Getter & get){
+            select(n, get, get);
         }
 
-        // FIXME (?): code duplication
-        void fillSingleObjectPlots(const TInputCandidateType & cand, float weight){
-            std::map<std::string,  MonitorElement*>::iterator it, itE;
-            it = m_histos.begin();
-            itE = m_histos.end();
-            for (;it!=itE;++it){
-                if (m_plotterType[it->first]!=SingleObjectPlotter) continue;
-                float val = (*m_plottersSingleObject[it->first])(cand);
-                it->second->Fill(val, weight);
+        // fills the single object plots for the objects in m_selected
+        template <class Getter>
+        void fillSingleObjectPlots(const Getter & get, float weight){
+            for (size_t iPlot = 0; iPlot < m_singleObjectPlotters.size(); ++iPlot){
+                SingleObjectPlotter & plotter = m_singleObjectPlotters[iPlot];
+                if (plotter.compiled.isCompiled()){
+                    plotter.compiled.evaluate(m_batch, m_values);
+                    for (size_t i = 0; i < m_selected.size(); ++i){
+                        float val = m_values[m_selected[i]];
+                        plotter.histo->Fill(val, weight);
+                    }
+                } else {
+                    for (size_t i = 0; i < m_selected.size(); ++i){
+                        float val = (*plotter.function)(get(m_selected[i]));
+                        plotter.histo->Fill(val, weight);
+                    }
+                }
             }
         }
+
+        template <class Getter, class KinematicsGetter>
+        void preselect(size_t n, const Getter & get, const KinematicsGetter & getKinematics, float weight){
+            select(n, get, getKinematics);
+            fillSingleObjectPlots(get, weight);
+        }
+        template <class Getter>
+        void preselect(size_t n, const Getter & get, float weight){
+            preselect(n, get, get, weight);
+        }
+
         // Notes:
         //  - this function (and specialized versions) are responsible for calling
         //     fillSingleObjectPlots for all single objects passing the single
@@ -243,12 +318,10 @@ class HandlerTemplate: public BaseHandler {
                   return;  
                }
 
-               for (size_t i = 0; i<hIn->size(); ++i) {
-                    bool preselection = m_singleObjectSelection(hIn->at(i));
-                    if (preselection){
-                        fillSingleObjectPlots(hIn->at(i), weight);
-                        cands.push_back(hIn->at(i));
-                    }
+               const std::vector<TInputCandidateType> & in = *hIn;
+               preselect(in.size(), [&in](size_t i) -> const TInputCandidateType & { return in[i]; }, weight);
+               for (size_t i = 0; i<m_selected.size(); ++i) {
+                    cands.push_back(in[m_selected[i]]);
                }
         }
 
@@ -344,83 +417,99 @@ class HandlerTemplate: public BaseHandler {
             if (bestCombinationFromCands.size()==0) return;
 
             // plot 
-            std::map<std::string,  MonitorElement*>::iterator it, itE;
-            it = m_histos.begin();
-            itE = m_histos.end();
-            for (;it!=itE;++it){
-                if (m_plotterType[it->first]!=CombinedObjectPlotter) continue;
-                float val = (*m_plottersCombinedObject[it->first])(bestCombinationFromCands);
-                it->second->Fill(val, weight);
+            for (size_t iPlot = 0; iPlot < m_combinedObjectPlotters.size(); ++iPlot){
+                CombinedObjectPlotter & plotter = m_combinedObjectPlotters[iPlot];
+                float val = (*plotter.function)(bestCombinationFromCands);
+                plotter.histo->Fill(val, weight);
             }
         }
 
+        // Finds the ordered m_combinedObjectDimension-tuple of distinct candidates
+        // passing m_combinedObjectSelection with the highest m_combinedObjectSortFunction.
+        // Ties go to the lexicographically smallest tuple of candidate indices, ie the one
+        // the former scan over all index tuples found first.
         std::vector<TOutputCandidateType> getBestCombination(std::vector<TOutputCandidateType> & cands ){
+            std::vector<TOutputCandidateType > bestCombinationFromCands;
             int columnSize = cands.size();
-            std::vector<int> currentCombination(m_combinedObjectDimension, 0);
-            std::vector<int> bestCombination(m_combinedObjectDimension, -1);
-
-            int maxCombinations = 1;
-            int cnt = 0;
-            while (cnt < m_combinedObjectDimension){
-                cnt += 1;
-                maxCombinations *= columnSize;
+            if (m_combinedObjectDimension <= 0 || m_combinedObjectDimension > columnSize) return bestCombinationFromCands;
+
+            // combinations are built from positions in m_order; when pruning the candidates
+            //  are visited by decreasing pt, so the highest bound of a partial combination
+            //  is obtained by completing it with the following positions
+            m_order.resize(columnSize);
+            for (int i = 0; i<columnSize;++i) m_order[i] = i;
+            if (m_pruneByPt){
+                std::stable_sort(m_order.begin(), m_order.end(), 
+                                 [&cands](int a, int b){ return candidatePt(cands[a]) > candidatePt(cands[b]); });
+            }
+            m_positions.resize(m_combinedObjectDimension);
+            m_combination.resize(m_combinedObjectDimension);
+            m_combinedCands.resize(m_combinedObjectDimension);
+            m_bestCombination.clear();
+            m_bestCombinedCandVal = -1;
+
+            searchCombinations(cands, 0, 0);
+
+            for (size_t i = 0; i<m_bestCombination.size();++i){
+                bestCombinationFromCands.push_back( cands.at(m_bestCombination.at(i)));
             }
+            return bestCombinationFromCands;
+        }
 
-            cnt = 0;
-            float bestCombinedCandVal = -1;
-            while ( cnt < maxCombinations){
-                cnt += 1;
-
-                // 1. Check if current combination contains duplicates
-                std::vector<int> currentCombinationCopy(currentCombination);
-                std::vector<int>::iterator it;
-                std::sort(currentCombinationCopy.begin(), currentCombinationCopy.end());
-                it = std::unique(currentCombinationCopy.begin(), currentCombinationCopy.end());
-                currentCombinationCopy.resize( std::distance(currentCombinationCopy.begin(),it) );
-                bool duplicatesPresent = currentCombination.size() != currentCombinationCopy.size();
-                // 2. If no duplicates found - 
-                //          - check if current combination passes the cut
-                //          - rank current combination
-                if (!duplicatesPresent) { // no duplicates, we can consider this combined object
-                    std::vector<TOutputCandidateType > currentCombinationFromCands;
+    private:
+        static float candidatePt(const int & cand) { return cand; }
+        template <class T>
+        static float candidatePt(const T & cand) { return cand.pt(); }
+
+        // ranking of the candidates at m_positions[0..depth], completed with the positions following the last one
+        float rankCompletion(const std::vector<TOutputCandidateType> & cands, int depth){
+            for (int i = 0; i<m_combinedObjectDimension;++i){
+                int position = i <= depth ? m_positions[i] : m_positions[depth] + (i - depth);
+                m_combinedCands[i] = cands[m_order[position]];
+            }
+            return m_combinedObjectSortFunction(m_combinedCands);
+        }
+
+        // n-choose-k over the positions, each combination is tried in all its orderings
+        void searchCombinations(const std::vector<TOutputCandidateType> & cands, int depth, int start){
+            int columnSize = cands.size();
+            int last = columnSize - (m_combinedObjectDimension - depth);
+            for (int position = start; position <= last; ++position){
+                m_positions[depth] = position;
+                // completions of later positions only have lower pt objects, so stop at the first hopeless one
+                if (m_pruneByPt && rankCompletion(cands, depth) < m_bestCombinedCandVal) break;
+                if (depth + 1 < m_combinedObjectDimension) {
+                    searchCombinations(cands, depth + 1, position + 1);
+                    continue;
+                }
+                for (int i = 0; i<m_combinedObjectDimension;++i) m_combination[i] = m_order[m_positions[i]];
+                std::sort(m_combination.begin(), m_combination.end());
+                do {
                     for (int i = 0; i<m_combinedObjectDimension;++i){
-                        currentCombinationFromCands.push_back( cands.at(currentCombination.at(i)));
+                        m_combinedCands[i] = cands[m_combination[i]];
                     }
-                    bool isOK = m_combinedObjectSelection(currentCombinationFromCands);
-                    if (isOK){
-                        float curVal = m_combinedObjectSortFunction(currentCombinationFromCands);
-                        // FIXME
-                        if (curVal < 0) {
-                            edm::LogError("FSQDiJetAve") << "Problem: ranking function returned negative value: " << curVal << std::endl;
-                        } else if (curVal > bestCombinedCandVal){
-                            //std::cout << curVal << " " << bestCombinedCandVal << std::endl;
-                            bestCombinedCandVal = curVal;
-                            bestCombination = currentCombination;
-                        }
-                    }
-                }
-                // 3. Prepare next combination to test
-                //    note to future self: less error prone method with modulo
-                currentCombination.at(m_combinedObjectDimension-1)+=1; // increase last number
-                int carry = 0;
-                for (int i = m_combinedObjectDimension-1; i>=0; --i){  // iterate over all numbers, check if we are out of range
-                    currentCombination.at(i)+= carry;
-                    carry = 0;
-                    if (currentCombination.at(i)>=columnSize){
-                        carry = 1;
-                        currentCombination.at(i) = 0;
+                    bool isOK = m_combinedObjectSelection(m_combinedCands);
+                    if (!isOK) continue;
+                    float curVal = m_combinedObjectSortFunction(m_combinedCands);
+                    // FIXME
+                    if (curVal < 0) {
+                        edm::LogError("FSQDiJetAve") << "Problem: ranking function returned negative value: " << curVal << std::endl;
+                    } else if (curVal > m_bestCombinedCandVal || 
+                               (curVal == m_bestCombinedCandVal && m_combination < m_bestCombination)){
+                        m_bestCombinedCandVal = curVal;
+                        m_bestCombination = m_combination;
                     }
-                }
-            } // combinations loop ends
-
-            std::vector<TOutputCandidateType > bestCombinationFromCands;
-            if (bestCombination.size()!=0 && bestCombination.at(0)>=0){
-                for (int i = 0; i<m_combinedObjectDimension;++i){
-                          bestCombinationFromCands.push_back( cands.at(bestCombination.at(i)));
-                }
+                } while (std::next_permutation(m_combination.begin(), m_combination.end()));
             }
-            return bestCombinationFromCands;
         }
+
+        // search scratch, kept between events to reuse the allocations
+        std::vector<int> m_order;
+        std::vector<int> m_positions;
+        std::vector<int> m_combination;
+        std::vector<int> m_bestCombination;
+        std::vector<TOutputCandidateType> m_combinedCands;
+        float m_bestCombinedCandVal;
 };
 //#############################################################################
 // Read any object inheriting from reco::Candidate. Save p4
@@ -451,12 +540,10 @@ void HandlerTemplate<reco::Candidate::LorentzVector, reco::Candidate::LorentzVec
       edm::LogError("FSQDiJetAve") << "product not found: "<<  m_input.encode();
       return;
    }
-   for (size_t i = 0; i<hIn->size(); ++i) {
-        bool preselection = m_singleObjectSelection(hIn->at(i).p4());
-        if (preselection){
-            fillSingleObjectPlots(hIn->at(i).p4(), weight);
-            cands.push_back(hIn->at(i).p4());
-        }
+   const View<reco::Candidate> & in = *hIn;
+   preselect(in.size(), [&in](size_t i) -> const reco::Candidate::LorentzVector & { return in[i].p4(); }, weight);
+   for (size_t i = 0; i<m_selected.size(); ++i) {
+        cands.push_back(in[m_selected[i]].p4());
    }
 }
 //#############################################################################
@@ -477,7 +564,7 @@ void HandlerTemplate<reco::Track, int >::getFilteredCands(
              float weight)
 {  
    cands.clear();
-   cands.push_back(count<reco::Track>(iEvent, m_input, m_singleObjectSelection, weight) );
+   cands.push_back(count(iEvent, m_input, weight) );
 }
 template<>
 void HandlerTemplate<reco::GenParticle, int >::getFilteredCands(
@@ -487,7 +574,7 @@ void HandlerTemplate<reco::GenParticle, int >::getFilteredCands(
              const HLTConfigProvider&  hltConfig, const trigger::TriggerEvent& trgEvent, float weight)
 {
    cands.clear();
-   cands.push_back(count<reco::GenParticle>(iEvent, m_input, m_singleObjectSelection, weight) );
+   cands.push_back(count(iEvent, m_input, weight) );
 }
 //#############################################################################
 //
@@ -562,8 +649,10 @@ void HandlerTemplate<reco::Track, int, BestVertexMatching>::getFilteredCands(
       return;
    }
 
-   for (size_t i = 0; i<hIn->size(); ++i) {
-        if (!m_singleObjectSelection(hIn->at(i))) continue;
+   const std::vector<reco::Track> & in = *hIn;
+   select(in.size(), [&in](size_t i) -> const reco::Track & { return in[i]; });
+   for (size_t iSel = 0; iSel<m_selected.size(); ++iSel) {
+        size_t i = m_selected[iSel];
         dxy=0.0, dz=0.0, dxysigma=0.0, dzsigma=0.0;
         dxy = -1.*hIn->at(i).dxy(vtxPoint);
         dz = hIn->at(i).dz(vtxPoint);
@@ -618,16 +707,28 @@ void HandlerTemplate<reco::PFJet, reco::PFJet, ApplyJEC>::getFilteredCands(
       return;  
     }
 
-    for (size_t i = 0; i<hIn->size(); ++i) {
-         double scale = pfcorrector->correction(hIn->at(i));
-         reco::PFJet newPFJet(scale*hIn->at(i).p4(), hIn->at(i).vertex(), 
-                              hIn->at(i).getSpecific(),  hIn->at(i).getJetConstituents());
-         
-         bool preselection = m_singleObjectSelection(newPFJet);
-         if (preselection){
-             fillSingleObjectPlots(newPFJet, weight);
-             cands.push_back(newPFJet);
-         }
+    const std::vector<reco::PFJet> & in = *hIn;
+    std::vector<reco::PFJet::LorentzVector> correctedP4;
+    correctedP4.reserve(in.size());
+    for (size_t i = 0; i<in.size(); ++i) {
+         correctedP4.push_back(pfcorrector->correction(in[i])*in[i].p4());
+    }
+
+    // the preselection runs on the corrected p4, a corrected jet is only built
+    //  for the expressions evaluated through reflection, one at a time
+    reco::PFJet corrected;
+    auto getCorrected = [&in, &correctedP4, &corrected](size_t i) -> const reco::PFJet & {
+         corrected = reco::PFJet(correctedP4[i], in[i].vertex(), in[i].getSpecific(), in[i].getJetConstituents());
+         return corrected;
+    };
+    preselect(in.size(), getCorrected,
+              [&correctedP4](size_t i) -> const reco::PFJet::LorentzVector & { return correctedP4[i]; }, weight);
+
+    cands.reserve(m_selected.size());
+    for (size_t i = 0; i<m_selected.size(); ++i) {
+         const size_t iJet = m_selected[i];
+         cands.push_back(reco::PFJet(correctedP4[iJet], in[iJet].vertex(),
+                                     in[iJet].getSpecific(), in[iJet].getJetConstituents()));
     }
 }
 //#############################################################################
@@ -662,13 +763,9 @@ void HandlerTemplate<reco::Candidate::LorentzVector, int >::getFilteredCands(
       edm::LogError("FSQDiJetAve") << "product not found: "<<  m_input.encode();
       return;
    }
-   for (size_t i = 0; i<hIn->size(); ++i) {
-        bool preselection = m_singleObjectSelection(hIn->at(i).p4());
-        if (preselection){
-            fillSingleObjectPlots(hIn->at(i).p4(), weight);
-            cands.at(0)+=1;
-        }
-   }
+   const View<reco::Candidate> & in = *hIn;
+   preselect(in.size(), [&in](size_t i) -> const reco::Candidate::LorentzVector & { return in[i].p4(); }, weight);
+   cands.at(0) = m_selected.size();
 }
 //#############################################################################
 //
@@ -705,14 +802,9 @@ void HandlerTemplate<trigger::TriggerObject, trigger::TriggerObject>::getFiltere
     const trigger::TriggerObjectCollection & toc(trgEvent.getObjects());
     const trigger::Keys & khlt = trgEvent.filterKeys(hltIndex);
 
-    trigger::Keys::const_iterator kj = khlt.begin();
-
-    for(;kj != khlt.end(); ++kj){
-        bool preselection = m_singleObjectSelection(toc[*kj]);
-        if (preselection){
-            fillSingleObjectPlots(toc[*kj], weight);
-            cands.push_back( toc[*kj]);
-        }
+    preselect(khlt.size(), [&toc, &khlt](size_t i) -> const trigger::TriggerObject & { return toc[khlt[i]]; }, weight);
+    for (size_t i = 0; i<m_selected.size(); ++i) {
+        cands.push_back( toc[khlt[m_selected[i]]]);
     }
 
 }
@@ -0,0 +1,218 @@
+#include "DQMOffline/Trigger/interface/FSQKinematicExpression.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+namespace FSQ {
+
+//################################################################################################
+//
+// Recursive descent parser, emits the postfix program. Each rule returns the
+//  kind of value it produced (numeric or boolean) or Invalid.
+//
+//################################################################################################
+class KinematicExpression::Parser {
+    public:
+        enum Type { Invalid, Numeric, Boolean };
+
+        Parser(const std::string & expression, std::vector<Op> & program):
+            m_text(expression), m_pos(0), m_program(program) {}
+
+        Type parse(){
+            Type type = orExpr();
+            skipSpaces();
+            return m_pos == m_text.size() ? type : Invalid;
+        }
+
+    private:
+        void skipSpaces(){
+            while (m_pos < m_text.size() && std::isspace(m_text[m_pos])) ++m_pos;
+        }
+        bool accept(const char * token){
+            skipSpaces();
+            size_t len = std::string(token).size();
+            if (m_text.compare(m_pos, len, token) != 0) return false;
+            m_pos += len;
+            return true;
+        }
+        void emit(OpCode code, double value = 0){
+            Op op;
+            op.code = code;
+            op.value = value;
+            m_program.push_back(op);
+        }
+
+        Type orExpr(){
+            Type type = andExpr();
+            while (type != Invalid && accept("||")){
+                if (type != Boolean || andExpr() != Boolean) return Invalid;
+                emit(Or);
+            }
+            return type;
+        }
+        Type andExpr(){
+            Type type = notExpr();
+            while (type != Invalid && accept("&&")){
+                if (type != Boolean || notExpr() != Boolean) return Invalid;
+                emit(And);
+            }
+            return type;
+        }
+        Type notExpr(){
+            skipSpaces();
+            if (m_text.compare(m_pos, 2, "!=") != 0 && accept("!")){
+                if (notExpr() != Boolean) return Invalid;
+                emit(Not);
+                return Boolean;
+            }
+            return cmpExpr();
+        }
+        Type cmpExpr(){
+            Type type = addExpr();
+            if (type != Numeric) return type;
+            OpCode code;
+            // two character operators first
+            if (accept("<=")) code = LessEqual;
+            else if (accept(">=")) code = GreaterEqual;
+            else if (accept("==")) code = Equal;
+            else if (accept("!=")) code = NotEqual;
+            else if (accept("<")) code = Less;
+            else if (accept(">")) code = Greater;
+            else return Numeric;
+            if (addExpr() != Numeric) return Invalid;
+            emit(code);
+            return Boolean;
+        }
+        Type addExpr(){
+            Type type = mulExpr();
+            while (type == Numeric){
+                OpCode code;
+                if (accept("+")) code = Add;
+                else if (accept("-")) code = Sub;
+                else break;
+                if (mulExpr() != Numeric) return Invalid;
+                emit(code);
+            }
+            return type;
+        }
+        Type mulExpr(){
+            Type type = unary();
+            while (type == Numeric){
+                OpCode code;
+                if (accept("*")) code = Mul;
+                else if (accept("/")) code = Div;
+                else break;
+                if (unary() != Numeric) return Invalid;
+                emit(code);
+            }
+            return type;
+        }
+        Type unary(){
+            if (accept("-")){
+                if (unary() != Numeric) return Invalid;
+                emit(Neg);
+                return Numeric;
+            }
+            if (accept("+")) return unary() == Numeric ? Numeric : Invalid;
+            return primary();
+        }
+        Type primary(){
+            skipSpaces();
+            if (m_pos >= m_text.size()) return Invalid;
+            if (accept("(")){
+                Type type = orExpr();
+                return accept(")") ? type : Invalid;
+            }
+            char c = m_text[m_pos];
+            if (std::isdigit(c) || c == '.'){
+                const char * begin = m_text.c_str() + m_pos;
+                char * end = 0;
+                double value = std::strtod(begin, &end);
+                if (end == begin) return Invalid;
+                m_pos += end - begin;
+                emit(PushConst, value);
+                return Numeric;
+            }
+            if (!std::isalpha(c) && c != '_') return Invalid;
+            size_t begin = m_pos;
+            while (m_pos < m_text.size() && (std::isalnum(m_text[m_pos]) || m_text[m_pos] == '_')) ++m_pos;
+            std::string name = m_text.substr(begin, m_pos - begin);
+            if (name == "abs"){
+                if (!accept("(") || orExpr() != Numeric || !accept(")")) return Invalid;
+                emit(Abs);
+                return Numeric;
+            }
+            OpCode code;
+            if (name == "pt") code = PushPt;
+            else if (name == "eta") code = PushEta;
+            else if (name == "phi") code = PushPhi;
+            else return Invalid;
+            if (accept("(") && !accept(")")) return Invalid;
+            // methods of the returned value (pt.foo) are not supported
+            skipSpaces();
+            if (m_pos < m_text.size() && m_text[m_pos] == '.') return Invalid;
+            emit(code);
+            return Numeric;
+        }
+
+        const std::string & m_text;
+        size_t m_pos;
+        std::vector<Op> & m_program;
+};
+
+bool KinematicExpression::compile(const std::string & expression, Kind kind){
+    m_program.clear();
+    Parser::Type type = Parser(expression, m_program).parse();
+    m_isCompiled = (kind == Cut && type == Parser::Boolean) || (kind == Function && type == Parser::Numeric);
+    if (!m_isCompiled) m_program.clear();
+    return m_isCompiled;
+}
+
+void KinematicExpression::evaluate(const KinematicBatch & batch, std::vector<double> & values) const {
+    const size_t n = batch.size();
+    size_t depth = 0;
+    for (size_t iOp = 0; iOp < m_program.size(); ++iOp){
+        const Op & op = m_program[iOp];
+        if (op.code <= PushConst){
+            if (m_stack.size() <= depth) m_stack.resize(depth + 1);
+            std::vector<double> & out = m_stack[depth++];
+            switch (op.code){
+                case PushPt: out = batch.pt; break;
+                case PushEta: out = batch.eta; break;
+                case PushPhi: out = batch.phi; break;
+                default: out.assign(n, op.value); break;
+            }
+            continue;
+        }
+        if (op.code <= Not){
+            std::vector<double> & a = m_stack[depth - 1];
+            switch (op.code){
+                case Neg: for (size_t i = 0; i < n; ++i) a[i] = -a[i]; break;
+                case Abs: for (size_t i = 0; i < n; ++i) a[i] = std::fabs(a[i]); break;
+                default:  for (size_t i = 0; i < n; ++i) a[i] = !(a[i] != 0); break;
+            }
+            continue;
+        }
+        std::vector<double> & a = m_stack[depth - 2];
+        const std::vector<double> & b = m_stack[depth - 1];
+        switch (op.code){
+            case Add:          for (size_t i = 0; i < n; ++i) a[i] = a[i] + b[i]; break;
+            case Sub:          for (size_t i = 0; i < n; ++i) a[i] = a[i] - b[i]; break;
+            case Mul:          for (size_t i = 0; i < n; ++i) a[i] = a[i] * b[i]; break;
+            case Div:          for (size_t i = 0; i < n; ++i) a[i] = a[i] / b[i]; break;
+            case Less:         for (size_t i = 0; i < n; ++i) a[i] = a[i] < b[i]; break;
+            case LessEqual:    for (size_t i = 0; i < n; ++i) a[i] = a[i] <= b[i]; break;
+            case Greater:      for (size_t i = 0; i < n; ++i) a[i] = a[i] > b[i]; break;
+            case GreaterEqual: for (size_t i = 0; i < n; ++i) a[i] = a[i] >= b[i]; break;
+            case Equal:        for (size_t i = 0; i < n; ++i) a[i] = a[i] == b[i]; break;
+            case NotEqual:     for (size_t i = 0; i < n; ++i) a[i] = a[i] != b[i]; break;
+            case And:          for (size_t i = 0; i < n; ++i) a[i] = (a[i] != 0) && (b[i] != 0); break;
+            default:           for (size_t i = 0; i < n; ++i) a[i] = (a[i] != 0) || (b[i] != 0); break;
+        }
+        --depth;
+    }
+    values.swap(m_stack[0]);
+}
+
+}
@@ -38,6 +38,7 @@ Implementation:
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
+#include "DQMOffline/Trigger/interface/HLTDQMTiming.h"
 
 #include "TMath.h"
 #include "TStyle.h"
@@ -62,12 +63,20 @@ class GeneralHLTOffline : public DQMEDAnalyzer {
   virtual void endLuminosityBlock(edm::LuminosityBlock const&,
                                   edm::EventSetup const&) override;
   virtual void setupHltMatrix(DQMStore::IBooker & iBooker, const std::string &, int);
-  virtual void fillHltMatrix(const std::string &,
-                             const std::string &,
-                             bool,
-                             bool,
-			     edm::Handle<trigger::TriggerEventWithRefs>,
-			     edm::Handle<trigger::TriggerEvent>);
+  virtual void fillHltMatrix(const edm::TriggerResults &,
+                             unsigned int,
+                             unsigned int);
+
+  // Per-path filter progress: the position inside the HLT path of each
+  // module shown in the cpfilt histogram (ascending, one per bin), so the
+  // filters passed in an event follow from TriggerResults::index() alone.
+  struct PathFilterProgress {
+    PathFilterProgress(): triggerIndex(0), cppathBin(0), hist_cpfilt(0) {}
+    unsigned int triggerIndex;
+    int cppathBin;
+    std::vector<unsigned int> moduleIndices;
+    TH1F * hist_cpfilt;
+  };
 
   // ----------member data ---------------------------
 
@@ -86,13 +95,16 @@ class GeneralHLTOffline : public DQMEDAnalyzer {
   std::vector<std::string> DataSetNames;
   std::map< std::string, std::vector<std::string> > PathModules;
   edm::EDGetTokenT <edm::TriggerResults>   triggerResultsToken;
-  edm::EDGetTokenT <trigger::TriggerEventWithRefs> triggerSummaryTokenRAW;
-  edm::EDGetTokenT <trigger::TriggerEvent> triggerSummaryTokenAOD;
 
   MonitorElement * cppath_;
   std::map<std::string, MonitorElement*> cppath_mini_;
   std::map<std::string, MonitorElement*> cpfilt_mini_;
   std::map<std::string, TH1F*> hist_cpfilt_mini_;
+  // indexed like PDsVectorPathsVector, filled in setupHltMatrix
+  std::vector<TH1F*> hist_cppath_mini_;
+  std::vector< std::vector<PathFilterProgress> > pathProgress_;
+
+  HLTDQMTiming timing_;
 
 };
 
@@ -101,7 +113,8 @@ class GeneralHLTOffline : public DQMEDAnalyzer {
 //
 GeneralHLTOffline::GeneralHLTOffline(const edm::ParameterSet& ps):streamA_found_(false),
                                                                   hlt_menu_(""),
-                                                                  cppath_(0) {
+                                                                  cppath_(0),
+                                                                  timing_(ps) {
   debugPrint  = false;
   outputPrint = false;
 
@@ -110,10 +123,10 @@ GeneralHLTOffline::GeneralHLTOffline(const edm::ParameterSet& ps):streamA_found_
 
   hltTag = ps.getParameter<std::string> ("HltProcessName");
 
-  triggerSummaryTokenRAW = consumes <trigger::TriggerEventWithRefs> (edm::InputTag(std::string("hltTriggerSummaryRAW"), std::string(""), hltTag));
-  triggerSummaryTokenAOD = consumes <trigger::TriggerEvent> (edm::InputTag(std::string("hltTriggerSummaryAOD"), std::string(""), hltTag));
   triggerResultsToken = consumes <edm::TriggerResults>   (edm::InputTag(std::string("TriggerResults"), std::string(""), hltTag));
 
+  timing_.addScope("analyze");
+
   if (debugPrint) {
     std::cout << "Inside Constructor" << std::endl;
     std::cout << "Got plot dirname = " << plotDirectoryName << std::endl;
@@ -128,6 +141,8 @@ GeneralHLTOffline::~GeneralHLTOffline() {
 void
 GeneralHLTOffline::analyze(const edm::Event& iEvent,
                            const edm::EventSetup& iSetup) {
+  HLTDQMTiming::Scope analyzeTimer(timing_, 0, iEvent.luminosityBlock());
+
   if (debugPrint)
     std::cout << "Inside analyze - run, block, event "
               << iEvent.id().run() << " , " << iEvent.id().luminosityBlock()
@@ -146,72 +161,24 @@ GeneralHLTOffline::analyze(const edm::Event& iEvent,
   if (debugPrint)
     std::cout << "Found triggerResults" << std::endl;
 
-  edm::Handle<trigger::TriggerEventWithRefs> rawTriggerEvent;
-  iEvent.getByToken(triggerSummaryTokenRAW, rawTriggerEvent);
-
-  edm::Handle<trigger::TriggerEvent> aodTriggerEvent;
-  iEvent.getByToken(triggerSummaryTokenAOD, aodTriggerEvent);
-
-  bool hasRawTriggerEvent = true;
-  if( !rawTriggerEvent.isValid() ){
-    hasRawTriggerEvent = false;
-    if (debugPrint)
-      std::cout << "No RAW trigger summary found! Returning...";
-
-    if( !aodTriggerEvent.isValid() ){
-      if (debugPrint)
-	std::cout << "No AOD trigger summary found! Returning...";
-      return;
-    }
-  }
-
   if (streamA_found_) {
-    const std::vector<std::string> &datasetNames =  DataSetNames;
     // Loop over PDs
-    for (unsigned int iPD = 0; iPD < datasetNames.size(); iPD++) {
+    for (unsigned int iPD = 0; iPD < pathProgress_.size(); iPD++) {
       // Loop over Paths in each PD
       for (unsigned int iPath = 0;
-           iPath < PDsVectorPathsVector[iPD].size(); iPath++) {
-        std::string &pathName = PDsVectorPathsVector[iPD][iPath];
-        unsigned int index = hlt_config_.triggerIndex(pathName);
+           iPath < pathProgress_[iPD].size(); iPath++) {
+        unsigned int index = pathProgress_[iPD][iPath].triggerIndex;
 	if (debugPrint) {
-          std::cout << "Looking at path " << pathName << std::endl;
+          std::cout << "Looking at path " << PDsVectorPathsVector[iPD][iPath] << std::endl;
           std::cout << "Index = " << index
                     << " triggerResults->size() = " << triggerResults->size()
                     << std::endl;
 	}
 
-        // fill the histos with empty weights......
-        const std::string &label = datasetNames[iPD];
-        std::string fullPathToCPP = "HLT/GeneralHLTOffline/"
-            + label + "/cppath_" + label + hlt_menu_;
-        MonitorElement * ME_mini_cppath = NULL;
-        TH1F * hist_mini_cppath = NULL;
-        if( cppath_mini_.find(fullPathToCPP)!=cppath_mini_.end() ){
-	  ME_mini_cppath = cppath_mini_[fullPathToCPP];
-          hist_mini_cppath = ME_mini_cppath->getTH1F();
-	}
-
-        if (hist_mini_cppath) {
-          TAxis * axis = hist_mini_cppath->GetXaxis();
-          if (axis) {
-	    std::string pathNameNoVer = hlt_config_.removeVersion(PDsVectorPathsVector[iPD][iPath]);
-            int bin_num = axis->FindBin(pathNameNoVer.c_str());
-            int bn = bin_num - 1;
-            hist_mini_cppath->Fill(bn, 0);
-            hist_mini_cppath->SetEntries(hist_mini_cppath->Integral());
-          }
-        }
-
         if( index < triggerResults->size() ) {
-	  bool accept = triggerResults->accept(index);
-	  if( accept ) cppath_->Fill(index, 1);
-
-	  fillHltMatrix(datasetNames[iPD], pathName,
-			accept,
-			hasRawTriggerEvent,
-			rawTriggerEvent,
-			aodTriggerEvent);
+	  if( triggerResults->accept(index) ) cppath_->Fill(index, 1);
+
+	  fillHltMatrix(*triggerResults, iPD, iPath);
         }  // end if (index < triggerResults->size())
       }  // end Loop over Paths in each PD
     }  // end Loop over PDs
@@ -234,6 +201,8 @@ GeneralHLTOffline::dqmBeginRun(edm::Run const& iRun,
   AddedDatasets.clear();
   DataSetNames.clear();
   PathModules.clear();
+  hist_cppath_mini_.clear();
+  pathProgress_.clear();
 
 
   bool changed = true;
@@ -424,6 +393,8 @@ void GeneralHLTOffline::bookHistograms(DQMStore::IBooker & iBooker,
 				       edm::Run const & iRun,
 				       edm::EventSetup const & iSetup)
 {
+  timing_.beginBooking();
+
   iBooker.setCurrentFolder(plotDirectoryName) ;
 
   //////////// Book a simple ME
@@ -440,6 +411,8 @@ void GeneralHLTOffline::bookHistograms(DQMStore::IBooker & iBooker,
       setupHltMatrix(iBooker, DataSetNames[iPD], iPD);
 
   }  // if stream A or Physics streams are found
+
+  timing_.bookHistograms(iBooker);
 }  // end of bookHistograms
 
 
@@ -471,6 +444,13 @@ void GeneralHLTOffline::setupHltMatrix(DQMStore::IBooker & iBooker, const std::s
   if( cppath_mini_[dnamez] )
     hist_mini_cppath = cppath_mini_[dnamez]->getTH1F();
 
+  if( hist_cppath_mini_.size() <= (unsigned int)iPD ) {
+    hist_cppath_mini_.resize(iPD+1, NULL);
+    pathProgress_.resize(iPD+1);
+  }
+  hist_cppath_mini_[iPD] = hist_mini_cppath;
+  pathProgress_[iPD].assign(PDsVectorPathsVector[iPD].size(), PathFilterProgress());
+
   unsigned int jPath;
   for (unsigned int iPath = 0; iPath < PDsVectorPathsVector[iPD].size(); iPath++) {
     pathName = hlt_config_.removeVersion(PDsVectorPathsVector[iPD][iPath]);
@@ -484,6 +464,10 @@ void GeneralHLTOffline::setupHltMatrix(DQMStore::IBooker & iBooker, const std::s
 
     std::string pathNameVer = PDsVectorPathsVector[iPD][iPath];
 
+    PathFilterProgress & progress = pathProgress_[iPD][iPath];
+    progress.triggerIndex = hlt_config_.triggerIndex(pathNameVer);
+    progress.cppathBin = iPath;
+
     std::vector<std::string> moduleLabels = PathModules[pathNameVer];
     int NumModules = int( moduleLabels.size() );
 
@@ -497,8 +481,15 @@ void GeneralHLTOffline::setupHltMatrix(DQMStore::IBooker & iBooker, const std::s
 							  0,
 							  NumModules);
 
-    if( cpfilt_mini_[pathName_dataset] )
+    if( cpfilt_mini_[pathName_dataset] ) {
       hist_cpfilt_mini_[pathName_dataset] = cpfilt_mini_[pathName_dataset]->getTH1F();
+      progress.hist_cpfilt = hist_cpfilt_mini_[pathName_dataset];
+    }
+
+    // PathModules keeps the modules in path order, so the indices are ascending
+    progress.moduleIndices.reserve(NumModules);
+    for( int iMod=0; iMod<NumModules; iMod++ )
+      progress.moduleIndices.push_back(hlt_config_.moduleIndex(pathNameVer, moduleLabels[iMod]));
 
     for( int iMod=0; iMod<NumModules; iMod++ ){
       if( cpfilt_mini_[pathName_dataset] && hist_cpfilt_mini_[pathName_dataset] ){
@@ -518,104 +509,32 @@ void GeneralHLTOffline::setupHltMatrix(DQMStore::IBooker & iBooker, const std::s
 }  // End setupHltMatrix
 
 
-void GeneralHLTOffline::fillHltMatrix(const std::string & label,
-                                      const std::string & path,
-                                      bool accept,
-				      bool hasRawTriggerEvent,
-				      edm::Handle<trigger::TriggerEventWithRefs> triggerEventRAW,
-				      edm::Handle<trigger::TriggerEvent> triggerEventAOD) {
-  if (debugPrint)
-    std::cout << "Inside fillHltMatrix( " << label << " , "
-              << path << " ) " << std::endl;
-
-  std::string fullPathToCPP;
-
-  fullPathToCPP = "HLT/GeneralHLTOffline/" + label + "/cppath_" + label + "_" + hlt_menu_;
-  
-  std::string dnamez = "cppath_" + label + "_" + hlt_menu_;
-
-  TH1F * hist_mini_cppath = NULL;
-  MonitorElement * ME_mini_cppath = NULL;
-  if( cppath_mini_.find(dnamez)!=cppath_mini_.end() ){
-    ME_mini_cppath = cppath_mini_[dnamez];
-    hist_mini_cppath = ME_mini_cppath->getTH1F();
-  }
-
-  std::string pathNameNoVer = hlt_config_.removeVersion(path);
-
-  if( (path.find("HLT_") != std::string::npos) && 
-      !(path.find("HLT_Physics")!=std::string::npos) && 
-      !(path.find("HLT_Random")!=std::string::npos) ){
-
-    unsigned int triggerEventSize = 0;
-    if( hasRawTriggerEvent && triggerEventRAW.isValid() ) triggerEventSize = triggerEventRAW->size();
-    else if( triggerEventAOD.isValid() ) triggerEventSize = triggerEventAOD->sizeFilters();
-
-    std::string pathName_dataset = "cpfilt_" + label + "_" + pathNameNoVer;
-
-    TH1F * hist_cpfilt_mini = NULL;
-    MonitorElement * ME_cpfilt_mini = NULL;
-    if( cpfilt_mini_.find(pathName_dataset)!=cpfilt_mini_.end() ){
-      ME_cpfilt_mini = cpfilt_mini_[pathName_dataset];
-      hist_cpfilt_mini = ME_cpfilt_mini->getTH1F();
-    }
+void GeneralHLTOffline::fillHltMatrix(const edm::TriggerResults & triggerResults,
+                                      unsigned int iPD,
+                                      unsigned int iPath) {
+  const PathFilterProgress & progress = pathProgress_[iPD][iPath];
+  const unsigned int index = progress.triggerIndex;
+  const bool accept = triggerResults.accept(index);
 
-
-    std::vector<std::string> moduleLabels = PathModules[path];
-    int NumModules = int( moduleLabels.size() );
-
-    for( int iMod=0; iMod<NumModules; iMod++ ){
-      edm::InputTag moduleWhoseResultsWeWant(moduleLabels[iMod],
-					     "",
-					     hltTag);
-
-      unsigned int idx_module_trg = 0;
-      if( hasRawTriggerEvent && triggerEventRAW.isValid() ) idx_module_trg = triggerEventRAW->filterIndex(moduleWhoseResultsWeWant);
-      else if( triggerEventAOD.isValid() ) idx_module_trg = triggerEventAOD->filterIndex(moduleWhoseResultsWeWant);
-  
-      if( !(idx_module_trg < triggerEventSize) ) continue;
-      if( hist_cpfilt_mini ){
-	TAxis * axis = hist_cpfilt_mini->GetXaxis();
-	int bin_num = axis->FindBin(moduleLabels[iMod].c_str());
-	int bn = bin_num - 1;
-
-	if( bin_num!=1 && hasRawTriggerEvent ){
-	  bool passPreviousFilters = true;
-	  for( int ibin = bin_num-1; ibin>0; ibin-- ){ 
-	    std::string previousFilter(axis->GetBinLabel(ibin));
-	    edm::InputTag previousModuleWhoseResultsWeWant(previousFilter,
-							   "",
-							   hltTag);
-	    unsigned int idx_previous_module_trg = 0;
-	    if( hasRawTriggerEvent && triggerEventRAW.isValid() ) idx_previous_module_trg = triggerEventRAW->filterIndex(previousModuleWhoseResultsWeWant);
-	    else if( triggerEventAOD.isValid() ) idx_previous_module_trg = triggerEventAOD->filterIndex(previousModuleWhoseResultsWeWant);
-
-	    if( !(idx_previous_module_trg < triggerEventSize) ){
-	      passPreviousFilters = false;
-	      break;
-	    }
-	  }
-	  // Only fill if previous filters have been passed
-	  if( passPreviousFilters ) hist_cpfilt_mini->Fill(bn, 1);
-	}
-	else hist_cpfilt_mini->Fill(bn, 1);
-
-      }
+  if (debugPrint)
+    std::cout << "Inside fillHltMatrix( " << DataSetNames[iPD] << " , "
+              << PDsVectorPathsVector[iPD][iPath] << " ) " << std::endl;
+
+  // A path stops at its first failing module, which TriggerResults records
+  // as the path's last module index: every filter before it has passed,
+  // and all of them have passed if the path accepted the event.
+  if( progress.hist_cpfilt && triggerResults.wasrun(index) ){
+    const unsigned int lastModule = triggerResults.index(index);
+    const std::vector<unsigned int> & moduleIndices = progress.moduleIndices;
+    for( unsigned int bn=0; bn<moduleIndices.size(); bn++ ){
+      if( !accept && !(moduleIndices[bn] < lastModule) ) break;
+      progress.hist_cpfilt->Fill(bn, 1);
     }
   }
-  else{
-    if (debugPrint) std::cout << "No AOD trigger summary found! Returning..." << std::endl;
-  }
 
-  if( accept && hist_mini_cppath ){
-    TAxis * axis = hist_mini_cppath->GetXaxis();
-    int bin_num = axis->FindBin(pathNameNoVer.c_str());
-    int bn = bin_num - 1;
-    hist_mini_cppath->Fill(bn, 1);
-  }
-
-  if (debugPrint)
-    std::cout << "hist->Fill" << std::endl;
+  TH1F * hist_mini_cppath = hist_cppath_mini_[iPD];
+  if( accept && hist_mini_cppath )
+    hist_mini_cppath->Fill(progress.cppathBin, 1);
 }  // End fillHltMatrix
 
 void GeneralHLTOffline::beginLuminosityBlock(edm::LuminosityBlock const&,
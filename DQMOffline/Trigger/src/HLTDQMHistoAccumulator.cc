@@ -0,0 +1,103 @@
+#include "DQMOffline/Trigger/interface/HLTDQMHistoAccumulator.h"
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include "TAxis.h"
+#include "TH1.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  // upper limit on the size of the lookup table of a variable binning
+  const unsigned int kMaxCells = 4096;
+}
+
+HLTDQMHistoAccumulator::Axis::Axis():
+  nBins_(0),
+  min_(0.),
+  max_(0.),
+  cellScale_(0.)
+{}
+
+void HLTDQMHistoAccumulator::Axis::setup(const TAxis& axis) {
+  nBins_ = axis.GetNbins();
+  min_ = axis.GetXmin();
+  max_ = axis.GetXmax();
+  edges_.clear();
+  cellBins_.clear();
+  if (axis.GetXbins()->fN == 0) return;
+
+  const double* edges = axis.GetXbins()->GetArray();
+  edges_.assign(edges, edges+nBins_+1);
+  double minWidth = max_-min_;
+  for (int i = 0; i < nBins_; ++i)
+    minWidth = std::min(minWidth, edges_[i+1]-edges_[i]);
+  const unsigned int nCells = std::min<double>(kMaxCells, std::max<double>(nBins_, std::ceil((max_-min_)/minWidth)));
+  cellScale_ = nCells/(max_-min_);
+  cellBins_.resize(nCells);
+  for (unsigned int i = 0; i < nCells; ++i) {
+    const double low = min_ + i/cellScale_;
+    // the bin b covers [edges_[b-1], edges_[b])
+    const int bin = std::upper_bound(edges_.begin(), edges_.end(), low) - edges_.begin();
+    cellBins_[i] = std::max(1, std::min(bin, nBins_));
+  }
+}
+
+HLTDQMHistoAccumulator::HLTDQMHistoAccumulator():
+  me_(nullptr),
+  is2D_(false),
+  entries_(0),
+  inRange_(0),
+  sumX_(0.),
+  sumX2_(0.),
+  sumY_(0.),
+  sumY2_(0.),
+  sumXY_(0.)
+{}
+
+HLTDQMHistoAccumulator::HLTDQMHistoAccumulator(MonitorElement* me):
+  HLTDQMHistoAccumulator()
+{
+  me_ = me;
+  const TH1* histo = me_->getTH1();
+  is2D_ = histo->GetDimension() == 2;
+  xAxis_.setup(*histo->GetXaxis());
+  if (is2D_) yAxis_.setup(*histo->GetYaxis());
+  counts_.assign((xAxis_.nBins()+2)*(is2D_ ? yAxis_.nBins()+2 : 1), 0);
+}
+
+void HLTDQMHistoAccumulator::flush() {
+  if (!me_ || entries_ == 0) return;
+
+  TH1* histo = me_->getTH1();
+  // TH1::GetStats reads the statistics before the bin contents change
+  double stats[7] = {0., 0., 0., 0., 0., 0., 0.};
+  histo->GetStats(stats);
+  const double entries = histo->GetEntries();
+
+  const bool hasSumw2 = histo->GetSumw2N() > 0;
+  for (size_t bin = 0; bin < counts_.size(); ++bin) {
+    if (counts_[bin] == 0) continue;
+    histo->AddBinContent(bin, counts_[bin]);
+    if (hasSumw2) histo->GetSumw2()->fArray[bin] += counts_[bin];
+  }
+
+  // unit weights: sum of w and of w^2 are both the number of fills
+  stats[0] += inRange_;
+  stats[1] += inRange_;
+  stats[2] += sumX_;
+  stats[3] += sumX2_;
+  if (is2D_) {
+    stats[4] += sumY_;
+    stats[5] += sumY2_;
+    stats[6] += sumXY_;
+  }
+  histo->PutStats(stats);
+  histo->SetEntries(entries + entries_);
+
+  std::fill(counts_.begin(), counts_.end(), 0);
+  entries_ = 0;
+  inRange_ = 0;
+  sumX_ = sumX2_ = sumY_ = sumY2_ = sumXY_ = 0.;
+}
@@ -0,0 +1,68 @@
+#include "DQMOffline/Trigger/interface/HLTDQMTiming.h"
+
+#ifdef DQMOFFLINE_TRIGGER_TIMING
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+#include <map>
+#include <time.h>
+
+namespace {
+  // lumisection axis of the profiles, as for the other "VsLS" histograms
+  const int kNLS = 2500;
+}
+
+HLTDQMTiming::HLTDQMTiming(const edm::ParameterSet& pset):
+  folder_("HLT/Performance/" + pset.getParameter<std::string>("@module_label")),
+  bookingStart_(0.)
+{}
+
+unsigned int HLTDQMTiming::addScope(const std::string& name) {
+  scopeNames_.push_back(name);
+  scopeMEs_.push_back(nullptr);
+  return scopeNames_.size()-1;
+}
+
+void HLTDQMTiming::clearScopes() {
+  scopeNames_.clear();
+  scopeMEs_.clear();
+}
+
+void HLTDQMTiming::beginBooking() {
+  bookingStart_ = cpuTime();
+}
+
+void HLTDQMTiming::bookHistograms(DQMStore::IBooker& iBooker) {
+  const double bookingTime = cpuTime() - bookingStart_;
+
+  iBooker.setCurrentFolder(folder_);
+  std::map<std::string,MonitorElement*> booked;
+  for (size_t i = 0; i < scopeNames_.size(); ++i) {
+    MonitorElement*& me = booked[scopeNames_[i]];
+    if (!me)
+      me = iBooker.bookProfile(scopeNames_[i] + "_cpuVsLS", scopeNames_[i] + " CPU time per call;LS;CPU time [#mus]",
+                               kNLS, 0., kNLS, 0., 1e9);
+    scopeMEs_[i] = me;
+  }
+  iBooker.bookFloat("booking_cpu")->Fill(bookingTime);
+}
+
+double HLTDQMTiming::cpuTime() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec*1e6 + ts.tv_nsec*1e-3;
+}
+
+HLTDQMTiming::Scope::Scope(HLTDQMTiming& timing, unsigned int scope, unsigned int ls):
+  timing_(timing),
+  scope_(scope),
+  ls_(ls),
+  start_(HLTDQMTiming::cpuTime())
+{}
+
+HLTDQMTiming::Scope::~Scope() {
+  if (scope_ < timing_.scopeMEs_.size() && timing_.scopeMEs_[scope_])
+    timing_.scopeMEs_[scope_]->Fill(ls_, HLTDQMTiming::cpuTime() - start_);
+}
+
+#endif
@@ -0,0 +1,53 @@
+#include "DQMOffline/Trigger/interface/HLTDiJetPairKernel.h"
+
+void HLTDiJetPairKernel::clear() {
+  e_.clear();
+  px_.clear();
+  py_.clear();
+  pz_.clear();
+  pt_.clear();
+  eta_.clear();
+  phi_.clear();
+}
+
+bool HLTDiJetPairKernel::firstPair(const Cuts& cuts, unsigned int& i, unsigned int& j) const {
+  // no pair can end after the last jet passing the low pt threshold
+  unsigned int end = size();
+  while (end > 0 && pt_[end-1] < cuts.minPtLow) --end;
+  if (end < 2) return false;
+
+  rowMass2_.resize(end);
+  rowPass_.resize(end);
+  const double* e   = e_.data();
+  const double* px  = px_.data();
+  const double* py  = py_.data();
+  const double* pz  = pz_.data();
+  const double* pt  = pt_.data();
+  const double* eta = eta_.data();
+  double* mass2 = rowMass2_.data();
+  char* pass = rowPass_.data();
+
+  for (unsigned int i1 = 0; i1+1 < end; ++i1) {
+    if (pt[i1] < cuts.minPtHigh) continue;
+
+    const double e1 = e[i1], px1 = px[i1], py1 = py[i1], pz1 = pz[i1], eta1 = eta[i1];
+    for (unsigned int i2 = i1+1; i2 < end; ++i2) {
+      const double se  = e1 + e[i2];
+      const double spx = px1 + px[i2];
+      const double spy = py1 + py[i2];
+      const double spz = pz1 + pz[i2];
+      mass2[i2] = se*se - spx*spx - spy*spy - spz*spz;
+      pass[i2] = (pt[i2] >= cuts.minPtLow)
+               & !(cuts.etaOpposite & (eta1*eta[i2] > 0))
+               & (std::abs(eta1 - eta[i2]) >= cuts.minDeltaEta);
+    }
+    for (unsigned int i2 = i1+1; i2 < end; ++i2) {
+      if (pass[i2] && !(std::sqrt(mass2[i2]) < cuts.minInvMass)) {
+        i = i1;
+        j = i2;
+        return true;
+      }
+    }
+  }
+  return false;
+}
@@ -57,7 +57,10 @@ HLTElectronMatchAndPlot::HLTElectronMatchAndPlot(const ParameterSet & pset,
 //  probeD0Cut_(probeParams_.getUntrackedParameter<double>("d0Cut",0.)),
   triggerSelector_(targetParams_.getUntrackedParameter<string>("hltCuts","")),
   hasTriggerCuts_(targetParams_.exists("hltCuts")),
-  effectiveAreas_((pset.getParameter<edm::FileInPath>("effAreasConfigFile")).fullPath())
+  effectiveAreas_((pset.getParameter<edm::FileInPath>("effAreasConfigFile")).fullPath()),
+  tnpColumns_(0),
+  tnpPath_(0),
+  tnpFilter_(0)
 {
   // Create std::map<string, T> from ParameterSets. 
   fillMapFromPSet(binParams_, pset, "binParams");
@@ -105,65 +108,67 @@ void HLTElectronMatchAndPlot::beginRun(DQMStore::IBooker & iBooker,
   else 
     iBooker.setCurrentFolder(baseDir + pathSansSuffix + "/" + moduleLabel_);
   
-  // Form is book1D(name, binningType, title) where 'binningType' is used 
-  // to fetch the bin settings from binParams_.
+  // Form is book1D(name, binningType, title, accumulator) where 'binningType'
+  // is used to fetch the bin settings from binParams_, and the accumulator
+  // is the one the fills of the histogram go through.
   if (isLastFilter_){
-    book1D(iBooker, "hltPt", "pt", ";p_{T} of HLT object");
-    book1D(iBooker, "hltEta", "eta", ";#eta of HLT object");
-    book1D(iBooker, "hltPhi", "phi", ";#phi of HLT object");
-    book1D(iBooker, "resolutionEta", "resolutionEta", ";#eta^{reco}-#eta^{HLT};");
-    book1D(iBooker, "resolutionPhi", "resolutionPhi", ";#phi^{reco}-#phi^{HLT};");
+    book1D(iBooker, "hltPt", "pt", ";p_{T} of HLT object", hltPt_);
+    book1D(iBooker, "hltEta", "eta", ";#eta of HLT object", hltEta_);
+    book1D(iBooker, "hltPhi", "phi", ";#phi of HLT object", hltPhi_);
+    book1D(iBooker, "resolutionEta", "resolutionEta", ";#eta^{reco}-#eta^{HLT};", resolutionEta_);
+    book1D(iBooker, "resolutionPhi", "resolutionPhi", ";#phi^{reco}-#phi^{HLT};", resolutionPhi_);
   }
-  book1D(iBooker, "deltaR", "deltaR", ";#Deltar(reco, HLT);");
+  book1D(iBooker, "deltaR", "deltaR", ";#Deltar(reco, HLT);", deltaR_);
   
   book1D(iBooker, "resolutionPt", "resolutionRel", 
-         ";(p_{T}^{reco}-p_{T}^{HLT})/|p_{T}^{reco}|;");
+         ";(p_{T}^{reco}-p_{T}^{HLT})/|p_{T}^{reco}|;", resolutionPt_);
 
   for (size_t i = 0; i < 2; i++) {
 
     string suffix = EFFICIENCY_SUFFIXES[i];
+    EfficiencyAccumulators & efficiency = efficiency_[i];
 
-    book1D(iBooker, "efficiencyEta_" + suffix, "eta", ";#eta;");
-    book1D(iBooker, "efficiencyPhi_" + suffix, "phi", ";#phi;");
-    book1D(iBooker, "efficiencyTurnOn_" + suffix, "pt", ";p_{T};");
-    book1D(iBooker, "efficiencyVertex_" + suffix, "NVertex", ";NVertex;");
+    book1D(iBooker, "efficiencyEta_" + suffix, "eta", ";#eta;", efficiency.eta);
+    book1D(iBooker, "efficiencyPhi_" + suffix, "phi", ";#phi;", efficiency.phi);
+    book1D(iBooker, "efficiencyTurnOn_" + suffix, "pt", ";p_{T};", efficiency.turnOn);
+    book1D(iBooker, "efficiencyVertex_" + suffix, "NVertex", ";NVertex;", efficiency.vertex);
    
 
     book2D(iBooker, "efficiencyPhiVsEta_" + suffix, "etaCoarse", 
-	   "phiCoarse", ";#eta;#phi");
+	   "phiCoarse", ";#eta;#phi", efficiency.phiVsEta);
 
     if (!isLastFilter_) continue;  //this will be plotted only for the last filter
 //  book1D(iBooker, string name, string binningType, string title);     
 //    book1D(iBooker, "efficiencyD0_" + suffix, "d0", ";d0;");
 //    book1D(iBooker, "efficiencyZ0_" + suffix, "z0", ";z0;");
-    book1D(iBooker, "efficiencyCharge_" + suffix, "charge", ";charge;");
+    book1D(iBooker, "efficiencyCharge_" + suffix, "charge", ";charge;", efficiency.charge);
     
-    book1D(iBooker, "fakerateEta_" + suffix, "eta", ";#eta;");
-    book1D(iBooker, "fakerateVertex_" + suffix, "NVertex", ";NVertex;");
-    book1D(iBooker, "fakeratePhi_" + suffix, "phi", ";#phi;");
-    book1D(iBooker, "fakerateTurnOn_" + suffix, "pt", ";p_{T};");
+    book1D(iBooker, "fakerateEta_" + suffix, "eta", ";#eta;", efficiency.fakerateEta);
+    book1D(iBooker, "fakerateVertex_" + suffix, "NVertex", ";NVertex;", efficiency.fakerateVertex);
+    book1D(iBooker, "fakeratePhi_" + suffix, "phi", ";#phi;", efficiency.fakeratePhi);
+    book1D(iBooker, "fakerateTurnOn_" + suffix, "pt", ";p_{T};", efficiency.fakerateTurnOn);
     book2D(iBooker, "fakeratePhiVsEta_" + suffix, "eta", 
-	   "phi", ";#eta;#phi");
+	   "phi", ";#eta;#phi", efficiency.fakeratePhiVsEta);
     
-    book1D(iBooker, "massVsmassZ_EB_" + suffix, "zMass", ";mass");
-    book1D(iBooker, "massVsEtaZ_EB_" + suffix, "etaCoarse", ";#eta");
-    book1D(iBooker, "massVsPtZ_EB_" + suffix, "ptCoarse", ";p_{T}");
-    book1D(iBooker, "massVsVertexZ_EB_" + suffix, "NVertex", ";NVertex");
+    book1D(iBooker, "massVsmassZ_EB_" + suffix, "zMass", ";mass", tnpEB_[i].mass);
+    book1D(iBooker, "massVsEtaZ_EB_" + suffix, "etaCoarse", ";#eta", tnpEB_[i].eta);
+    book1D(iBooker, "massVsPtZ_EB_" + suffix, "ptCoarse", ";p_{T}", tnpEB_[i].pt);
+    book1D(iBooker, "massVsVertexZ_EB_" + suffix, "NVertex", ";NVertex", tnpEB_[i].vertex);
     book2D(iBooker, "massVsPhiVsEtaZ_EB_" + suffix, "etaCoarse", 
-	   "phiCoarse", ";#eta;#phi");
-    book1D(iBooker, "massVsSigmaIetaIetaZ_EB_" + suffix, "sigmaIetaIeta", ";#sigmaI#etaI#eta");
-    book1D(iBooker, "massVsHoEZ_EB_" + suffix, "HOE", ";HoE");
-    book1D(iBooker, "massVsisoPFCorrRelZ_EB_" + suffix, "isoPFCorrRel", ";isoRel");
-
-    book1D(iBooker, "massVsmassZ_EE_" + suffix, "zMass", ";mass");
-    book1D(iBooker, "massVsEtaZ_EE_" + suffix, "etaCoarse", ";#eta");
-    book1D(iBooker, "massVsPtZ_EE_" + suffix, "ptCoarse", ";p_{T}");
-    book1D(iBooker, "massVsVertexZ_EE_" + suffix, "NVertex", ";NVertex");
+	   "phiCoarse", ";#eta;#phi", tnpEB_[i].phiVsEta);
+    book1D(iBooker, "massVsSigmaIetaIetaZ_EB_" + suffix, "sigmaIetaIeta", ";#sigmaI#etaI#eta", tnpEB_[i].sigmaIetaIeta);
+    book1D(iBooker, "massVsHoEZ_EB_" + suffix, "HOE", ";HoE", tnpEB_[i].hoe);
+    book1D(iBooker, "massVsisoPFCorrRelZ_EB_" + suffix, "isoPFCorrRel", ";isoRel", tnpEB_[i].isoPFCorrRel);
+
+    book1D(iBooker, "massVsmassZ_EE_" + suffix, "zMass", ";mass", tnpEE_[i].mass);
+    book1D(iBooker, "massVsEtaZ_EE_" + suffix, "etaCoarse", ";#eta", tnpEE_[i].eta);
+    book1D(iBooker, "massVsPtZ_EE_" + suffix, "ptCoarse", ";p_{T}", tnpEE_[i].pt);
+    book1D(iBooker, "massVsVertexZ_EE_" + suffix, "NVertex", ";NVertex", tnpEE_[i].vertex);
     book2D(iBooker, "massVsPhiVsEtaZ_EE_" + suffix, "etaCoarse", 
-	   "phiCoarse", ";#eta;#phi");
-    book1D(iBooker, "massVsSigmaIetaIetaZ_EE_" + suffix, "sigmaIetaIeta", ";#sigmaI#etaI#eta");
-    book1D(iBooker, "massVsHoEZ_EE_" + suffix, "HOE", ";HoE");
-    book1D(iBooker, "massVsisoPFCorrRelZ_EE_" + suffix, "isoPFCorrRel", ";isoRel");
+	   "phiCoarse", ";#eta;#phi", tnpEE_[i].phiVsEta);
+    book1D(iBooker, "massVsSigmaIetaIetaZ_EE_" + suffix, "sigmaIetaIeta", ";#sigmaI#etaI#eta", tnpEE_[i].sigmaIetaIeta);
+    book1D(iBooker, "massVsHoEZ_EE_" + suffix, "HOE", ";HoE", tnpEE_[i].hoe);
+    book1D(iBooker, "massVsisoPFCorrRelZ_EE_" + suffix, "isoPFCorrRel", ";isoRel", tnpEE_[i].isoPFCorrRel);
     }
   
 }
@@ -178,6 +183,73 @@ void HLTElectronMatchAndPlot::endRun(const edm::Run& iRun,
 
 
 
+void HLTElectronMatchAndPlot::endLuminosityBlock()
+{
+
+  hltPt_.flush();
+  hltEta_.flush();
+  hltPhi_.flush();
+  resolutionPt_.flush();
+  resolutionEta_.flush();
+  resolutionPhi_.flush();
+  deltaR_.flush();
+  for (size_t i = 0; i < 2; i++) {
+    efficiency_[i].flush();
+    tnpEB_[i].flush();
+    tnpEE_[i].flush();
+  }
+
+}
+
+
+
+void HLTElectronMatchAndPlot::EfficiencyAccumulators::flush()
+{
+
+  eta.flush();
+  phi.flush();
+  turnOn.flush();
+  vertex.flush();
+  phiVsEta.flush();
+  charge.flush();
+  fakerateEta.flush();
+  fakeratePhi.flush();
+  fakerateTurnOn.flush();
+  fakerateVertex.flush();
+  fakeratePhiVsEta.flush();
+
+}
+
+
+
+void HLTElectronMatchAndPlot::TnPAccumulators::flush()
+{
+
+  mass.flush();
+  eta.flush();
+  pt.flush();
+  vertex.flush();
+  phiVsEta.flush();
+  sigmaIetaIeta.flush();
+  hoe.flush();
+  isoPFCorrRel.flush();
+
+}
+
+
+
+void HLTElectronMatchAndPlot::setTnPColumns(HLTElectronTnPColumns * columns,
+                                            unsigned int path, unsigned int filter)
+{
+
+  tnpColumns_ = columns;
+  tnpPath_ = path;
+  tnpFilter_ = filter;
+
+}
+
+
+
 void HLTElectronMatchAndPlot::analyze(Handle<GsfElectronCollection>   & eleHandle,
 				  Handle<double>               & rho,
 				  Handle<ConversionCollection> & convs,
@@ -260,15 +332,19 @@ void HLTElectronMatchAndPlot::analyze(Handle<GsfElectronCollection>   & eleHandl
   // Fill plots for HLT muons.
   if (isLastFilter_){
     for (size_t i = 0; i < hltElectrons.size(); i++) {
-      hists_["hltPt"]->Fill(hltElectrons[i].pt());
-      hists_["hltEta"]->Fill(hltElectrons[i].eta());
-      hists_["hltPhi"]->Fill(hltElectrons[i].phi());
+      hltPt_.fill(hltElectrons[i].pt());
+      hltEta_.fill(hltElectrons[i].eta());
+      hltPhi_.fill(hltElectrons[i].phi());
     }
   }
   // Find the best trigger object matches for the targetElectrons.
   vector<size_t> matches = matchByDeltaR(targetElectrons, hltElectrons, 
 //                                         plotCuts_[triggerLevel_ + "DeltaR"]);
                                          plotCuts_["DeltaR"]);
+  if (tnpColumns_) {
+    for (size_t i = 0; i < targetElectrons.size(); i++)
+      if (matches[i] < hltElectrons.size()) tnpColumns_->setPassed(tnpPath_, tnpFilter_, i);
+  }
 cout<<"---------  Sijing : 111111  ---------"<<endl;
   // Fill plots for matched electrons.(Tag Electron)
   int N_tag = 0;
@@ -322,14 +398,14 @@ cout<<"HOverE = "<< HOverE <<endl;
       if( (abs(eta) <= 1.442 || (abs(eta) <=1.566 && abs(eta) <= 2.1)) && electron.pt() > 30){ 
        TriggerObject & hltElectron = hltElectrons[matches[i]];
        double ptRes = (electron.pt() - hltElectron.pt()) / electron.pt();
-       hists_["resolutionPt"]->Fill(ptRes);
-       hists_["deltaR"]->Fill(deltaR(electron, hltElectron));
+       resolutionPt_.fill(ptRes);
+       deltaR_.fill(deltaR(electron, hltElectron));
       
        if (isLastFilter_){
 	double etaRes = electron.eta() - hltElectron.eta();
 	double phiRes = electron.phi() - hltElectron.phi();
-	hists_["resolutionEta"]->Fill(etaRes);
-	hists_["resolutionPhi"]->Fill(phiRes);
+	resolutionEta_.fill(etaRes);
+	resolutionPhi_.fill(phiRes);
 	N_tag++;
        }
       } 
@@ -338,7 +414,8 @@ cout<<"---------  Sijing : 333333 ---------"<<endl;
     // Fill numerators and denominator for efficiency plots.
     for (size_t j = 0; j < 2; j++) {
 
-      string suffix = EFFICIENCY_SUFFIXES[j];
+      const string & suffix = EFFICIENCY_SUFFIXES[j];
+      EfficiencyAccumulators & efficiency = efficiency_[j];
       
       // all the Probes have to be not in the gap;
       if ( abs(eta) > 1.442 && abs(eta) < 1.566) continue;
@@ -348,27 +425,27 @@ cout<<"---------  Sijing : 333333 ---------"<<endl;
       // numerator: passing probe, denominator: the probe;
       if (suffix == "numer" && matches[i] >= targetElectrons.size()) continue;
       if (electron.pt() > cutMinPt_) {
-        hists_["efficiencyEta_" + suffix]->Fill(electron.eta());
-        hists_["efficiencyPhiVsEta_" + suffix]->Fill(electron.eta(), electron.phi());
+        efficiency.eta.fill(electron.eta());
+        efficiency.phiVsEta.fill(electron.eta(), electron.phi());
       }
       
       if (fabs(electron.eta()) < plotCuts_["maxEta"]) {
-        hists_["efficiencyTurnOn_" + suffix]->Fill(electron.pt());
+        efficiency.turnOn.fill(electron.pt());
       }
       
       if (electron.pt() > cutMinPt_ && fabs(electron.eta()) < plotCuts_["maxEta"]) {
 //        const Track * track = 0;
 //        track = & * electron.gsfTrack();
 //	if (track) 
-          hists_["efficiencyVertex_" + suffix]->Fill(vertices->size());
-          hists_["efficiencyPhi_" + suffix]->Fill(electron.phi());
+          efficiency.vertex.fill(vertices->size());
+          efficiency.phi.fill(electron.phi());
 
 	  if (isLastFilter_){
 //	    double d0 = track->dxy(beamSpot->position());
 //	    double z0 = track->dz(beamSpot->position());
 //	    hists_["efficiencyD0_" + suffix]->Fill(d0);
 //	    hists_["efficiencyZ0_" + suffix]->Fill(z0);
-	    hists_["efficiencyCharge_" + suffix]->Fill(electron.charge());
+	    efficiency.charge.fill(electron.charge());
 	  }
 //	
       }
@@ -395,24 +472,39 @@ cout<<"---------  Sijing : 333333 ---------"<<endl;
 	const double isoPFCorrRel = (chad_P + std::max(0.0f, nhad_P + pho_P - Rho*eA_P)) / Pt_P;
 	if(mass > 60 && mass < 120) {
           if(electron.pt() < targetptCutZ_) continue; // pt>20
+          if (tnpColumns_) {
+            HLTElectronTnPColumns::Row row;
+            row.nVertices          = vertices->size();
+            row.mass               = mass;
+            row.tagPt              = electron.pt();
+            row.tagEta             = electron.eta();
+            row.probePt            = theProbe.pt();
+            row.probeEta           = theProbe.eta();
+            row.probePhi           = theProbe.phi();
+            row.probeSCEta         = eta_P;
+            row.probeSigmaIetaIeta = theProbe.full5x5_sigmaIetaIeta();
+            row.probeHoE           = theProbe.hadronicOverEm();
+            row.probeIsoPFCorrRel  = isoPFCorrRel;
+            tnpColumns_->fill(tnpPath_, k, row);
+          }
 	if(eta_P < 1.442){
-	  hists_["massVsmassZ_EB_denom"]->Fill(mass);
-          hists_["massVsEtaZ_EB_denom"]->Fill(theProbe.eta());
-          hists_["massVsPtZ_EB_denom"]->Fill(theProbe.pt());
-          hists_["massVsVertexZ_EB_denom"]->Fill(vertices->size());
-	  hists_["massVsPhiVsEtaZ_EB_denom"]->Fill(theProbe.eta(), theProbe.phi());
-	  hists_["massVsSigmaIetaIetaZ_EB_denom"]->Fill(theProbe.full5x5_sigmaIetaIeta());
-  	  hists_["massVsHoEZ_EB_denom"]->Fill(theProbe.hadronicOverEm());
-          hists_["massVsisoPFCorrRelZ_EB_denom"]->Fill(isoPFCorrRel);
+	  tnpEB_[0].mass.fill(mass);
+          tnpEB_[0].eta.fill(theProbe.eta());
+          tnpEB_[0].pt.fill(theProbe.pt());
+          tnpEB_[0].vertex.fill(vertices->size());
+	  tnpEB_[0].phiVsEta.fill(theProbe.eta(), theProbe.phi());
+	  tnpEB_[0].sigmaIetaIeta.fill(theProbe.full5x5_sigmaIetaIeta());
+  	  tnpEB_[0].hoe.fill(theProbe.hadronicOverEm());
+          tnpEB_[0].isoPFCorrRel.fill(isoPFCorrRel);
 	}else if( eta_P > 1.566 ){
-	  hists_["massVsmassZ_EE_denom"]->Fill(mass);
-          hists_["massVsEtaZ_EE_denom"]->Fill(theProbe.eta());
-          hists_["massVsPtZ_EE_denom"]->Fill(theProbe.pt());
-          hists_["massVsVertexZ_EE_denom"]->Fill(vertices->size());
-	  hists_["massVsPhiVsEtaZ_EE_denom"]->Fill(theProbe.eta(), theProbe.phi());
-	  hists_["massVsSigmaIetaIetaZ_EE_denom"]->Fill(theProbe.full5x5_sigmaIetaIeta());
-  	  hists_["massVsHoEZ_EE_denom"]->Fill(theProbe.hadronicOverEm());
-          hists_["massVsisoPFCorrRelZ_EE_denom"]->Fill(isoPFCorrRel);
+	  tnpEE_[0].mass.fill(mass);
+          tnpEE_[0].eta.fill(theProbe.eta());
+          tnpEE_[0].pt.fill(theProbe.pt());
+          tnpEE_[0].vertex.fill(vertices->size());
+	  tnpEE_[0].phiVsEta.fill(theProbe.eta(), theProbe.phi());
+	  tnpEE_[0].sigmaIetaIeta.fill(theProbe.full5x5_sigmaIetaIeta());
+  	  tnpEE_[0].hoe.fill(theProbe.hadronicOverEm());
+          tnpEE_[0].isoPFCorrRel.fill(isoPFCorrRel);
 	
 	}
 	  N_probe++;
@@ -420,25 +512,25 @@ cout<<"---------  Sijing : 333333 ---------"<<endl;
 	  if(matches[k] < targetElectrons.size()) {
 	    cout<<"mass 3 = "<< mass <<endl;
 	  if(eta_P < 1.442){
-	    hists_["massVsmassZ_EB_numer"]->Fill(mass);
-            hists_["massVsEtaZ_EB_numer"]->Fill(theProbe.eta());
-            hists_["massVsPtZ_EB_numer"]->Fill(theProbe.pt());
-            hists_["massVsVertexZ_EB_numer"]->Fill(vertices->size());
-
-	    hists_["massVsPhiVsEtaZ_EB_numer"]->Fill(theProbe.eta(), theProbe.phi());
-	    hists_["massVsSigmaIetaIetaZ_EB_numer"]->Fill(theProbe.full5x5_sigmaIetaIeta());
-            hists_["massVsHoEZ_EB_numer"]->Fill(theProbe.hadronicOverEm());
-	    hists_["massVsisoPFCorrRelZ_EB_numer"]->Fill(isoPFCorrRel);
+	    tnpEB_[1].mass.fill(mass);
+            tnpEB_[1].eta.fill(theProbe.eta());
+            tnpEB_[1].pt.fill(theProbe.pt());
+            tnpEB_[1].vertex.fill(vertices->size());
+
+	    tnpEB_[1].phiVsEta.fill(theProbe.eta(), theProbe.phi());
+	    tnpEB_[1].sigmaIetaIeta.fill(theProbe.full5x5_sigmaIetaIeta());
+            tnpEB_[1].hoe.fill(theProbe.hadronicOverEm());
+	    tnpEB_[1].isoPFCorrRel.fill(isoPFCorrRel);
 	  } else if(eta_P > 1.566){
-	    hists_["massVsmassZ_EE_numer"]->Fill(mass);
-            hists_["massVsEtaZ_EE_numer"]->Fill(theProbe.eta());
-            hists_["massVsPtZ_EE_numer"]->Fill(theProbe.pt());
-            hists_["massVsVertexZ_EE_numer"]->Fill(vertices->size());
-
-	    hists_["massVsPhiVsEtaZ_EE_numer"]->Fill(theProbe.eta(), theProbe.phi());
-	    hists_["massVsSigmaIetaIetaZ_EE_numer"]->Fill(theProbe.full5x5_sigmaIetaIeta());
-            hists_["massVsHoEZ_EE_numer"]->Fill(theProbe.hadronicOverEm());
-	    hists_["massVsisoPFCorrRelZ_EE_numer"]->Fill(isoPFCorrRel);
+	    tnpEE_[1].mass.fill(mass);
+            tnpEE_[1].eta.fill(theProbe.eta());
+            tnpEE_[1].pt.fill(theProbe.pt());
+            tnpEE_[1].vertex.fill(vertices->size());
+
+	    tnpEE_[1].phiVsEta.fill(theProbe.eta(), theProbe.phi());
+	    tnpEE_[1].sigmaIetaIeta.fill(theProbe.full5x5_sigmaIetaIeta());
+            tnpEE_[1].hoe.fill(theProbe.hadronicOverEm());
+	    tnpEE_[1].isoPFCorrRel.fill(isoPFCorrRel);
 	  
 	  }
 	    //	    if( suffix == "numer") N_passingprobe++;
@@ -466,14 +558,15 @@ cout<<"---------  Sijing : cout END---------"<<endl;
     for (size_t j = 0; j < 2; j++) {
 
       // defination: Line 6 file(line 55)
-      string suffix = EFFICIENCY_SUFFIXES[j]; 
+      const string & suffix = EFFICIENCY_SUFFIXES[j]; 
+      EfficiencyAccumulators & efficiency = efficiency_[j];
       // If match is found, then numerator plots should not get filled
       if (suffix == "numer" && ! isFake) continue;
-      hists_["fakerateVertex_" + suffix]->Fill(vertices->size());
-      hists_["fakerateEta_" + suffix]->Fill(hltElectron.eta());
-      hists_["fakeratePhi_" + suffix]->Fill(hltElectron.phi());
-      hists_["fakerateTurnOn_" + suffix]->Fill(hltElectron.pt());
-      hists_["fakeratePhiVsEta_" + suffix]->Fill(hltElectron.eta(), hltElectron.phi());
+      efficiency.fakerateVertex.fill(vertices->size());
+      efficiency.fakerateEta.fill(hltElectron.eta());
+      efficiency.fakeratePhi.fill(hltElectron.phi());
+      efficiency.fakerateTurnOn.fill(hltElectron.pt());
+      efficiency.fakeratePhiVsEta.fill(hltElectron.eta(), hltElectron.phi());
     } // End loop over numerator and denominator.
   } // End loop over hltElectrons.
   
@@ -668,7 +761,8 @@ bool HLTElectronMatchAndPlot::isoCut()
 
 
 void HLTElectronMatchAndPlot::book1D(DQMStore::IBooker & iBooker, string name, 
-				 string binningType, string title)
+				 string binningType, string title,
+				 HLTDQMHistoAccumulator & accumulator)
 {
 
   /* Properly delete the array of floats that has been allocated on
@@ -686,6 +780,7 @@ void HLTElectronMatchAndPlot::book1D(DQMStore::IBooker & iBooker, string name,
   if (hists_[name])
     if (hists_[name]->getTH1F()->GetSumw2N())
       hists_[name]->getTH1F()->Sumw2();
+  accumulator = hists_[name] ? HLTDQMHistoAccumulator(hists_[name]) : HLTDQMHistoAccumulator();
 
   if (edges)
     delete [] edges;
@@ -697,7 +792,7 @@ void HLTElectronMatchAndPlot::book1D(DQMStore::IBooker & iBooker, string name,
 void
 HLTElectronMatchAndPlot::book2D(DQMStore::IBooker & iBooker, string name, 
 			    string binningTypeX, string binningTypeY, 
-			    string title) 
+			    string title, HLTDQMHistoAccumulator & accumulator) 
 {
   
   /* Properly delete the arrays of floats that have been allocated on
@@ -720,6 +815,7 @@ HLTElectronMatchAndPlot::book2D(DQMStore::IBooker & iBooker, string name,
   if (hists_[name])
     if (hists_[name]->getTH2F()->GetSumw2N())
       hists_[name]->getTH2F()->Sumw2();
+  accumulator = hists_[name] ? HLTDQMHistoAccumulator(hists_[name]) : HLTDQMHistoAccumulator();
 
   if (edgesX)
     delete [] edgesX;
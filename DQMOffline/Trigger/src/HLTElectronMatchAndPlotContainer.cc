@@ -18,7 +18,8 @@ using namespace trigger;
 ///Container Class Members (this is what is used by the DQM module) //////////
 
 /// Constructor
-HLTElectronMatchAndPlotContainer::HLTElectronMatchAndPlotContainer(ConsumesCollector && iC, const ParameterSet & pset) 
+HLTElectronMatchAndPlotContainer::HLTElectronMatchAndPlotContainer(ConsumesCollector && iC, const ParameterSet & pset) :
+  timing_(pset)
 {
 
   plotters_.clear();
@@ -41,6 +42,13 @@ HLTElectronMatchAndPlotContainer::HLTElectronMatchAndPlotContainer(ConsumesColle
   eleToken_ = iC.mayConsume<reco::GsfElectronCollection>(inputTags.getParameter<InputTag>("electrons"));
   pvToken_   = iC.consumes<VertexCollection>(inputTags.getParameter<InputTag>("offlinePVs"));
 
+  timing_.addScope("analyze");
+
+  const string tnpColumnsFile = pset.getUntrackedParameter<string>("tnpColumnsFile", "");
+  if (!tnpColumnsFile.empty())
+    tnpColumns_.reset(new HLTElectronTnPColumns(tnpColumnsFile,
+                                                pset.getUntrackedParameter<unsigned int>("tnpColumnsBatchSize", 4096)));
+
 }
 
 
@@ -51,6 +59,23 @@ void HLTElectronMatchAndPlotContainer::addPlotter(const edm::ParameterSet &pset
 {
 
   plotters_.push_back(HLTElectronMatchAndPlot(pset,path,label,islastfilter));
+  timing_.addScope(path + "_" + label);
+
+  if (tnpColumns_) {
+    if (path != tnpPathName_) {
+      tnpPathName_ = path;
+      tnpFilters_.clear();
+    }
+    tnpFilters_.push_back(label);
+    // the plotters of the filters of the path are the last ones added
+    if (islastfilter) {
+      const unsigned int tnpPath = tnpColumns_->addPath(path, tnpFilters_);
+      const size_t first = plotters_.size() - tnpFilters_.size();
+      for (size_t i = 0; i < tnpFilters_.size(); ++i)
+        plotters_[first + i].setTnPColumns(tnpColumns_.get(), tnpPath, i);
+      tnpPathName_.clear();
+    }
+  }
 
 }
 
@@ -60,6 +85,8 @@ void HLTElectronMatchAndPlotContainer::beginRun(DQMStore::IBooker & iBooker,
 					    const edm::EventSetup & iSetup)
 {
 
+  timing_.beginBooking();
+
   vector<HLTElectronMatchAndPlot>::iterator iter = plotters_.begin();
   vector<HLTElectronMatchAndPlot>::iterator end  = plotters_.end();
 
@@ -68,6 +95,8 @@ void HLTElectronMatchAndPlotContainer::beginRun(DQMStore::IBooker & iBooker,
       iter->beginRun(iBooker, iRun, iSetup);
     }
 
+  timing_.bookHistograms(iBooker);
+
 }
 
 
@@ -86,10 +115,24 @@ void HLTElectronMatchAndPlotContainer::endRun(const edm::Run & iRun,
 }
 
 
+void HLTElectronMatchAndPlotContainer::endLuminosityBlock(const edm::LuminosityBlock & iLumi, 
+						      const edm::EventSetup & iSetup)
+{
+
+  for (size_t i = 0; i < plotters_.size(); ++i) 
+    {
+      plotters_[i].endLuminosityBlock();
+    }
+  
+}
+
+
 void HLTElectronMatchAndPlotContainer::analyze(const edm::Event & iEvent, 
 					   const edm::EventSetup & iSetup)
 {  
 
+  HLTDQMTiming::Scope analyzeTimer(timing_, 0, iEvent.luminosityBlock());
+
   // Get objects from the event.  
   Handle<TriggerEvent> triggerSummary;
   iEvent.getByToken(trigSummaryToken_, triggerSummary);
@@ -157,12 +200,12 @@ void HLTElectronMatchAndPlotContainer::analyze(const edm::Event & iEvent,
   }
   
 
-  vector<HLTElectronMatchAndPlot>::iterator iter = plotters_.begin();
-  vector<HLTElectronMatchAndPlot>::iterator end  = plotters_.end();
+  if (tnpColumns_) tnpColumns_->beginEvent(iEvent.id());
 
-  for (; iter != end; ++iter) 
+  for (size_t i = 0; i < plotters_.size(); ++i) 
     {
-      iter->analyze(eleHandle, rho, convs, beamSpot, vertices, triggerSummary, triggerResults);
+      HLTDQMTiming::Scope plotterTimer(timing_, i+1, iEvent.luminosityBlock());
+      plotters_[i].analyze(eleHandle, rho, convs, beamSpot, vertices, triggerSummary, triggerResults);
     }
   
 }
@@ -14,6 +14,7 @@
 // system include files
 #include <memory>
 #include <iostream>
+#include <algorithm>
 
 // user include files
 #include "DQMOffline/Trigger/interface/HLTElectronMatchAndPlotContainer.h"
@@ -23,20 +24,21 @@
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "DQMServices/Core/interface/DQMEDAnalyzer.h"
 #include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
-#include "CommonTools/TriggerUtils/interface/GenericTriggerEventFlag.h"
+#include "DQMOffline/Trigger/interface/HLTDQMTriggerGate.h"
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
+#include "DataFormats/Common/interface/TriggerResults.h"
 
 
 #include "TFile.h"
 #include "TDirectory.h"
 #include "TPRegexp.h"
 
-class GenericTriggerEventFlag;
 //////////////////////////////////////////////////////////////////////////////
 //////// Define the interface ////////////////////////////////////////////////
 
@@ -55,19 +57,44 @@ private:
   virtual void dqmBeginRun(const edm::Run &, const edm::EventSetup &) override;
   virtual void bookHistograms(DQMStore::IBooker &, edm::Run const &, edm::EventSetup const &) override;  
   virtual void analyze(const edm::Event &, const edm::EventSetup &) override;
+  virtual void endLuminosityBlock(const edm::LuminosityBlock &, const edm::EventSetup &) override;
   virtual void endRun(const edm::Run &, const edm::EventSetup &) override;
   virtual void endJob();
 
   // Extra Methods
   std::vector<std::string> moduleLabels(std::string);
+  void fillFilterPass(const edm::TriggerResults &);
+
+  // Per-path filter progress: the position inside the HLT path of each
+  // monitored filter, so that the filters reached and passed in an event
+  // follow from TriggerResults::index() alone.
+  struct PathFilterPass {
+    PathFilterPass(): triggerIndex(0), offset(0), reachedVsLS(0), passedVsLS(0) {}
+    std::string path;
+    unsigned int triggerIndex;
+    std::vector<std::string> labels;
+    std::vector<unsigned int> moduleIndices;
+    // position of the path's first filter in lsReached_ and lsPassed_
+    unsigned int offset;
+    MonitorElement * reachedVsLS;
+    MonitorElement * passedVsLS;
+  };
 
   // Input from Configuration File
   edm::ParameterSet pset_;
   std::string hltProcessName_;
   std::vector<std::string> hltPathsToCheck_;
 
+  // per lumisection filter counts, only with filterPassVsLS
+  bool filterPassVsLS_;
+  edm::EDGetTokenT<edm::TriggerResults> trigResultsToken_;
+  std::vector<PathFilterPass> filterPass_;
+  std::vector<unsigned int> lsReached_;
+  std::vector<unsigned int> lsPassed_;
+
   //generic trigger event flag for selecting events based on DCS flag (it can be used for selection based on L1 and HLT trigger results as well...)
-  GenericTriggerEventFlag* genTriggerEventFlagDCS_;
+  //the DCS decision is taken once per lumisection
+  HLTDQMTriggerGate* genTriggerEventFlagDCS_;
 
   // Member Variables
   HLTElectronMatchAndPlotContainer plotterContainer_;
@@ -96,10 +123,16 @@ HLTElectronOfflineAnalyzer::HLTElectronOfflineAnalyzer(const ParameterSet& pset)
   pset_(pset),
   hltProcessName_(pset.getParameter<string>("hltProcessName")),
   hltPathsToCheck_(pset.getParameter<vstring>("hltPathsToCheck")),
-  genTriggerEventFlagDCS_( new GenericTriggerEventFlag(pset.getParameter<edm::ParameterSet>("genericTriggerEventDCSPSet"), consumesCollector(), *this)),
+  filterPassVsLS_(pset.getUntrackedParameter<bool>("filterPassVsLS", false)),
+  genTriggerEventFlagDCS_( new HLTDQMTriggerGate(pset.getParameter<edm::ParameterSet>("genericTriggerEventDCSPSet"), consumesCollector(), *this)),
   plotterContainer_(consumesCollector(),pset)
 {
 
+  if (filterPassVsLS_) {
+    InputTag resTag = pset.getParameter<ParameterSet>("inputTags").getParameter<InputTag>("triggerResults");
+    trigResultsToken_ = consumes<TriggerResults>(InputTag(resTag.label(), resTag.instance(), hltProcessName_));
+  }
+
 }
 
 HLTElectronOfflineAnalyzer::~HLTElectronOfflineAnalyzer()
@@ -142,6 +175,8 @@ HLTElectronOfflineAnalyzer::dqmBeginRun(const edm::Run & iRun,
 				    const edm::EventSetup & iSetup) 
 {
 
+  filterPass_.clear();
+
   // Initialize hltConfig
   bool changedConfig;
   if (!hltConfig_.init(iRun, iSetup, hltProcessName_, changedConfig)) {
@@ -169,8 +204,23 @@ HLTElectronOfflineAnalyzer::dqmBeginRun(const edm::Run & iRun,
       if (*ilabel == labels.back()) isLastLabel = true;
       plotterContainer_.addPlotter(pset_, path, *ilabel,isLastLabel);
     }
+
+    if (filterPassVsLS_ && !labels.empty()) {
+      PathFilterPass pass;
+      pass.path = path;
+      pass.triggerIndex = hltConfig_.triggerIndex(path);
+      pass.labels = labels;
+      for (ilabel = labels.begin(); ilabel != labels.end(); ilabel++)
+        pass.moduleIndices.push_back(hltConfig_.moduleIndex(path, *ilabel));
+      pass.offset = filterPass_.empty() ? 0 : filterPass_.back().offset + filterPass_.back().labels.size();
+      filterPass_.push_back(pass);
+    }
   }
 
+  const unsigned int nFilters = filterPass_.empty() ? 0 : filterPass_.back().offset + filterPass_.back().labels.size();
+  lsReached_.assign(nFilters, 0);
+  lsPassed_.assign(nFilters, 0);
+
 }
 
 
@@ -183,6 +233,26 @@ HLTElectronOfflineAnalyzer::bookHistograms(DQMStore::IBooker & iBooker,
   if ( genTriggerEventFlagDCS_ && genTriggerEventFlagDCS_->on() ) genTriggerEventFlagDCS_->initRun(iRun, iSetup);
   plotterContainer_.beginRun(iBooker, iRun, iSetup);
 
+  // events reaching and passing each filter of the paths, per lumisection
+  if (filterPass_.empty()) return;
+  string baseDir = pset_.getParameter<string>("FolderName");
+  if (baseDir[baseDir.size() - 1] != '/') baseDir += '/';
+  iBooker.setCurrentFolder(baseDir + "FilterPassVsLS");
+  const int nLS = 2500;
+  for (size_t i = 0; i < filterPass_.size(); i++) {
+    PathFilterPass & pass = filterPass_[i];
+    const string path = HLTConfigProvider::removeVersion(pass.path);
+    const int nFilters = pass.labels.size();
+    pass.reachedVsLS = iBooker.book2D(path + "_filterReachedVsLS", "Events reaching each filter of " + path + ";LS;",
+                                      nLS, 0., nLS, nFilters, 0., nFilters);
+    pass.passedVsLS  = iBooker.book2D(path + "_filterPassedVsLS", "Events passing each filter of " + path + ";LS;",
+                                      nLS, 0., nLS, nFilters, 0., nFilters);
+    for (int j = 0; j < nFilters; j++) {
+      pass.reachedVsLS->setBinLabel(j + 1, pass.labels[j], 2);
+      pass.passedVsLS->setBinLabel(j + 1, pass.labels[j], 2);
+    }
+  }
+
 }
 
 
@@ -191,6 +261,16 @@ void
 HLTElectronOfflineAnalyzer::analyze(const Event& iEvent, 
 				const EventSetup& iSetup)
 {
+  // the filter counters describe the trigger, so they see every event,
+  // independently of the DCS selection of the plots
+  if (!filterPass_.empty()) {
+    Handle<TriggerResults> triggerResults;
+    iEvent.getByToken(trigResultsToken_, triggerResults);
+    // the indices are those of the HLTConfigProvider menu
+    if (triggerResults.isValid() && triggerResults->size() == hltConfig_.size())
+      fillFilterPass(*triggerResults);
+  }
+
   // Filter out events if Trigger Filtering is requested
   if (genTriggerEventFlagDCS_->on() && genTriggerEventFlagDCS_->accept(iEvent, iSetup) ) return;
   plotterContainer_.analyze(iEvent, iSetup);
@@ -199,6 +279,54 @@ HLTElectronOfflineAnalyzer::analyze(const Event& iEvent,
 
 
 
+void
+HLTElectronOfflineAnalyzer::fillFilterPass(const TriggerResults & triggerResults)
+{
+  // A path stops at its first failing module, which TriggerResults records
+  // as the path's last module index: the filters before it have passed, and
+  // all of them have passed if the path accepted the event.
+  for (size_t i = 0; i < filterPass_.size(); i++) {
+    const PathFilterPass & pass = filterPass_[i];
+    if (!triggerResults.wasrun(pass.triggerIndex)) continue;
+    const bool accept = triggerResults.accept(pass.triggerIndex);
+    const unsigned int lastModule = triggerResults.index(pass.triggerIndex);
+    for (size_t j = 0; j < pass.moduleIndices.size(); j++) {
+      const unsigned int module = pass.moduleIndices[j];
+      if (!accept && module > lastModule) break;
+      ++lsReached_[pass.offset + j];
+      if (accept || module < lastModule) ++lsPassed_[pass.offset + j];
+    }
+  }
+
+}
+
+
+
+void
+HLTElectronOfflineAnalyzer::endLuminosityBlock(const LuminosityBlock& iLumi,
+				       const EventSetup& iSetup)
+{
+  // the plotters buffer their histogram fills until here
+  plotterContainer_.endLuminosityBlock(iLumi, iSetup);
+
+  // one fill per filter and lumisection, weighted by the event count
+  const double ls = iLumi.id().luminosityBlock();
+  for (size_t i = 0; i < filterPass_.size(); i++) {
+    const PathFilterPass & pass = filterPass_[i];
+    for (size_t j = 0; j < pass.labels.size(); j++) {
+      const unsigned int reached = lsReached_[pass.offset + j];
+      const unsigned int passed  = lsPassed_[pass.offset + j];
+      if (reached && pass.reachedVsLS) pass.reachedVsLS->Fill(ls, j, reached);
+      if (passed && pass.passedVsLS) pass.passedVsLS->Fill(ls, j, passed);
+    }
+  }
+  std::fill(lsReached_.begin(), lsReached_.end(), 0);
+  std::fill(lsPassed_.begin(), lsPassed_.end(), 0);
+
+}
+
+
+
 void 
 HLTElectronOfflineAnalyzer::beginJob()
 {
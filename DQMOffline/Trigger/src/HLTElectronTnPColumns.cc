@@ -0,0 +1,144 @@
+#include "DQMOffline/Trigger/interface/HLTElectronTnPColumns.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TList.h"
+#include "TObjString.h"
+#include "TTree.h"
+
+#include <map>
+#include <mutex>
+
+// the file and its trees, shared by the stream copies of the modules writing it
+class HLTElectronTnPColumns::Writer {
+public:
+  explicit Writer(const std::string& fileName):
+    file_(nullptr)
+  {
+    // opening the file makes it the current directory, restore the previous one
+    TDirectory::TContext context;
+    file_ = TFile::Open(fileName.c_str(), "RECREATE");
+    if (!file_ || file_->IsZombie())
+      throw cms::Exception("HLTElectronTnPColumns") << "cannot create " << fileName;
+  }
+
+  ~Writer() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    file_->Write();
+    file_->Close();
+    delete file_;
+  }
+
+  // the tree of the path, created on first use
+  void addPath(const std::string& path, const std::vector<std::string>& filters) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (trees_.count(path)) return;
+
+    // the tree is created in the current directory
+    TDirectory::TContext context(file_);
+    TTree* tree = new TTree(path.c_str(), ("HLT electron tag and probe pairs of " + path).c_str());
+    tree->Branch("run",                &row_.run,                "run/i");
+    tree->Branch("lumi",               &row_.lumi,               "lumi/i");
+    tree->Branch("event",              &row_.event,              "event/l");
+    tree->Branch("filterBits",         &row_.filterBits,         "filterBits/i");
+    tree->Branch("nVertices",          &row_.nVertices,          "nVertices/i");
+    tree->Branch("mass",               &row_.mass,               "mass/F");
+    tree->Branch("tagPt",              &row_.tagPt,              "tagPt/F");
+    tree->Branch("tagEta",             &row_.tagEta,             "tagEta/F");
+    tree->Branch("probePt",            &row_.probePt,            "probePt/F");
+    tree->Branch("probeEta",           &row_.probeEta,           "probeEta/F");
+    tree->Branch("probePhi",           &row_.probePhi,           "probePhi/F");
+    tree->Branch("probeSCEta",         &row_.probeSCEta,         "probeSCEta/F");
+    tree->Branch("probeSigmaIetaIeta", &row_.probeSigmaIetaIeta, "probeSigmaIetaIeta/F");
+    tree->Branch("probeHoE",           &row_.probeHoE,           "probeHoE/F");
+    tree->Branch("probeIsoPFCorrRel",  &row_.probeIsoPFCorrRel,  "probeIsoPFCorrRel/F");
+    for (size_t i = 0; i < filters.size(); ++i)
+      tree->GetUserInfo()->Add(new TObjString(filters[i].c_str()));
+    trees_[path] = tree;
+  }
+
+  void write(const std::string& path, const std::vector<Row>& rows) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    TTree* tree = trees_[path];
+    for (size_t i = 0; i < rows.size(); ++i) {
+      row_ = rows[i];
+      tree->Fill();
+    }
+  }
+
+  static std::shared_ptr<Writer> get(const std::string& fileName) {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<Writer> > writers;
+
+    std::lock_guard<std::mutex> guard(mutex);
+    std::shared_ptr<Writer> writer = writers[fileName].lock();
+    if (!writer) {
+      writer = std::make_shared<Writer>(fileName);
+      writers[fileName] = writer;
+    }
+    return writer;
+  }
+
+private:
+  std::mutex mutex_;
+  TFile* file_;
+  // owned by file_
+  std::map<std::string, TTree*> trees_;
+  // the branch buffer of all the trees
+  Row row_;
+};
+
+HLTElectronTnPColumns::HLTElectronTnPColumns(const std::string& fileName, unsigned int batchSize):
+  writer_(Writer::get(fileName)),
+  batchSize_(batchSize > 0 ? batchSize : 1),
+  nRows_(0)
+{}
+
+HLTElectronTnPColumns::~HLTElectronTnPColumns() {
+  flush();
+}
+
+unsigned int HLTElectronTnPColumns::addPath(const std::string& path, const std::vector<std::string>& filters) {
+  for (size_t i = 0; i < paths_.size(); ++i)
+    if (paths_[i] == path) return i;
+
+  writer_->addPath(path, filters);
+  paths_.push_back(path);
+  electronBits_.push_back(std::vector<unsigned int>());
+  rows_.push_back(std::vector<Row>());
+  return paths_.size()-1;
+}
+
+void HLTElectronTnPColumns::beginEvent(const edm::EventID& id) {
+  eventID_ = id;
+  for (size_t i = 0; i < electronBits_.size(); ++i)
+    electronBits_[i].clear();
+}
+
+void HLTElectronTnPColumns::setPassed(unsigned int path, unsigned int filter, unsigned int electron) {
+  if (filter >= 32) return;
+  std::vector<unsigned int>& bits = electronBits_[path];
+  if (bits.size() <= electron) bits.resize(electron+1, 0);
+  bits[electron] |= 1u << filter;
+}
+
+void HLTElectronTnPColumns::fill(unsigned int path, unsigned int probe, Row& row) {
+  const std::vector<unsigned int>& bits = electronBits_[path];
+  row.run        = eventID_.run();
+  row.lumi       = eventID_.luminosityBlock();
+  row.event      = eventID_.event();
+  row.filterBits = probe < bits.size() ? bits[probe] : 0;
+  rows_[path].push_back(row);
+  if (++nRows_ >= batchSize_) flush();
+}
+
+void HLTElectronTnPColumns::flush() {
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    if (rows_[i].empty()) continue;
+    writer_->write(paths_[i], rows_[i]);
+    rows_[i].clear();
+  }
+  nRows_ = 0;
+}
@@ -74,6 +74,12 @@ HLTInclusiveVBFSource::HLTInclusiveVBFSource(const edm::ParameterSet& iConfig)
   minInvMass_          = iConfig.getUntrackedParameter<double>("minInvMass",1000.0);
   etaOpposite_         = iConfig.getUntrackedParameter<bool>("etaOpposite",true);
 
+  recoCuts_.minPtHigh   = minPtHigh_;
+  recoCuts_.minPtLow    = minPtLow_;
+  recoCuts_.minDeltaEta = minDeltaEta_;
+  recoCuts_.minInvMass  = minInvMass_;
+  recoCuts_.etaOpposite = etaOpposite_;
+
   check_mjj650_Pt35_DEta3p5 = false;
   check_mjj700_Pt35_DEta3p5 = false;
   check_mjj750_Pt35_DEta3p5 = false;
@@ -161,41 +167,25 @@ HLTInclusiveVBFSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
   filtername = "dummy";
   
   //
-  reco_ejet1                = 0.; 
   //reco_etjet1               = 0.;
-  reco_pxjet1               = 0.;
-  reco_pyjet1               = 0.;
-  reco_pzjet1               = 0.;
   reco_ptjet1               = 0.;
   reco_etajet1              = 0.;
   reco_phijet1              = 0.;
   
   //
-  reco_ejet2                = 0.;
   //reco_etjet2               = 0.;
-  reco_pxjet2               = 0.;
-  reco_pyjet2               = 0.;
-  reco_pzjet2               = 0.;
   reco_ptjet2               = 0.;
   reco_etajet2              = 0.;
   reco_phijet2              = 0.;
   
   //
-  hlt_ejet1                 = 0.;
   //hlt_etjet1                = 0.;
-  hlt_pxjet1                = 0.;
-  hlt_pyjet1                = 0.;
-  hlt_pzjet1                = 0.;
   hlt_ptjet1                = 0.;
   hlt_etajet1               = 0.;
   hlt_phijet1               = 0.;
   
   //
-  hlt_ejet2                 = 0.;
   //hlt_etjet2                = 0.;
-  hlt_pxjet2                = 0.;
-  hlt_pyjet2                = 0.;
-  hlt_pzjet2                = 0.;
   hlt_ptjet2                = 0.;
   hlt_etajet2               = 0.;
   hlt_phijet2               = 0.;
@@ -228,56 +218,34 @@ HLTInclusiveVBFSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
   //****************************************************
   //
   checkOffline  = false;
-  for(unsigned int ijet1=0; ijet1<jets.size(); ijet1++){
-    if(jets[ijet1].neutralHadronEnergyFraction()>0.99) continue;
-    if(jets[ijet1].neutralEmEnergyFraction()>0.99) continue;
-    for(unsigned int ijet2=ijet1+1; ijet2<jets.size(); ijet2++){ 
-      if(jets[ijet2].neutralHadronEnergyFraction()>0.99) continue;
-      if(jets[ijet2].neutralEmEnergyFraction()>0.99) continue;
-      //
-      reco_ejet1   = jets[ijet1].energy();
-      //reco_etjet1  = jets[ijet1].et();
-      reco_pxjet1  = jets[ijet1].momentum().X();
-      reco_pyjet1  = jets[ijet1].momentum().Y();
-      reco_pzjet1  = jets[ijet1].momentum().Z();
-      reco_ptjet1  = jets[ijet1].pt();
-      reco_etajet1 = jets[ijet1].eta();
-      reco_phijet1 = jets[ijet1].phi(); 
-      //
-      reco_ejet2   = jets[ijet2].energy();
-      //reco_etjet2  = jets[ijet2].et();
-      reco_pxjet2  = jets[ijet2].momentum().X();
-      reco_pyjet2  = jets[ijet2].momentum().Y();
-      reco_pzjet2  = jets[ijet2].momentum().Z();
-      reco_ptjet2  = jets[ijet2].pt();
-      reco_etajet2 = jets[ijet2].eta();
-      reco_phijet2 = jets[ijet2].phi();
-      //
-      reco_deltaetajet  = reco_etajet1 - reco_etajet2;
-      reco_deltaphijet  = reco::deltaPhi(reco_phijet1,reco_phijet2);
-      reco_invmassjet   = sqrt((reco_ejet1  + reco_ejet2)  * (reco_ejet1  + reco_ejet2)  - 
-			       (reco_pxjet1 + reco_pxjet2) * (reco_pxjet1 + reco_pxjet2) - 
-			       (reco_pyjet1 + reco_pyjet2) * (reco_pyjet1 + reco_pyjet2) - 
-			       (reco_pzjet1 + reco_pzjet2) * (reco_pzjet1 + reco_pzjet2));
-      
-      //
-      if(reco_ptjet1 < minPtHigh_) continue; 
-      if(reco_ptjet2 < minPtLow_) continue;
-      if(etaOpposite_ == true && reco_etajet1*reco_etajet2 > 0) continue;
-      if(std::abs(reco_deltaetajet) < minDeltaEta_) continue;
-      if(std::abs(reco_invmassjet)  < minInvMass_)  continue;
-      
-      //
-      if(debug_) cout<<"DEBUG-3"<<endl;
-      checkOffline  = true;
-      break;
-    }
-    if(checkOffline == true) break;
+  recoJets_.clear();
+  for(unsigned int ijet=0; ijet<jets.size(); ijet++){
+    if(jets[ijet].neutralHadronEnergyFraction()>0.99) continue;
+    if(jets[ijet].neutralEmEnergyFraction()>0.99) continue;
+    recoJets_.push_back(jets[ijet]);
+  }
+  unsigned int ijet1 = 0, ijet2 = 0;
+  if(recoJets_.firstPair(recoCuts_,ijet1,ijet2)){
+    reco_ptjet1  = recoJets_.pt(ijet1);
+    reco_etajet1 = recoJets_.eta(ijet1);
+    reco_phijet1 = recoJets_.phi(ijet1); 
+    //
+    reco_ptjet2  = recoJets_.pt(ijet2);
+    reco_etajet2 = recoJets_.eta(ijet2);
+    reco_phijet2 = recoJets_.phi(ijet2);
+    //
+    reco_deltaetajet  = recoJets_.deltaEta(ijet1,ijet2);
+    reco_deltaphijet  = recoJets_.deltaPhi(ijet1,ijet2);
+    reco_invmassjet   = recoJets_.invMass(ijet1,ijet2);
+    //
+    if(debug_) cout<<"DEBUG-3"<<endl;
+    checkOffline  = true;
   }
   if(checkOffline == false) return;
   
   //****************************************************
-  // Trigger efficiency: Loop for all VBF paths
+  // Trigger efficiency and rate approximation: 
+  // Loop for all VBF paths
   //****************************************************
   //const unsigned int numberOfPaths(hltConfig_.size()); 
   const trigger::TriggerObjectCollection & toc(triggerObj_->getObjects()); 
@@ -306,29 +274,18 @@ HLTInclusiveVBFSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
     if(hltIndex >= triggerObj_->sizeFilters()) continue;
     checkHLT = true;
     if(debug_) cout<<"DEBUG-4-2: HLT module "<<v->getLabel()<<" exists"<<endl;
+    // the filter stores its jets as consecutive pairs
     const trigger::Keys & khlt = triggerObj_->filterKeys(hltIndex);
-    trigger::Keys::const_iterator kj = khlt.begin();
-    for(; kj != khlt.end(); kj+=2){
+    hltJets_.clear();
+    for(trigger::Keys::const_iterator kj = khlt.begin(); kj != khlt.end(); ++kj) hltJets_.push_back(toc[*kj]);
+    for(unsigned int ihlt = 0; ihlt+1 < hltJets_.size(); ihlt+=2){
       if(debug_) cout<<"DEBUG-5"<<endl;
       checkdR_sameOrder  = false;
       checkdR_crossOrder = false;	    //
-      hlt_ejet1   = toc[*kj].energy();
-      //hlt_etjet1  = toc[*kj].et();
-      hlt_pxjet1  = toc[*kj].px();
-      hlt_pyjet1  = toc[*kj].py();
-      hlt_pzjet1  = toc[*kj].pz();
-      hlt_ptjet1  = toc[*kj].pt();
-      hlt_etajet1 = toc[*kj].eta();
-      hlt_phijet1 = toc[*kj].phi();  
-      //
-      hlt_ejet2   = toc[*(kj+1)].energy();
-      //hlt_etjet2  = toc[*(kj+1)].et();
-      hlt_pxjet2  = toc[*(kj+1)].px();
-      hlt_pyjet2  = toc[*(kj+1)].py();
-      hlt_pzjet2  = toc[*(kj+1)].pz();
-      hlt_ptjet2  = toc[*(kj+1)].pt();
-      hlt_etajet2 = toc[*(kj+1)].eta();
-      hlt_phijet2 = toc[*(kj+1)].phi(); 
+      hlt_etajet1 = hltJets_.eta(ihlt);
+      hlt_phijet1 = hltJets_.phi(ihlt);  
+      hlt_etajet2 = hltJets_.eta(ihlt+1);
+      hlt_phijet2 = hltJets_.phi(ihlt+1); 
       //
       dR_HLT_RECO_11 = reco::deltaR(hlt_etajet1,hlt_phijet1,reco_etajet1,reco_phijet1);
       dR_HLT_RECO_22 = reco::deltaR(hlt_etajet2,hlt_phijet2,reco_etajet2,reco_phijet2);
@@ -340,16 +297,15 @@ HLTInclusiveVBFSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
       checkHLTIndex = true;
       //
       if(debug_) cout<<"DEBUG-6: Match"<<endl;
-      hlt_deltaetajet  = hlt_etajet1 - hlt_etajet2;
-      hlt_deltaphijet  = reco::deltaPhi(hlt_phijet1,hlt_phijet2);
       if(checkdR_crossOrder){
-	hlt_deltaetajet = (-1)*hlt_deltaetajet;
-	hlt_deltaphijet = reco::deltaPhi(hlt_phijet2,hlt_phijet1);
+	hlt_deltaetajet = hltJets_.deltaEta(ihlt+1,ihlt);
+	hlt_deltaphijet = hltJets_.deltaPhi(ihlt+1,ihlt);
+      }
+      else{
+	hlt_deltaetajet = hltJets_.deltaEta(ihlt,ihlt+1);
+	hlt_deltaphijet = hltJets_.deltaPhi(ihlt,ihlt+1);
       }
-      hlt_invmassjet   = sqrt((hlt_ejet1  + hlt_ejet2)  * (hlt_ejet1  + hlt_ejet2)  - 
-			      (hlt_pxjet1 + hlt_pxjet2) * (hlt_pxjet1 + hlt_pxjet2) - 
-			      (hlt_pyjet1 + hlt_pyjet2) * (hlt_pyjet1 + hlt_pyjet2) - 
-			      (hlt_pzjet1 + hlt_pzjet2) * (hlt_pzjet1 + hlt_pzjet2));
+      hlt_invmassjet   = hltJets_.invMass(ihlt,ihlt+1);
       v->getMEhisto_HLT_deltaEta_DiJet()->Fill(hlt_deltaetajet);
       v->getMEhisto_HLT_deltaPhi_DiJet()->Fill(hlt_deltaphijet);
       v->getMEhisto_HLT_invMass_DiJet()->Fill(hlt_invmassjet);
@@ -376,14 +332,10 @@ HLTInclusiveVBFSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
       if(debug_) cout<<"DEBUG-8: Not match"<<endl;
       v->getMEhisto_NumberOfMatches()->Fill(0);
     }
-  }
-  
-  
-  //****************************************************
-  // 
-  //****************************************************
-  for(PathInfoCollection::iterator v = hltPathsAll_.begin(); v!= hltPathsAll_.end(); ++v ){
-    if(isHLTPathAccepted(v->getPath())==false) continue;
+    
+    //****************************************************
+    // Rate approximation, from the same trigger objects
+    //****************************************************
     if(debug_) cout<<"DEBUG-9: Loop for rate approximation: "<<v->getPath()<<endl;
     check_mjj650_Pt35_DEta3p5 = false;
     check_mjj700_Pt35_DEta3p5 = false;
@@ -393,64 +345,24 @@ HLTInclusiveVBFSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
     check_mjj700_Pt40_DEta3p5 = false;
     check_mjj750_Pt40_DEta3p5 = false; 
     check_mjj800_Pt40_DEta3p5 = false;
-    edm::InputTag hltTag(v->getLabel(),"",processname_);
-    const int hltIndex = triggerObj_->filterIndex(hltTag);
-    if(hltIndex >= triggerObj_->sizeFilters()) continue;
-    const trigger::Keys & khlt = triggerObj_->filterKeys(hltIndex);
-    trigger::Keys::const_iterator kj = khlt.begin();
-    for(; kj != khlt.end(); kj+=2){
-      checkdR_sameOrder  = false;
-      checkdR_crossOrder = false;
+    for(unsigned int ihlt = 0; ihlt+1 < hltJets_.size(); ihlt+=2){
+      hlt_ptjet1  = hltJets_.pt(ihlt);
+      hlt_ptjet2  = hltJets_.pt(ihlt+1);
+      // all the thresholds need |delta eta| > 3.5 and both jets above 35 GeV
+      if(!(hlt_ptjet1>35. && hlt_ptjet2>=35.)) continue;
+      hlt_deltaetajet  = hltJets_.deltaEta(ihlt,ihlt+1);
+      if(!(std::abs(hlt_deltaetajet)>3.5)) continue;
+      hlt_invmassjet   = hltJets_.invMass(ihlt,ihlt+1);
       //
-      hlt_ejet1   = toc[*kj].energy();
-      //hlt_etjet1  = toc[*kj].et();
-      hlt_pxjet1  = toc[*kj].px();
-      hlt_pyjet1  = toc[*kj].py();
-      hlt_pzjet1  = toc[*kj].pz();
-      hlt_ptjet1  = toc[*kj].pt();
-      hlt_etajet1 = toc[*kj].eta();
-      hlt_phijet1 = toc[*kj].phi();  
-      //
-      hlt_ejet2   = toc[*(kj+1)].energy();
-      //hlt_etjet2  = toc[*(kj+1)].et();
-      hlt_pxjet2  = toc[*(kj+1)].px();
-      hlt_pyjet2  = toc[*(kj+1)].py();
-      hlt_pzjet2  = toc[*(kj+1)].pz();
-      hlt_ptjet2  = toc[*(kj+1)].pt();
-      hlt_etajet2 = toc[*(kj+1)].eta();
-      hlt_phijet2 = toc[*(kj+1)].phi(); 
-      //
-      hlt_deltaetajet  = hlt_etajet1 - hlt_etajet2;
-      hlt_deltaphijet  = reco::deltaPhi(hlt_phijet1,hlt_phijet2);
-      hlt_invmassjet   = sqrt((hlt_ejet1  + hlt_ejet2)  * (hlt_ejet1  + hlt_ejet2)  - 
-			      (hlt_pxjet1 + hlt_pxjet2) * (hlt_pxjet1 + hlt_pxjet2) - 
-			      (hlt_pyjet1 + hlt_pyjet2) * (hlt_pyjet1 + hlt_pyjet2) - 
-			      (hlt_pzjet1 + hlt_pzjet2) * (hlt_pzjet1 + hlt_pzjet2));
-      //
-      if(check_mjj650_Pt35_DEta3p5==false && hlt_ptjet1>35. && hlt_ptjet2>=35. && hlt_invmassjet>650 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj650_Pt35_DEta3p5=true;
-      }
-      if(check_mjj700_Pt35_DEta3p5==false && hlt_ptjet1>35. && hlt_ptjet2>=35. && hlt_invmassjet>700 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj700_Pt35_DEta3p5=true;
-      }	
-      if(check_mjj750_Pt35_DEta3p5==false && hlt_ptjet1>35. && hlt_ptjet2>=35. && hlt_invmassjet>750 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj750_Pt35_DEta3p5=true;
-      }
-      if(check_mjj800_Pt35_DEta3p5==false && hlt_ptjet1>35. && hlt_ptjet2>=35. && hlt_invmassjet>800 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj800_Pt35_DEta3p5=true;
-      }
-      if(check_mjj650_Pt40_DEta3p5==false && hlt_ptjet1>40. && hlt_ptjet2>=40. && hlt_invmassjet>650 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj650_Pt40_DEta3p5=true;
-      }
-      if(check_mjj700_Pt40_DEta3p5==false && hlt_ptjet1>40. && hlt_ptjet2>=40. && hlt_invmassjet>700 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj700_Pt40_DEta3p5=true;
-      }	
-      if(check_mjj750_Pt40_DEta3p5==false && hlt_ptjet1>40. && hlt_ptjet2>=40. && hlt_invmassjet>750 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj750_Pt40_DEta3p5=true;
-      }
-      if(check_mjj800_Pt40_DEta3p5==false && hlt_ptjet1>40. && hlt_ptjet2>=40. && hlt_invmassjet>800 && std::abs(hlt_deltaetajet)>3.5){
-	check_mjj800_Pt40_DEta3p5=true;
-      }
+      if(hlt_invmassjet>650) check_mjj650_Pt35_DEta3p5=true;
+      if(hlt_invmassjet>700) check_mjj700_Pt35_DEta3p5=true;
+      if(hlt_invmassjet>750) check_mjj750_Pt35_DEta3p5=true;
+      if(hlt_invmassjet>800) check_mjj800_Pt35_DEta3p5=true;
+      if(!(hlt_ptjet1>40. && hlt_ptjet2>=40.)) continue;
+      if(hlt_invmassjet>650) check_mjj650_Pt40_DEta3p5=true;
+      if(hlt_invmassjet>700) check_mjj700_Pt40_DEta3p5=true;
+      if(hlt_invmassjet>750) check_mjj750_Pt40_DEta3p5=true;
+      if(hlt_invmassjet>800) check_mjj800_Pt40_DEta3p5=true;
     }
     if(check_mjj650_Pt35_DEta3p5==true) v->getMEhisto_NumberOfEvents()->Fill(0);
     if(check_mjj700_Pt35_DEta3p5==true) v->getMEhisto_NumberOfEvents()->Fill(1);
@@ -0,0 +1,101 @@
+#include "DQMOffline/Trigger/interface/HLTMenuCache.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+  // bumped when the file layout changes
+  const char* const kFormat = "HLTMenuCache 1";
+
+  std::mutex& cacheMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  std::map<std::string, HLTMenuCache::Tables>& memoryCache() {
+    static std::map<std::string, HLTMenuCache::Tables> cache;
+    return cache;
+  }
+}
+
+HLTMenuCache::HLTMenuCache(const std::string& directory):
+  directory_(directory)
+{
+  if (!directory_.empty() && directory_[directory_.size()-1] != '/') directory_ += '/';
+}
+
+HLTMenuCache::Tables HLTMenuCache::get(const HLTConfigProvider& hltConfig, const std::string& key,
+                                       const std::function<Tables()>& make) const {
+  std::ostringstream name;
+  name << hltConfig.processPSet().id() << "_" << key;
+
+  // held while computing, the other modules would only redo the same work
+  std::lock_guard<std::mutex> guard(cacheMutex());
+  std::map<std::string, Tables>& cache = memoryCache();
+  std::map<std::string, Tables>::const_iterator cached = cache.find(name.str());
+  if (cached != cache.end()) return cached->second;
+
+  Tables tables;
+  const std::string header = std::string(kFormat) + " " + name.str();
+  const std::string fileName = directory_ + name.str() + ".txt";
+  if (directory_.empty() || !read(fileName, header, tables)) {
+    tables = make();
+    if (!directory_.empty()) write(fileName, header, tables);
+  }
+  cache[name.str()] = tables;
+  return tables;
+}
+
+bool HLTMenuCache::read(const std::string& fileName, const std::string& header, Tables& tables) const {
+  std::ifstream file(fileName.c_str());
+  if (!file) return false;
+
+  std::string line;
+  if (!std::getline(file, line) || line != header) return false;
+
+  // "<table> <number of entries>", then one entry per line
+  Tables parsed;
+  while (std::getline(file, line)) {
+    std::istringstream tableLine(line);
+    std::string table;
+    size_t nEntries = 0;
+    if (!(tableLine >> table >> nEntries)) return false;
+    std::vector<std::string>& entries = parsed[table];
+    entries.reserve(nEntries);
+    for (size_t i = 0; i < nEntries; ++i) {
+      if (!std::getline(file, line)) return false;
+      entries.push_back(line);
+    }
+  }
+  tables.swap(parsed);
+  return true;
+}
+
+void HLTMenuCache::write(const std::string& fileName, const std::string& header, const Tables& tables) const {
+  std::ostringstream tmpName;
+  tmpName << fileName << "." << getpid() << ".tmp";
+  {
+    std::ofstream file(tmpName.str().c_str());
+    file << header << "\n";
+    for (Tables::const_iterator table = tables.begin(); table != tables.end(); ++table) {
+      file << table->first << " " << table->second.size() << "\n";
+      for (size_t i = 0; i < table->second.size(); ++i)
+        file << table->second[i] << "\n";
+    }
+    if (!file) {
+      edm::LogWarning("HLTMenuCache") << "could not write " << tmpName.str() << ", the menu tables are not cached on disk";
+      std::remove(tmpName.str().c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpName.str().c_str(), fileName.c_str()) != 0) {
+    edm::LogWarning("HLTMenuCache") << "could not rename " << tmpName.str() << " to " << fileName;
+    std::remove(tmpName.str().c_str());
+  }
+}
@@ -7,13 +7,12 @@
 
 #include "FWCore/Framework/interface/Run.h"
 #include "FWCore/Framework/interface/EventSetup.h"
-#include "SimDataFormats/GeneratorProducts/interface/GenEventInfoProduct.h"
-#include "SimDataFormats/GeneratorProducts/interface/GenRunInfoProduct.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/Candidate/interface/CandMatchMap.h"
 
 #include <iostream>
+#include <algorithm>
 
 //////////////////////////////////////////////////////////////////////////////
 //////// Namespaces and Typedefs /////////////////////////////////////////////
@@ -27,6 +26,44 @@ using namespace l1extra;
 typedef std::vector<std::string> vstring;
 
 
+//////////////////////////////////////////////////////////////////////////////
+//////// HLTMuonView Members /////////////////////////////////////////////////
+
+void HLTMuonView::fill(const MuonCollection & allMuons, 
+                       const BeamSpot & beamSpot,
+                       size_t nVerticesInEvent)
+{
+
+  const size_t n = allMuons.size();
+  muons.resize(n);
+  tracks.resize(n);
+  d0.resize(n);
+  z0.resize(n);
+  pt.resize(n);
+  eta.resize(n);
+  phi.resize(n);
+  charge.resize(n);
+  nVertices = nVerticesInEvent;
+
+  for (size_t i = 0; i < n; i++) {
+    const Muon & mu = allMuons[i];
+    const Track * track = 0;
+    if (mu.isTrackerMuon()) track = & * mu.innerTrack();
+    else if (mu.isStandAloneMuon()) track = & * mu.outerTrack();
+    muons[i] = & mu;
+    tracks[i] = track;
+    d0[i] = track ? track->dxy(beamSpot.position()) : NOMATCH;
+    z0[i] = track ? track->dz(beamSpot.position()) : NOMATCH;
+    pt[i] = mu.pt();
+    eta[i] = mu.eta();
+    phi[i] = mu.phi();
+    charge[i] = mu.charge();
+  }
+
+}
+
+
+
 //////////////////////////////////////////////////////////////////////////////
 //////// HLTMuonMatchAndPlot Class Members ///////////////////////////////////
 
@@ -38,20 +75,15 @@ HLTMuonMatchAndPlot::HLTMuonMatchAndPlot(const ParameterSet & pset,
   destination_(pset.getUntrackedParameter<string>("destination")),
   requiredTriggers_(pset.getUntrackedParameter<vstring>("requiredTriggers")),
   targetParams_(pset.getParameterSet("targetParams")),
-  probeParams_(pset.getParameterSet("probeParams")),
   hltPath_(hltPath),
   moduleLabel_(moduleLabel),
+  filterTag_(moduleLabel, "", hltProcessName_),
   isLastFilter_(islastfilter),
-  hasTargetRecoCuts(targetParams_.exists("recoCuts")),
-  hasProbeRecoCuts(probeParams_.exists("recoCuts")),
-  targetMuonSelector_(targetParams_.getUntrackedParameter<string>("recoCuts", "")),
+  hasTargetRecoCuts_(targetParams_.exists("recoCuts")),
+  targetRecoCuts_(targetParams_.getUntrackedParameter<string>("recoCuts", "")),
   targetZ0Cut_(targetParams_.getUntrackedParameter<double>("z0Cut",0.)),
   targetD0Cut_(targetParams_.getUntrackedParameter<double>("d0Cut",0.)),
-  targetptCutZ_(targetParams_.getUntrackedParameter<double>("ptCut_Z",20.)),
-  targetptCutJpsi_(targetParams_.getUntrackedParameter<double>("ptCut_Jpsi",20.)),
-  probeMuonSelector_(probeParams_.getUntrackedParameter<string>("recoCuts", "")),
-  probeZ0Cut_(probeParams_.getUntrackedParameter<double>("z0Cut",0.)),
-  probeD0Cut_(probeParams_.getUntrackedParameter<double>("d0Cut",0.)),
+  targetSelection_(-1),
   triggerSelector_(targetParams_.getUntrackedParameter<string>("hltCuts","")),
   hasTriggerCuts_(targetParams_.exists("hltCuts"))
 {
@@ -59,6 +91,13 @@ HLTMuonMatchAndPlot::HLTMuonMatchAndPlot(const ParameterSet & pset,
   fillMapFromPSet(binParams_, pset, "binParams");
   fillMapFromPSet(plotCuts_, pset, "plotCuts");
 
+  targetptCut_[Z_WINDOW] = targetParams_.getUntrackedParameter<double>("ptCut_Z",20.);
+  targetptCut_[JPSI_WINDOW] = targetParams_.getUntrackedParameter<double>("ptCut_Jpsi",20.);
+
+  std::fill(hists_, hists_ + NR_HISTS, (MonitorElement *) 0);
+  std::fill(effHists_[0], effHists_[0] + NR_EFF_HISTS, (MonitorElement *) 0);
+  std::fill(effHists_[1], effHists_[1] + NR_EFF_HISTS, (MonitorElement *) 0);
+
   // Get the trigger level.
   triggerLevel_ = "L3";
   TPRegexp levelRegexp("L[1-3]");
@@ -68,6 +107,8 @@ HLTMuonMatchAndPlot::HLTMuonMatchAndPlot(const ParameterSet & pset,
     triggerLevel_ = ((TObjString *)levelArray->At(0))->GetString();
   }
   delete levelArray;
+  maxDeltaR_ = plotCuts_[triggerLevel_ + "DeltaR"];
+  maxEta_ = plotCuts_["maxEta"];
 
   // Get the pT cut by parsing the name of the HLT path.
   cutMinPt_ = 3;
@@ -103,47 +144,48 @@ void HLTMuonMatchAndPlot::beginRun(DQMStore::IBooker & iBooker,
   // Form is book1D(name, binningType, title) where 'binningType' is used 
   // to fetch the bin settings from binParams_.
   if (isLastFilter_){
-    book1D(iBooker, "hltPt", "pt", ";p_{T} of HLT object");
-    book1D(iBooker, "hltEta", "eta", ";#eta of HLT object");
-    book1D(iBooker, "hltPhi", "phi", ";#phi of HLT object");
-    book1D(iBooker, "resolutionEta", "resolutionEta", ";#eta^{reco}-#eta^{HLT};");
-    book1D(iBooker, "resolutionPhi", "resolutionPhi", ";#phi^{reco}-#phi^{HLT};");
+    hists_[HLT_PT] = book1D(iBooker, "hltPt", "pt", ";p_{T} of HLT object");
+    hists_[HLT_ETA] = book1D(iBooker, "hltEta", "eta", ";#eta of HLT object");
+    hists_[HLT_PHI] = book1D(iBooker, "hltPhi", "phi", ";#phi of HLT object");
+    hists_[RESOLUTION_ETA] = book1D(iBooker, "resolutionEta", "resolutionEta", ";#eta^{reco}-#eta^{HLT};");
+    hists_[RESOLUTION_PHI] = book1D(iBooker, "resolutionPhi", "resolutionPhi", ";#phi^{reco}-#phi^{HLT};");
   }
-  book1D(iBooker, "deltaR", "deltaR", ";#Deltar(reco, HLT);");
+  hists_[DELTA_R] = book1D(iBooker, "deltaR", "deltaR", ";#Deltar(reco, HLT);");
   
-  book1D(iBooker, "resolutionPt", "resolutionRel", 
-         ";(p_{T}^{reco}-p_{T}^{HLT})/|p_{T}^{reco}|;");
+  hists_[RESOLUTION_PT] = book1D(iBooker, "resolutionPt", "resolutionRel", 
+                                 ";(p_{T}^{reco}-p_{T}^{HLT})/|p_{T}^{reco}|;");
 
   for (size_t i = 0; i < 2; i++) {
 
     string suffix = EFFICIENCY_SUFFIXES[i];
+    MonitorElement ** effHists = effHists_[i];
 
-    book1D(iBooker, "efficiencyEta_" + suffix, "eta", ";#eta;");
-    book1D(iBooker, "efficiencyPhi_" + suffix, "phi", ";#phi;");
-    book1D(iBooker, "efficiencyTurnOn_" + suffix, "pt", ";p_{T};");
-    book1D(iBooker, "efficiencyVertex_" + suffix, "NVertex", ";NVertex;");
+    effHists[EFF_ETA] = book1D(iBooker, "efficiencyEta_" + suffix, "eta", ";#eta;");
+    effHists[EFF_PHI] = book1D(iBooker, "efficiencyPhi_" + suffix, "phi", ";#phi;");
+    effHists[EFF_TURNON] = book1D(iBooker, "efficiencyTurnOn_" + suffix, "pt", ";p_{T};");
+    effHists[EFF_VERTEX] = book1D(iBooker, "efficiencyVertex_" + suffix, "NVertex", ";NVertex;");
    
 
-    book2D(iBooker, "efficiencyPhiVsEta_" + suffix, "etaCoarse", 
-	   "phiCoarse", ";#eta;#phi");
+    effHists[EFF_PHIVSETA] = book2D(iBooker, "efficiencyPhiVsEta_" + suffix, "etaCoarse", 
+                                    "phiCoarse", ";#eta;#phi");
 
     if (!isLastFilter_) continue;  //this will be plotted only for the last filter
 //  book1D(iBooker, string name, string binningType, string title);     
-    book1D(iBooker, "efficiencyD0_" + suffix, "d0", ";d0;");
-    book1D(iBooker, "efficiencyZ0_" + suffix, "z0", ";z0;");
-    book1D(iBooker, "efficiencyCharge_" + suffix, "charge", ";charge;");
+    effHists[EFF_D0] = book1D(iBooker, "efficiencyD0_" + suffix, "d0", ";d0;");
+    effHists[EFF_Z0] = book1D(iBooker, "efficiencyZ0_" + suffix, "z0", ";z0;");
+    effHists[EFF_CHARGE] = book1D(iBooker, "efficiencyCharge_" + suffix, "charge", ";charge;");
     
-    book1D(iBooker, "fakerateEta_" + suffix, "eta", ";#eta;");
-    book1D(iBooker, "fakerateVertex_" + suffix, "NVertex", ";NVertex;");
-    book1D(iBooker, "fakeratePhi_" + suffix, "phi", ";#phi;");
-    book1D(iBooker, "fakerateTurnOn_" + suffix, "pt", ";p_{T};");
+    effHists[FAKE_ETA] = book1D(iBooker, "fakerateEta_" + suffix, "eta", ";#eta;");
+    effHists[FAKE_VERTEX] = book1D(iBooker, "fakerateVertex_" + suffix, "NVertex", ";NVertex;");
+    effHists[FAKE_PHI] = book1D(iBooker, "fakeratePhi_" + suffix, "phi", ";#phi;");
+    effHists[FAKE_TURNON] = book1D(iBooker, "fakerateTurnOn_" + suffix, "pt", ";p_{T};");
     
-    book1D(iBooker, "massVsEtaZ_" + suffix, "etaCoarse", ";#eta");
-    book1D(iBooker, "massVsEtaJpsi_" + suffix, "etaCoarse", ";#eta");
-    book1D(iBooker, "massVsPtZ_" + suffix, "ptCoarse", ";p_{T}");
-    book1D(iBooker, "massVsPtJpsi_" + suffix, "ptCoarse", ";p_{T}");
-    book1D(iBooker, "massVsVertexZ_" + suffix, "NVertex", ";NVertex");
-    book1D(iBooker, "massVsVertexJpsi_" + suffix, "NVertex", ";NVertex");
+    effHists[MASS_ETA_Z] = book1D(iBooker, "massVsEtaZ_" + suffix, "etaCoarse", ";#eta");
+    effHists[MASS_ETA_JPSI] = book1D(iBooker, "massVsEtaJpsi_" + suffix, "etaCoarse", ";#eta");
+    effHists[MASS_PT_Z] = book1D(iBooker, "massVsPtZ_" + suffix, "ptCoarse", ";p_{T}");
+    effHists[MASS_PT_JPSI] = book1D(iBooker, "massVsPtJpsi_" + suffix, "ptCoarse", ";p_{T}");
+    effHists[MASS_VERTEX_Z] = book1D(iBooker, "massVsVertexZ_" + suffix, "NVertex", ";NVertex");
+    effHists[MASS_VERTEX_JPSI] = book1D(iBooker, "massVsVertexJpsi_" + suffix, "NVertex", ";NVertex");
     
   }
   
@@ -159,56 +201,9 @@ void HLTMuonMatchAndPlot::endRun(const edm::Run& iRun,
 
 
 
-void HLTMuonMatchAndPlot::analyze(Handle<MuonCollection>   & allMuons, 
-				  Handle<BeamSpot>         & beamSpot,
-				  Handle<VertexCollection> & vertices,
-				  Handle<TriggerEvent>     & triggerSummary,  
-				  Handle<TriggerResults>   & triggerResults)
+void HLTMuonMatchAndPlot::analyze(const HLTMuonView    & view,
+                                  const TriggerEvent   & triggerSummary)
 {
-  /*
-  if(gen != 0) {
-    for(g_part = gen->begin(); g_part != gen->end(); g_part++){
-      if( abs(g_part->pdgId()) ==  13) {
-        if(!( g_part->status() ==1 || (g_part->status() ==2 && abs(g_part->pdgId())==5))) continue;
-        bool GenMomExists  (true);
-        bool GenGrMomExists(true);
-        if( g_part->pt() < 10.0 )  continue;
-        if( fabs(g_part->eta()) > 2.4 ) continue;
-        int gen_id= g_part->pdgId();
-        const GenParticle* gen_lept = &(*g_part);
-        // get mother of gen_lept
-        const GenParticle* gen_mom = static_cast<const GenParticle*> (gen_lept->mother());
-        if(gen_mom==NULL) GenMomExists=false;
-        int m_id=-999;
-        if(GenMomExists) m_id = gen_mom->pdgId();
-        if(m_id != gen_id || !GenMomExists);
-        else{
-          int id= m_id;
-          while(id == gen_id && GenMomExists){
-            gen_mom = static_cast<const GenParticle*> (gen_mom->mother());
-            if(gen_mom==NULL){
-              GenMomExists=false;
-            }
-            if(GenMomExists) id=gen_mom->pdgId();
-          }
-        }
-        if(GenMomExists) m_id = gen_mom->pdgId();
-        gen_leptsp.push_back(gen_lept);
-        gen_momsp.push_back(gen_mom);
-      }
-    }
-  }
-
-
-  std::vector<GenParticle> gen_lepts;
-  for(size_t i = 0; i < gen_leptsp.size(); i++) {
-    gen_lepts.push_back(*gen_leptsp[i]);
-  }
-
-
-  */
-
-
 
   // Throw out this event if it doesn't pass the required triggers.
   // this is not needed anymore rejecting if there is no filter... 
@@ -220,138 +215,120 @@ void HLTMuonMatchAndPlot::analyze(Handle<MuonCollection>   & allMuons,
 ///  }
   
   
-  // Select objects based on the configuration.
-  MuonCollection targetMuons = selectedMuons(* allMuons, * beamSpot, hasTargetRecoCuts, targetMuonSelector_, targetD0Cut_, targetZ0Cut_);
-  MuonCollection probeMuons = selectedMuons(* allMuons, * beamSpot, hasProbeRecoCuts, probeMuonSelector_, probeD0Cut_, probeZ0Cut_);
-  TriggerObjectCollection allTriggerObjects = triggerSummary->getObjects();
-  TriggerObjectCollection hltMuons = 
-    selectedTriggerObjects(allTriggerObjects, * triggerSummary, hasTriggerCuts_,triggerSelector_);
+  // Select objects based on the configuration.  The target muons are indices
+  // into the shared view, selected once per event by the container.
+  static const vector<size_t> noMuons;
+  const vector<size_t> & targetMuons = 
+    targetSelection_ < view.selections.size() ? view.selections[targetSelection_] : noMuons;
+  selectedTriggerObjects(triggerSummary, hltMuons_);
+  const size_t nVertices = view.nVertices;
 
   // Fill plots for HLT muons.
   if (isLastFilter_){
-    for (size_t i = 0; i < hltMuons.size(); i++) {
-      hists_["hltPt"]->Fill(hltMuons[i].pt());
-      hists_["hltEta"]->Fill(hltMuons[i].eta());
-      hists_["hltPhi"]->Fill(hltMuons[i].phi());
+    for (size_t i = 0; i < hltMuons_.size(); i++) {
+      hists_[HLT_PT]->Fill(hltMuons_[i].pt());
+      hists_[HLT_ETA]->Fill(hltMuons_[i].eta());
+      hists_[HLT_PHI]->Fill(hltMuons_[i].phi());
     }
   }
   // Find the best trigger object matches for the targetMuons.
-  vector<size_t> matches = matchByDeltaR(targetMuons, hltMuons, 
-                                         plotCuts_[triggerLevel_ + "DeltaR"]);
+  matchTargetsToHlt(view, targetMuons);
 
 
   // Fill plots for matched muons.
   bool pairalreadyconsidered = false;
   for (size_t i = 0; i < targetMuons.size(); i++) {
 
-    Muon & muon = targetMuons[i];
+    const size_t muon = targetMuons[i];
+    const double pt = view.pt[muon];
+    const double eta = view.eta[muon];
+    const double phi = view.phi[muon];
+    const bool isMatched = matches_[i] < hltMuons_.size();
 
     // Fill plots which are not efficiencies.
-    if (matches[i] < targetMuons.size()) {
-      TriggerObject & hltMuon = hltMuons[matches[i]];
-      double ptRes = (muon.pt() - hltMuon.pt()) / muon.pt();
-      hists_["resolutionPt"]->Fill(ptRes);
-      hists_["deltaR"]->Fill(deltaR(muon, hltMuon));
+    if (isMatched) {
+      const TriggerObject & hltMuon = hltMuons_[matches_[i]];
+      double ptRes = (pt - hltMuon.pt()) / pt;
+      hists_[RESOLUTION_PT]->Fill(ptRes);
+      hists_[DELTA_R]->Fill(deltaR(eta, phi, hltMuon.eta(), hltMuon.phi()));
       
       if (isLastFilter_){
-	double etaRes = muon.eta() - hltMuon.eta();
-	double phiRes = muon.phi() - hltMuon.phi();
-	hists_["resolutionEta"]->Fill(etaRes);
-	hists_["resolutionPhi"]->Fill(phiRes);
+	double etaRes = eta - hltMuon.eta();
+	double phiRes = phi - hltMuon.phi();
+	hists_[RESOLUTION_ETA]->Fill(etaRes);
+	hists_[RESOLUTION_PHI]->Fill(phiRes);
       }
     }
 
     // Fill numerators and denominators for efficiency plots.
-    for (size_t j = 0; j < 2; j++) {
-
-      string suffix = EFFICIENCY_SUFFIXES[j];
+    // If no match was found, then the numerator plots don't get filled.
+    const size_t nSuffixes = isMatched ? 2 : 1;
+    for (size_t j = 0; j < nSuffixes; j++) {
 
-      // If no match was found, then the numerator plots don't get filled.
-      if (suffix == "numer" && matches[i] >= targetMuons.size()) continue;
+      MonitorElement ** effHists = effHists_[j];
 
-      if (muon.pt() > cutMinPt_) {
-        hists_["efficiencyEta_" + suffix]->Fill(muon.eta());
-        hists_["efficiencyPhiVsEta_" + suffix]->Fill(muon.eta(), muon.phi());
+      if (pt > cutMinPt_) {
+        effHists[EFF_ETA]->Fill(eta);
+        effHists[EFF_PHIVSETA]->Fill(eta, phi);
       }
       
-      if (fabs(muon.eta()) < plotCuts_["maxEta"]) {
-        hists_["efficiencyTurnOn_" + suffix]->Fill(muon.pt());
+      if (fabs(eta) < maxEta_) {
+        effHists[EFF_TURNON]->Fill(pt);
       }
       
-
-      if (muon.pt() > cutMinPt_ && fabs(muon.eta()) < plotCuts_["maxEta"]) {
-        const Track * track = 0;
-        if (muon.isTrackerMuon()) track = & * muon.innerTrack();
-        else if (muon.isStandAloneMuon()) track = & * muon.outerTrack();
-	if (track) {
-          hists_["efficiencyVertex_" + suffix]->Fill(vertices->size());
-          hists_["efficiencyPhi_" + suffix]->Fill(muon.phi());
+      // The target selection already requires the muon to have a track.
+      if (pt > cutMinPt_ && fabs(eta) < maxEta_) {
+        effHists[EFF_VERTEX]->Fill(nVertices);
+        effHists[EFF_PHI]->Fill(phi);
           
-	  if (isLastFilter_){
-	    double d0 = track->dxy(beamSpot->position());
-	    double z0 = track->dz(beamSpot->position());
-	    hists_["efficiencyD0_" + suffix]->Fill(d0);
-	    hists_["efficiencyZ0_" + suffix]->Fill(z0);
-	    hists_["efficiencyCharge_" + suffix]->Fill(muon.charge());
-	  }
-	}
+        if (isLastFilter_){
+          effHists[EFF_D0]->Fill(view.d0[muon]);
+          effHists[EFF_Z0]->Fill(view.z0[muon]);
+          effHists[EFF_CHARGE]->Fill(view.charge[muon]);
+        }
       }
     } // finish loop numerator / denominator...
     
     if (!isLastFilter_) continue;
     // Fill plots for tag and probe
     // Muon cannot be a tag because doesn't match an hlt muon     
-    if(matches[i] >= targetMuons.size()) continue;
-    for (size_t k = 0; k < targetMuons.size(); k++) {
+    if (!isMatched) continue;
+    // One pass over the probes feeds both mass windows, which do not overlap.
+    for (size_t k = 0; k < targetMuons.size() && !pairalreadyconsidered; k++) {
       if(k == i) continue;
-      Muon & theProbe = targetMuons[k];
-      if (muon.charge() != theProbe.charge() && !pairalreadyconsidered) {
-        double mass = (muon.p4() + theProbe.p4()).M();
-        if(mass > 60 && mass < 120) {
-          if(muon.pt() < targetptCutZ_) continue;
-          hists_["massVsEtaZ_denom"]->Fill(theProbe.eta());
-          hists_["massVsPtZ_denom"]->Fill(theProbe.pt());
-          hists_["massVsVertexZ_denom"]->Fill(vertices->size());
-          if(matches[k] < targetMuons.size()) {
-            hists_["massVsEtaZ_numer"]->Fill(theProbe.eta());
-            hists_["massVsPtZ_numer"]->Fill(theProbe.pt());
-            hists_["massVsVertexZ_numer"]->Fill(vertices->size());
-          }  
-          pairalreadyconsidered = true;
-        }
-        if(mass > 1 && mass < 4) {
-          if(muon.pt() < targetptCutJpsi_) continue;
-          hists_["massVsEtaJpsi_denom"]->Fill(theProbe.eta());
-          hists_["massVsPtJpsi_denom"]->Fill(theProbe.pt());
-          hists_["massVsVertexJpsi_denom"]->Fill(vertices->size());
-          if(matches[k] < targetMuons.size()) {
-            hists_["massVsEtaJpsi_numer"]->Fill(theProbe.eta());
-            hists_["massVsPtJpsi_numer"]->Fill(theProbe.pt());
-            hists_["massVsVertexJpsi_numer"]->Fill(vertices->size());
-          }
-          pairalreadyconsidered = true;
-        }
+      const size_t probe = targetMuons[k];
+      if (view.charge[muon] == view.charge[probe]) continue;
+      double mass = (view.muons[muon]->p4() + view.muons[probe]->p4()).M();
+      int window;
+      if (mass > 60 && mass < 120) window = Z_WINDOW;
+      else if (mass > 1 && mass < 4) window = JPSI_WINDOW;
+      else continue;
+      if (pt < targetptCut_[window]) continue;
+      // eta, pt and vertex slots follow each other for each window
+      const int slot = window == Z_WINDOW ? MASS_ETA_Z : MASS_ETA_JPSI;
+      const size_t nProbeSuffixes = matches_[k] < hltMuons_.size() ? 2 : 1;
+      for (size_t j = 0; j < nProbeSuffixes; j++) {
+        effHists_[j][slot]->Fill(view.eta[probe]);
+        effHists_[j][slot + 1]->Fill(view.pt[probe]);
+        effHists_[j][slot + 2]->Fill(nVertices);
       }
-    } // End loop over denominator and numerator.
+      pairalreadyconsidered = true;
+    } // End loop over probes.
   } // End loop over targetMuons.
   
   if (!isLastFilter_) return;
   // Plot fake rates (efficiency for HLT objects to not get matched to RECO).
-  vector<size_t> hltMatches = matchByDeltaR(hltMuons, targetMuons,
-                                            plotCuts_[triggerLevel_ + "DeltaR"]);
-  for (size_t i = 0; i < hltMuons.size(); i++) {
-    TriggerObject & hltMuon = hltMuons[i];
-    bool isFake = hltMatches[i] > hltMuons.size();
-    for (size_t j = 0; j < 2; j++) {
-
-      // defination: Line 6 file(line 55)
-      string suffix = EFFICIENCY_SUFFIXES[j]; 
-      // If match is found, then numerator plots should not get filled
-      if (suffix == "numer" && ! isFake) continue;
-      hists_["fakerateVertex_" + suffix]->Fill(vertices->size());
-      hists_["fakerateEta_" + suffix]->Fill(hltMuon.eta());
-      hists_["fakeratePhi_" + suffix]->Fill(hltMuon.phi());
-      hists_["fakerateTurnOn_" + suffix]->Fill(hltMuon.pt());
+  for (size_t i = 0; i < hltMuons_.size(); i++) {
+    const TriggerObject & hltMuon = hltMuons_[i];
+    // If match is found, then numerator plots should not get filled
+    const bool isFake = hltMatches_[i] >= targetMuons.size();
+    const size_t nSuffixes = isFake ? 2 : 1;
+    for (size_t j = 0; j < nSuffixes; j++) {
+      MonitorElement ** effHists = effHists_[j];
+      effHists[FAKE_VERTEX]->Fill(nVertices);
+      effHists[FAKE_ETA]->Fill(hltMuon.eta());
+      effHists[FAKE_PHI]->Fill(hltMuon.phi());
+      effHists[FAKE_TURNON]->Fill(hltMuon.pt());
     } // End loop over numerator and denominator.
   } // End loop over hltMuons.
   
@@ -469,68 +446,83 @@ HLTMuonMatchAndPlot::matchByDeltaR(const vector<T1> & collection1,
 
 
 
-MuonCollection
-HLTMuonMatchAndPlot::selectedMuons(const MuonCollection & allMuons, 
-                                   const BeamSpot & beamSpot,
-                                   bool hasRecoCuts,
-                                   const StringCutObjectSelector<reco::Muon> &selector,
-                                   double d0Cut, double z0Cut)
+// Same greedy matching as matchByDeltaR, on the target muons of the view
+// against hltMuons_.  Fills matches_ and its inverse hltMatches_; unmatched
+// entries are set to -1.
+void
+HLTMuonMatchAndPlot::matchTargetsToHlt(const HLTMuonView & view,
+                                       const vector<size_t> & targetMuons)
 {
 
-  // If there is no selector (recoCuts does not exists), return an empty collection. 
-  if (!hasRecoCuts)
-    return MuonCollection();
+  const size_t n1 = targetMuons.size();
+  const size_t n2 = hltMuons_.size();
 
-  MuonCollection reducedMuons;
-  for (auto const& mu : allMuons){
-    const Track * track = 0;
-    if (mu.isTrackerMuon()) track = & * mu.innerTrack();
-    else if (mu.isStandAloneMuon()) track = & * mu.outerTrack();
-    if (track && selector(mu) &&
-        fabs(track->dxy(beamSpot.position())) < d0Cut &&
-        fabs(track->dz(beamSpot.position())) < z0Cut)
-      reducedMuons.push_back(mu);
+  matches_.assign(n1, -1);
+  hltMatches_.assign(n2, -1);
+  deltaRMatrix_.assign(n1 * n2, NOMATCH);
+
+  for (size_t i = 0; i < n1; i++) {
+    const double eta = view.eta[targetMuons[i]];
+    const double phi = view.phi[targetMuons[i]];
+    for (size_t j = 0; j < n2; j++)
+      deltaRMatrix_[i * n2 + j] = deltaR(eta, phi, hltMuons_[j].eta(), hltMuons_[j].phi());
   }
 
-  return reducedMuons;
+  // Run through the matrix n1 times to make sure we've found all matches.
+  for (size_t k = 0; k < n1; k++) {
+    size_t i_min = -1;
+    size_t j_min = -1;
+    double minDeltaR = maxDeltaR_;
+    // find the smallest deltaR
+    for (size_t i = 0; i < n1; i++)
+      for (size_t j = 0; j < n2; j++)
+        if (deltaRMatrix_[i * n2 + j] < minDeltaR) {
+          i_min = i;
+          j_min = j;
+          minDeltaR = deltaRMatrix_[i * n2 + j];
+        }
+    // If a match has been made, save it and make those candidates unavailable.
+    if (minDeltaR >= maxDeltaR_) break;
+    matches_[i_min] = j_min;
+    hltMatches_[j_min] = i_min;
+    for (size_t j = 0; j < n2; j++)
+      deltaRMatrix_[i_min * n2 + j] = NOMATCH;
+    for (size_t i = 0; i < n1; i++)
+      deltaRMatrix_[i * n2 + j_min] = NOMATCH;
+  }
 
 }
 
 
 
-TriggerObjectCollection
-HLTMuonMatchAndPlot::selectedTriggerObjects(
-  const TriggerObjectCollection & triggerObjects,
-  const TriggerEvent & triggerSummary,
-  bool hasTriggerCuts,
-  const StringCutObjectSelector<TriggerObject> triggerSelector)
+void
+HLTMuonMatchAndPlot::selectedTriggerObjects(const TriggerEvent & triggerSummary,
+                                            TriggerObjectCollection & selectedObjects)
 {
-  if ( !hasTriggerCuts) return TriggerObjectCollection();
-
-  InputTag filterTag(moduleLabel_, "", hltProcessName_);
-  size_t filterIndex = triggerSummary.filterIndex(filterTag);
+  selectedObjects.clear();
+  if ( !hasTriggerCuts_) return;
 
-  TriggerObjectCollection selectedObjects;
+  size_t filterIndex = triggerSummary.filterIndex(filterTag_);
 
   if (filterIndex < triggerSummary.sizeFilters()) {
+    const TriggerObjectCollection & triggerObjects = triggerSummary.getObjects();
     const Keys &keys = triggerSummary.filterKeys(filterIndex);
     for (size_t j = 0; j < keys.size(); j++ ){
-      TriggerObject foundObject = triggerObjects[keys[j]];
-      if (triggerSelector(foundObject))
+      const TriggerObject & foundObject = triggerObjects[keys[j]];
+      if (triggerSelector_(foundObject))
       {
 	selectedObjects.push_back(foundObject);
       }
       }
   }
 
-  return selectedObjects;
-
 }
 
 
 
-void HLTMuonMatchAndPlot::book1D(DQMStore::IBooker & iBooker, string name, 
-				 string binningType, string title)
+MonitorElement * 
+HLTMuonMatchAndPlot::book1D(DQMStore::IBooker & iBooker, string name, 
+                            string binningType, string title)
 {
 
   /* Properly delete the array of floats that has been allocated on
@@ -543,19 +535,21 @@ void HLTMuonMatchAndPlot::book1D(DQMStore::IBooker & iBooker, string name,
   float * edges = 0; 
   fillEdges(nBins, edges, binParams_[binningType]);
 
-  hists_[name] = iBooker.book1D(name, title, nBins, edges);
-  if (hists_[name])
-    if (hists_[name]->getTH1F()->GetSumw2N())
-      hists_[name]->getTH1F()->Sumw2();
+  MonitorElement * hist = iBooker.book1D(name, title, nBins, edges);
+  if (hist)
+    if (hist->getTH1F()->GetSumw2N())
+      hist->getTH1F()->Sumw2();
 
   if (edges)
     delete [] edges;
 
+  return hist;
+
 }
 
 
 
-void
+MonitorElement *
 HLTMuonMatchAndPlot::book2D(DQMStore::IBooker & iBooker, string name, 
 			    string binningTypeX, string binningTypeY, 
 			    string title) 
@@ -575,17 +569,19 @@ HLTMuonMatchAndPlot::book2D(DQMStore::IBooker & iBooker, string name,
   float * edgesY = 0;
   fillEdges(nBinsY, edgesY, binParams_[binningTypeY]);
 
-  hists_[name] = iBooker.book2D(name.c_str(), title.c_str(),
-				nBinsX, edgesX, nBinsY, edgesY);
-  if (hists_[name])
-    if (hists_[name]->getTH2F()->GetSumw2N())
-      hists_[name]->getTH2F()->Sumw2();
+  MonitorElement * hist = iBooker.book2D(name.c_str(), title.c_str(),
+                                         nBinsX, edgesX, nBinsY, edgesY);
+  if (hist)
+    if (hist->getTH2F()->GetSumw2N())
+      hist->getTH2F()->Sumw2();
 
   if (edgesX)
     delete [] edgesX;
   if (edgesY)
     delete [] edgesY;
 
+  return hist;
+
 }
 
 
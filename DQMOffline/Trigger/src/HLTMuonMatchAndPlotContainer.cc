@@ -46,7 +46,29 @@ void HLTMuonMatchAndPlotContainer::addPlotter(const edm::ParameterSet &pset , st
 					      std::string label, bool islastfilter)
 {
 
-  plotters_.push_back(HLTMuonMatchAndPlot(pset,path,label,islastfilter));
+  HLTMuonMatchAndPlot plotter(pset,path,label,islastfilter);
+
+  // Plotters without recoCuts select no muons, the others share the
+  // evaluation of identical selections.
+  if (plotter.hasTargetRecoCuts()) {
+    size_t index = 0;
+    for (; index < selections_.size(); ++index) {
+      const MuonSelection & selection = selections_[index];
+      if (selection.recoCuts == plotter.targetRecoCuts() &&
+          selection.d0Cut == plotter.targetD0Cut() &&
+          selection.z0Cut == plotter.targetZ0Cut())
+        break;
+    }
+    if (index == selections_.size()) {
+      MuonSelection selection = {plotter.targetRecoCuts(), plotter.targetD0Cut(), 
+                                 plotter.targetZ0Cut(), 
+                                 StringCutObjectSelector<reco::Muon>(plotter.targetRecoCuts())};
+      selections_.push_back(selection);
+    }
+    plotter.setTargetSelection(index);
+  }
+
+  plotters_.push_back(plotter);
 
 }
 
@@ -133,13 +155,27 @@ void HLTMuonMatchAndPlotContainer::analyze(const edm::Event & iEvent,
   }
   
 
+  // Muon quantities and selections are computed once and shared by the plotters.
+  view_.fill(* allMuons, * beamSpot, vertices->size());
+  view_.selections.resize(selections_.size());
+  for (size_t i = 0; i < selections_.size(); ++i) {
+    const MuonSelection & selection = selections_[i];
+    vector<size_t> & selected = view_.selections[i];
+    selected.clear();
+    for (size_t j = 0; j < view_.size(); ++j) {
+      if (view_.tracks[j] && selection.selector(* view_.muons[j]) &&
+          fabs(view_.d0[j]) < selection.d0Cut &&
+          fabs(view_.z0[j]) < selection.z0Cut)
+        selected.push_back(j);
+    }
+  }
+
   vector<HLTMuonMatchAndPlot>::iterator iter = plotters_.begin();
   vector<HLTMuonMatchAndPlot>::iterator end  = plotters_.end();
 
   for (; iter != end; ++iter) 
     {
-      iter->analyze(allMuons, beamSpot, vertices, triggerSummary, triggerResults);
+      iter->analyze(view_, * triggerSummary);
     }
   
 }
-
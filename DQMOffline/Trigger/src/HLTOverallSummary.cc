@@ -47,6 +47,8 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 
+#include "DQMOffline/Trigger/interface/HLTSummaryAggregator.h"
+
 
 
 using namespace std;
@@ -68,23 +70,42 @@ class HLTOverallSummary : public edm::EDAnalyzer {
       virtual void endJob() override ;
       virtual void beginRun(const edm::Run&, const edm::EventSetup&) override ;
       virtual void endRun(const edm::Run&, const edm::EventSetup&) override ;
+      virtual void endLuminosityBlock(const edm::LuminosityBlock&, const edm::EventSetup&) override ;
 
 
 
    private:
 
+      void bookSummary();
+      void updateSummary();
+
       DQMStore *dbe_;
       edm::ParameterSet parameters_;
 
       bool verbose_;
+      int prescaleLS_;
+      int counterLS_;
+
+      // Muon, Electron and Photon quality bits, in summary map order
+      HLTSummaryAggregator qualityBits_;
+
+      MonitorElement* hltQualityBit_;
+      MonitorElement* hltQualitySummaryWord_;
+      MonitorElement* reportSummaryMap_;
+      MonitorElement* CertificationSummaryMap_;
 
  // ----------member data ---------------------------
 };
 
 
 
-HLTOverallSummary::HLTOverallSummary(const edm::ParameterSet& pset)
-
+HLTOverallSummary::HLTOverallSummary(const edm::ParameterSet& pset):
+  counterLS_(0),
+  qualityBits_(1.0),
+  hltQualityBit_(0),
+  hltQualitySummaryWord_(0),
+  reportSummaryMap_(0),
+  CertificationSummaryMap_(0)
 {
 
   using namespace edm;
@@ -99,6 +120,11 @@ HLTOverallSummary::HLTOverallSummary(const edm::ParameterSet& pset)
   
   parameters_ = pset;
   verbose_ = parameters_.getUntrackedParameter<bool>("verbose", false);
+  prescaleLS_ = parameters_.getUntrackedParameter<int>("prescaleLS", -1);
+
+  qualityBits_.addSubsystem("HLT/EventInfo/reportSummaryContent/HLT_Muon");
+  qualityBits_.addSubsystem("HLT/EventInfo/reportSummaryContent/HLT_Electron");
+  qualityBits_.addSubsystem("HLT/EventInfo/reportSummaryContent/HLT_Photon");
   
   if(verbose_) LogInfo ("HLTMuonVal")  << ">>> Constructor (HLTOverallSummary) <<<" << endl;
 
@@ -145,6 +171,18 @@ HLTOverallSummary::beginRun(const edm::Run& run, const edm::EventSetup& c)
   if(verbose_) LogInfo ("HLTMuonVal")  << ">>> BeginRun (HLTOverallSummary) <<<" << std::endl;
   if(verbose_) LogInfo ("HLTMuonVal")  << ">>> "<< run.id() << std::endl;
 
+  qualityBits_.reset();
+}
+
+// ------------ method called at the end of each lumi section ------------
+void 
+HLTOverallSummary::endLuminosityBlock(const edm::LuminosityBlock& lumiSeg, const edm::EventSetup& c)
+{
+  counterLS_++;
+  if (prescaleLS_ < 1) return;
+  if (counterLS_ % prescaleLS_ != 0) return;
+
+  updateSummary();
 }
 
 // ------------ method called right after a run ends ------------
@@ -155,68 +193,25 @@ HLTOverallSummary::endRun(const edm::Run& run, const edm::EventSetup& c)
   using namespace edm;
   if(verbose_) LogInfo ("HLTMuonVal")  << ">>> EndRun (HLTOverallSummary) <<<" << std::endl;
 
-  if(!dbe_) {
-    LogInfo ("HLTMuonVal") << "No dqmstore... skipping processing step" << endl;
-    return;
-  }
-  
-  std::vector<string> histoNameVector;
-
- 
-  //booking histograms according to naming conventions
-
-  float defaultValueIfNotFound = 1.0;
-
-  dbe_->setCurrentFolder("HLT/EventInfo/reportSummaryContent");
-
-
-  //============ Unpack information ==========
-  
-
-  MonitorElement*  muonQualityBit = 0;
-  muonQualityBit = dbe_->get("HLT_Muon");
-
-  if (!muonQualityBit) {
-    LogInfo ("HLTMuonVal") << "Can't find muonQuality bit... making a bit, setting it to zero" << endl;
-
-    muonQualityBit = dbe_->bookFloat("HLT_Muon");
-    muonQualityBit->Fill(defaultValueIfNotFound);
-      
-  }
-                      
-  MonitorElement*  eleQualityBit = 0;
-  eleQualityBit = dbe_->get("HLT_Electron");
-
-  if (!eleQualityBit) {
-    LogInfo ("HLTMuonVal") << "Can't find eleQuality bit... making a bit, setting it to zero" << endl;
-
-    eleQualityBit = dbe_->bookFloat("HLT_Electron");
-    eleQualityBit->Fill(defaultValueIfNotFound);      
-  }
-
-  MonitorElement*  photonQualityBit = 0;
-  photonQualityBit = dbe_->get("HLT_Photon");
-
-  if (!photonQualityBit) {
-    LogInfo ("HLTMuonVal") << "Can't find photonQuality bit... making a bit, setting it to zero" << endl;
-
-    photonQualityBit = dbe_->bookFloat("HLT_Photon");
-    photonQualityBit->Fill(defaultValueIfNotFound);      
-  }
-
+  updateSummary();
+}
 
-  //============ Book new storage locations =============
+// ------------ books the summary elements, once ------------
+void 
+HLTOverallSummary::bookSummary()
+{
+  if (hltQualityBit_) return;
 
   dbe_->setCurrentFolder("HLT/EventInfo");
-  MonitorElement*  hltQualityBit = dbe_->bookFloat("reportSummary");
+  hltQualityBit_ = dbe_->bookFloat("reportSummary");
 
-  MonitorElement* hltQualitySummaryWord = dbe_->bookInt ("HLT_SUMMARY_WORD");
+  hltQualitySummaryWord_ = dbe_->bookInt ("HLT_SUMMARY_WORD");
 
   //for now these will hold values from eta/phi tests for spikes/holes
-  MonitorElement*  reportSummaryMap = dbe_->book2D("reportSummaryMap","HLT: ReportSummaryMap",3,-0.5,2.5,1,-0.5,0.5);
-  MonitorElement*  CertificationSummaryMap = dbe_->book2D("certificationSummaryMap","HLT: CertificationSummaryMap",3,-0.5,2.5,1,-0.5,0.5);
+  reportSummaryMap_ = dbe_->book2D("reportSummaryMap","HLT: ReportSummaryMap",3,-0.5,2.5,1,-0.5,0.5);
+  CertificationSummaryMap_ = dbe_->book2D("certificationSummaryMap","HLT: CertificationSummaryMap",3,-0.5,2.5,1,-0.5,0.5);
 
-  TH2 * reportSummaryMapTH2 = reportSummaryMap->getTH2F();
+  TH2 * reportSummaryMapTH2 = reportSummaryMap_->getTH2F();
 
   reportSummaryMapTH2->GetXaxis()->SetBinLabel(1,"Muon");
   reportSummaryMapTH2->GetXaxis()->SetBinLabel(2,"Electron");
@@ -225,22 +220,59 @@ HLTOverallSummary::endRun(const edm::Run& run, const edm::EventSetup& c)
   reportSummaryMapTH2->GetYaxis()->SetBinLabel(1,"Quality");
 
 
-  TH2 * CertificationSummaryMapTH2 = CertificationSummaryMap->getTH2F();
+  TH2 * CertificationSummaryMapTH2 = CertificationSummaryMap_->getTH2F();
 
   CertificationSummaryMapTH2->GetXaxis()->SetBinLabel(1,"Muon");    
   CertificationSummaryMapTH2->GetXaxis()->SetBinLabel(2,"Electron");  
   CertificationSummaryMapTH2->GetXaxis()->SetBinLabel(3,"Photon");                                                                          
   CertificationSummaryMapTH2->GetYaxis()->SetBinLabel(1,"Quality");
+}
+
+// ------------ refreshes the summary from the quality bits which changed ------------
+void 
+HLTOverallSummary::updateSummary()
+{
+  using namespace edm;
+
+  if(!dbe_) {
+    LogInfo ("HLTMuonVal") << "No dqmstore... skipping processing step" << endl;
+    return;
+  }
+
+  //booking histograms according to naming conventions
+
+  float defaultValueIfNotFound = 1.0;
+
+  //============ Unpack information ==========
 
+  qualityBits_.subscribe(*dbe_);
 
+  dbe_->setCurrentFolder("HLT/EventInfo/reportSummaryContent");
+  for (unsigned int i = 0; i < qualityBits_.size(); i++) {
+    if (qualityBits_.found(i)) continue;
+
+    const std::string& path = qualityBits_.path(i);
+    const std::string name = path.substr(path.rfind('/')+1);
+    LogInfo ("HLTMuonVal") << "Can't find " << name << " quality bit... making a bit, setting it to one" << endl;
+
+    MonitorElement* qualityBit = dbe_->bookFloat(name);
+    qualityBit->Fill(defaultValueIfNotFound);
+  }
+  qualityBits_.subscribe(*dbe_);
+
+  //============ Book new storage locations =============
+
+  bookSummary();
 
   //=================== Interpret bits and store result
 
-  float photonValue = photonQualityBit->getFloatValue();
+  if (!qualityBits_.update()) return;
+
+  float muonValue = qualityBits_.value(0);
   
-  float electronValue = eleQualityBit->getFloatValue();
+  float electronValue = qualityBits_.value(1);
 
-  float muonValue = muonQualityBit->getFloatValue();
+  float photonValue = qualityBits_.value(2);
 
   float hltOverallValue = 1.0;
   
@@ -256,7 +288,7 @@ HLTOverallSummary::endRun(const edm::Run& run, const edm::EventSetup& c)
     
   }
 
-  hltQualityBit->Fill(hltOverallValue);
+  hltQualityBit_->Fill(hltOverallValue);
 
   unsigned int hltSummaryValue = 0x0; //
 
@@ -268,25 +300,16 @@ HLTOverallSummary::endRun(const edm::Run& run, const edm::EventSetup& c)
   if (photonValue > 0.99) hltSummaryValue = hltSummaryValue | PHOTON_MASK;
   if (muonValue > 0.99) hltSummaryValue = hltSummaryValue | MUON_MASK;
 
-  hltQualitySummaryWord->Fill(hltSummaryValue);
-
-  reportSummaryMapTH2->SetBinContent(reportSummaryMapTH2->GetBin(1,1), muonValue);
-  reportSummaryMapTH2->SetBinContent(reportSummaryMapTH2->GetBin(2,1), electronValue);
-  reportSummaryMapTH2->SetBinContent(reportSummaryMapTH2->GetBin(3,1), photonValue);
-
-  CertificationSummaryMapTH2->SetBinContent(CertificationSummaryMapTH2->GetBin(1,1), muonValue);
-  CertificationSummaryMapTH2->SetBinContent(CertificationSummaryMapTH2->GetBin(2,1), electronValue);
-  CertificationSummaryMapTH2->SetBinContent(CertificationSummaryMapTH2->GetBin(3,1), photonValue);
-
-  
-
-
-  
-  
-    
-       
-  
+  hltQualitySummaryWord_->Fill(hltSummaryValue);
 
+  // the map x bins follow the order of the quality bits
+  TH2 * reportSummaryMapTH2 = reportSummaryMap_->getTH2F();
+  TH2 * CertificationSummaryMapTH2 = CertificationSummaryMap_->getTH2F();
+  for (unsigned int i = 0; i < qualityBits_.size(); i++) {
+    if (!qualityBits_.changed(i)) continue;
+    reportSummaryMapTH2->SetBinContent(reportSummaryMapTH2->GetBin(i+1,1), qualityBits_.value(i));
+    CertificationSummaryMapTH2->SetBinContent(CertificationSummaryMapTH2->GetBin(i+1,1), qualityBits_.value(i));
+  }
 }
 
 
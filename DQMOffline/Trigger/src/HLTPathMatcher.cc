@@ -0,0 +1,34 @@
+#include "DQMOffline/Trigger/interface/HLTPathMatcher.h"
+
+#include "FWCore/Common/interface/TriggerNames.h"
+#include "DataFormats/Common/interface/TriggerResults.h"
+
+HLTPathMatcher::HLTPathMatcher(const std::string& pattern, Mode mode):
+  pattern_(pattern),
+  mode_(mode)
+{
+  if(mode_ == Regex) regex_ = boost::regex(pattern_);
+}
+
+bool HLTPathMatcher::matches(const std::string& pathName) const {
+  if(mode_ == Regex) return boost::regex_search(pathName, regex_);
+  return pathName.find(pattern_) != std::string::npos;
+}
+
+const std::vector<unsigned int>& HLTPathMatcher::indices(const edm::TriggerNames& triggerNames) {
+  if(!parameterSetID_.isValid() || parameterSetID_ != triggerNames.parameterSetID()) {
+    parameterSetID_ = triggerNames.parameterSetID();
+    indices_.clear();
+    for(unsigned int i = 0; i < triggerNames.size(); ++i) {
+      if(matches(triggerNames.triggerName(i))) indices_.push_back(i);
+    }
+  }
+  return indices_;
+}
+
+bool HLTPathMatcher::accept(const edm::TriggerNames& triggerNames, const edm::TriggerResults& triggerResults) {
+  for(unsigned int i: indices(triggerNames)) {
+    if(triggerResults.wasrun(i) && triggerResults.accept(i)) return true;
+  }
+  return false;
+}
@@ -0,0 +1,70 @@
+#include "DQMOffline/Trigger/interface/HLTSummaryAggregator.h"
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+namespace {
+  // bit mask of the quality test outcomes attached to the ME
+  int qualityStatus(const MonitorElement* me) {
+    int status = 0;
+    if(me->hasError()) status |= 0x1;
+    if(me->hasWarning()) status |= 0x2;
+    if(me->hasOtherReport()) status |= 0x4;
+    return status;
+  }
+}
+
+HLTSummaryAggregator::HLTSummaryAggregator(float defaultValue):
+  defaultValue_(defaultValue),
+  isUpdated_(false)
+{}
+
+unsigned int HLTSummaryAggregator::addSubsystem(const std::string& mePath) {
+  Subsystem subsystem;
+  subsystem.path = mePath;
+  subsystem.me = 0;
+  subsystem.value = defaultValue_;
+  subsystem.qStatus = 0;
+  subsystem.changed = false;
+  subsystems_.push_back(subsystem);
+  return subsystems_.size()-1;
+}
+
+void HLTSummaryAggregator::subscribe(DQMStore& store) {
+  for(Subsystem& subsystem: subsystems_) {
+    if(!subsystem.me) subsystem.me = store.get(subsystem.path);
+  }
+}
+
+void HLTSummaryAggregator::reset() {
+  for(Subsystem& subsystem: subsystems_) {
+    subsystem.me = 0;
+    subsystem.value = defaultValue_;
+    subsystem.qStatus = 0;
+    subsystem.changed = false;
+  }
+  isUpdated_ = false;
+}
+
+bool HLTSummaryAggregator::update() {
+  bool anyChanged = false;
+  for(Subsystem& subsystem: subsystems_) {
+    const float value = subsystem.me ? subsystem.me->getFloatValue() : defaultValue_;
+    const int qStatus = subsystem.me ? qualityStatus(subsystem.me) : 0;
+    // the first update reports everything so the clients fill all their bins once
+    subsystem.changed = !isUpdated_ || value != subsystem.value || qStatus != subsystem.qStatus;
+    subsystem.value = value;
+    subsystem.qStatus = qStatus;
+    anyChanged |= subsystem.changed;
+  }
+  isUpdated_ = true;
+  return anyChanged;
+}
+
+unsigned int HLTSummaryAggregator::nrFound() const {
+  unsigned int nr = 0;
+  for(const Subsystem& subsystem: subsystems_) {
+    if(subsystem.me) ++nr;
+  }
+  return nr;
+}
@@ -74,8 +74,9 @@ void HLTTauDQMOfflineSource::dqmBeginRun(const edm::Run& iRun, const edm::EventS
       }
       std::sort(foundPaths.begin(), foundPaths.end());
 
-      // Construct path plotters
+      // Construct path plotters, the ones of the previous menu are dropped
       std::vector<const HLTTauDQMPath *> pathObjects;
+      pathPlotters_.clear();
       pathPlotters_.reserve(foundPaths.size());
       pathObjects.reserve(foundPaths.size());
       for(const std::string& pathName: foundPaths) {
@@ -151,6 +152,7 @@ void HLTTauDQMOfflineSource::analyze(const Event& iEvent, const EventSetup& iSet
               refC.met.insert(refC.met.end(), collHandle->begin(), collHandle->end());
             }
           }
+          refC.buildEtaPhi();
         }
         
         //Path Plotters
@@ -15,6 +15,7 @@
 #include<cstdio>
 #include<sstream>
 #include<algorithm>
+#include<map>
 
 namespace {
   // Used as a helper only in this file
@@ -209,130 +210,150 @@ namespace {
     int met;
     int level;
   };
+
+  // Filter module types known to the multiplicity inference
+  enum class FilterKind {
+    Unknown, Prescaler, L1Seed, CaloMET, CaloJet, PFJet, CaloJetTag, Tau, PFTauPair,
+    EgammaGeneric, ElectronGeneric, MuonL2, MuonL3, MuonGeneric, ElectronTau, MuonTau
+  };
+  FilterKind filterKind(const std::string& moduleType) {
+    static const std::map<std::string, FilterKind> kinds = {
+      {"HLTL1TSeed", FilterKind::L1Seed},
+      {"HLT1CaloMET", FilterKind::CaloMET},
+      {"HLT1CaloJet", FilterKind::CaloJet},
+      {"HLT1PFJet", FilterKind::PFJet},
+      {"HLTCaloJetTag", FilterKind::CaloJetTag},
+      {"HLT1Tau", FilterKind::Tau},
+      {"HLT1PFTau", FilterKind::Tau},
+      {"HLTPFTauPairDzMatchFilter", FilterKind::PFTauPair},
+      {"HLTEgammaGenericFilter", FilterKind::EgammaGeneric},
+      {"HLTElectronGenericFilter", FilterKind::ElectronGeneric},
+      {"HLTMuonL2PreFilter", FilterKind::MuonL2},
+      {"HLTMuonIsoFilter", FilterKind::MuonL3},
+      {"HLTMuonL3PreFilter", FilterKind::MuonL3},
+      {"HLTMuonGenericFilter", FilterKind::MuonGeneric},
+      {"HLT2ElectronTau", FilterKind::ElectronTau},
+      {"HLT2ElectronPFTau", FilterKind::ElectronTau},
+      {"HLT2PhotonTau", FilterKind::ElectronTau},
+      {"HLT2PhotonPFTau", FilterKind::ElectronTau},
+      {"HLT2MuonTau", FilterKind::MuonTau},
+      {"HLT2MuonPFTau", FilterKind::MuonTau},
+      {"HLTPrescaler", FilterKind::Prescaler}
+    };
+    auto found = kinds.find(moduleType);
+    return found != kinds.end() ? found->second : FilterKind::Unknown;
+  }
+
   TauLeptonMultiplicity inferTauLeptonMultiplicity(const HLTConfigProvider& HLTCP, const std::string& filterName, const std::string& moduleType, const std::string& pathName) {
     TauLeptonMultiplicity n;
-    //std::cout << "check menu " << HLTCP.tableName() << std::endl;
-    if(moduleType == "HLTL1TSeed") {
+    switch(filterKind(moduleType)) {
+    case FilterKind::L1Seed:
+      // the L1 seed multiplicities can only be guessed from the module label
       n.level = 1;
       if(filterName.find("Single") != std::string::npos) {
-	if(filterName.find("Mu") != std::string::npos) {
-	  n.muon = 1;
-	}
-	else if(filterName.find("EG") != std::string::npos) {
-	  n.electron = 1;
-	}
+        if(filterName.find("Mu") != std::string::npos) {
+          n.muon = 1;
+        }
+        else if(filterName.find("EG") != std::string::npos) {
+          n.electron = 1;
+        }
       }
       else if(filterName.find("Double") != std::string::npos && filterName.find("Tau") != std::string::npos) {
         n.tau = 2;
       }
-//      else if(filterName.find("Mu") != std::string::npos && filterName.find("Tau") != std::string::npos) {
       if(filterName.find("Mu") != std::string::npos) { 
-	n.muon = 1;
-	//n.tau = 1;
+        n.muon = 1;
       }
       if(filterName.find("EG") != std::string::npos && filterName.find("Tau") != std::string::npos) { 
-	n.electron = 1;
-	//n.tau = 1;
+        n.electron = 1;
       }
       if(filterName.find("ETM") != std::string::npos) {
-	n.met = 1;
+        n.met = 1;
       }
-    }
-    else if(moduleType == "HLT1CaloMET") {
+      break;
+    case FilterKind::CaloMET:
       n.level = 2;
       if(getParameterSafe(HLTCP, filterName, "triggerType") == trigger::TriggerMET) {
         n.met = 1;
       }
-    }
-    else if(moduleType == "HLT1CaloJet") {
+      break;
+    case FilterKind::CaloJet:
       n.level = 2;
       if(getParameterSafe(HLTCP, filterName, "triggerType") == trigger::TriggerTau) {
         n.tau = getParameterSafe(HLTCP, filterName, "MinN");
       }
-    }
-    else if(moduleType == "HLT1PFJet") {
+      break;
+    case FilterKind::PFJet:
       n.level = 3;
-      //const edm::ParameterSet& pset = HLTCP.modulePSet(filterName);
-      //pset.getParameter<int>("triggerType") == trigger::TriggerTau) {
       if(getParameterSafe(HLTCP, filterName, "triggerType") == trigger::TriggerTau) {
-        //n.tau = pset.getParameter<int>("MinN");
         n.tau = getParameterSafe(HLTCP, filterName, "MinN");
       }
-    }
-    else if(moduleType == "HLTCaloJetTag") {
+      break;
+    case FilterKind::CaloJetTag:
       n.level = 2;
-      //const edm::ParameterSet& pset = HLTCP.modulePSet(filterName);
-      //if(pset.getParameter<int>("triggerType") == trigger::TriggerTau) {
       if(getParameterSafe(HLTCP, filterName, "TriggerType") == trigger::TriggerTau) {
-        //n.tau = pset.getParameter<int>("MinJets");
         n.tau = getParameterSafe(HLTCP, filterName, "MinJets");
       }
-    }
-    else if(moduleType == "HLT1Tau" || moduleType == "HLT1PFTau") {
+      break;
+    case FilterKind::Tau:
       n.level = 3;
-      //n.tau = HLTCP.modulePSet(filterName).getParameter<int>("MinN");
       n.tau = getParameterSafe(HLTCP, filterName, "MinN");
-    }
-    else if(moduleType == "HLTPFTauPairDzMatchFilter") {
+      break;
+    case FilterKind::PFTauPair:
       n.level = 3;
       n.tau = 2;
-    }
-    else if(moduleType == "HLTEgammaGenericFilter") {
-      n.level = 3;
-      n.electron = getParameterSafe(HLTCP, filterName, "ncandcut");
-    }
-    else if(moduleType == "HLTElectronGenericFilter") {
+      break;
+    case FilterKind::EgammaGeneric:
+    case FilterKind::ElectronGeneric:
       n.level = 3;
-      //n.electron = HLTCP.modulePSet(filterName).getParameter<int>("ncandcut");
       n.electron = getParameterSafe(HLTCP, filterName, "ncandcut");
-    }
-    else if(moduleType == "HLTMuonL2PreFilter") {
+      break;
+    case FilterKind::MuonL2:
       n.level = 2;
-      //n.muon = HLTCP.modulePSet(filterName).getParameter<int>("MinN");
       n.muon = getParameterSafe(HLTCP, filterName, "MinN");
-    }
-    else if(moduleType == "HLTMuonIsoFilter" || moduleType == "HLTMuonL3PreFilter") {
+      break;
+    case FilterKind::MuonL3:
       n.level = 3;
       n.muon = getParameterSafe(HLTCP, filterName, "MinN");
-    }
-    else if(moduleType == "HLTMuonGenericFilter") {
+      break;
+    case FilterKind::MuonGeneric:
       n.level = 3;
       n.muon = 1;
-    }
-    else if(moduleType == "HLT2ElectronTau" || moduleType == "HLT2ElectronPFTau" || moduleType == "HLT2PhotonTau" || moduleType == "HLT2PhotonPFTau") {
+      break;
+    case FilterKind::ElectronTau:
       n.level = 3;
-      //int num = HLTCP.modulePSet(filterName).getParameter<int>("MinN");
-      int num = getParameterSafe(HLTCP, filterName, "MinN");
-      n.tau = num;
-      n.electron = num;
-    }
-    else if(moduleType == "HLT2MuonTau" || moduleType == "HLT2MuonPFTau") {
+      n.tau = n.electron = getParameterSafe(HLTCP, filterName, "MinN");
+      break;
+    case FilterKind::MuonTau:
       n.level = 3;
-      //int num = HLTCP.modulePSet(filterName).getParameter<int>("MinN");
-      int num = getParameterSafe(HLTCP, filterName, "MinN");
-      n.tau = num;
-      n.muon = num;
-    }
-    else if(moduleType == "HLTPrescaler"){// || moduleType == "HLT1CaloMET") {
+      n.tau = n.muon = getParameterSafe(HLTCP, filterName, "MinN");
+      break;
+    case FilterKind::Prescaler:
       // ignore
-    }
-    else {
+      break;
+    case FilterKind::Unknown:
       edm::LogInfo("HLTTauDQMOfflineSource") << "HLTTauDQMPath.cc, inferTauLeptonMultiplicity(): module type '" << moduleType << "' not recognized, filter '" << filterName << "' in path '" << pathName << "' will be ignored for offline matching." << std::endl;
+      break;
     }
     return n;
   }
 
-  template <typename T1, typename T2>
-  bool deltaRmatch(const T1& obj, const std::vector<T2>& refColl, double dR, std::vector<bool>& refMask, std::vector<T2>& matchedRefs) {
+  bool contains(const std::string& name, const char* part) {
+    return name.find(part) != std::string::npos;
+  }
+
+  // Closest not yet matched reference object, the eta and phi of the
+  // references are taken from the precomputed columns
+  bool deltaRmatch(const trigger::TriggerObject& obj, const std::vector<LV>& refColl, const HLTTauDQMOfflineObjects::EtaPhi& refEtaPhi, double dR, std::vector<bool>& refMask, std::vector<LV>& matchedRefs) {
     double minDr = 2*dR;
     size_t found = refColl.size();
-    //std::cout << "Matching with DR " << dR << ", obj eta " << obj.eta() << " phi " << obj.phi() << std::endl;
+    const double eta = obj.eta();
+    const double phi = obj.phi();
     for(size_t i=0; i<refColl.size(); ++i) {
       if(!refMask[i])
         continue;
 
-      double dr = reco::deltaR(obj, refColl[i]);
-      //std::cout << "  " << i << " ref eta " << refColl[i].eta() << " phi " << refColl[i].phi() << " dr " << dr << std::endl;
+      double dr = reco::deltaR(eta, phi, refEtaPhi.eta[i], refEtaPhi.phi[i]);
       if(dr < minDr) {
         minDr = dr;
         found = i;
@@ -345,6 +366,14 @@ namespace {
     }
     return false;
   }
+
+  // The columns of refs, computed in scratch if the caller did not build them
+  const HLTTauDQMOfflineObjects::EtaPhi& etaPhi(const std::vector<LV>& refs, const HLTTauDQMOfflineObjects::EtaPhi& columns, HLTTauDQMOfflineObjects::EtaPhi& scratch) {
+    if(columns.eta.size() == refs.size())
+      return columns;
+    scratch.fill(refs);
+    return scratch;
+  }
 }
 
 
@@ -369,38 +398,41 @@ HLTTauDQMPath::HLTTauDQMPath(const std::string& pathName, const std::string& hlt
 #endif
   // Get the filters
   HLTPath thePath(pathName_);
-  filterIndices_ = thePath.interestingFilters(HLTCP, doRefAnalysis_);
-  if(filterIndices_.empty()) {
+  const std::vector<FilterIndex> filterIndices = thePath.interestingFilters(HLTCP, doRefAnalysis_);
+  if(filterIndices.empty()) {
     edm::LogInfo("HLTTauDQMOffline") << "HLTTauDQMPath: " << pathName_ << " no interesting filters found";
     return;
   }
-  isFirstL1Seed_ = HLTCP.moduleType(std::get<kName>(filterIndices_[0])) == "HLTL1TSeed";
+  isFirstL1Seed_ = HLTCP.moduleType(std::get<kName>(filterIndices[0])) == "HLTL1TSeed";
 #ifdef EDM_ML_DEBUG
   ss << "  Interesting filters (preceded by the module index in the path)";
 #endif
-  // Set the filter multiplicity counts
-  filterTauN_.clear();
-  filterElectronN_.clear();
-  filterMuonN_.clear();
-  filterMET_.clear();
-  filterTauN_.reserve(filterIndices_.size());
-  filterElectronN_.reserve(filterIndices_.size());
-  filterMuonN_.reserve(filterIndices_.size());
-  filterMET_.reserve(filterIndices_.size());
-  filterLevel_.reserve(filterIndices_.size());
-  for(size_t i=0; i<filterIndices_.size(); ++i) {
-    const std::string& filterName = std::get<kName>(filterIndices_[i]);
+  // Resolve everything the event loop needs about the filters once
+  filters_.clear();
+  filters_.reserve(filterIndices.size());
+  for(size_t i=0; i<filterIndices.size(); ++i) {
+    const std::string& filterName = std::get<kName>(filterIndices[i]);
     const std::string& moduleType = HLTCP.moduleType(filterName);
 
     TauLeptonMultiplicity n = inferTauLeptonMultiplicity(HLTCP, filterName, moduleType, pathName_);
-    filterTauN_.push_back(n.tau);
-    filterElectronN_.push_back(n.electron);
-    filterMuonN_.push_back(n.muon);
-    filterMET_.push_back(n.met);
-    filterLevel_.push_back(n.level);
+    Filter filter;
+    filter.name = filterName;
+    filter.type = std::get<kType>(filterIndices[i]);
+    filter.moduleIndex = std::get<kModuleIndex>(filterIndices[i]);
+    filter.tag = edm::InputTag(filterName, "", hltProcess_);
+    filter.nTaus = n.tau;
+    filter.nElectrons = n.electron;
+    filter.nMuons = n.muon;
+    filter.nMET = n.met;
+    filter.level = n.level;
+    filter.isMETFilter = contains(filterName, "hltMET");
+    filter.isL3MuonFilter = filter.type == "HLTMuonL3PreFilter" || filter.type == "HLTMuonIsoFilter";
+    filter.isElectronFilter = contains(filterName, "hltEle");
+    filter.isTauFilter = contains(filterName, "hltPFTau") || contains(filterName, "hltDoublePFTau");
+    filters_.push_back(filter);
 
 #ifdef EDM_ML_DEBUG  
-    ss << "\n    " << i << " " << std::get<kModuleIndex>(filterIndices_[i])
+    ss << "\n    " << i << " " << filter.moduleIndex
        << " " << filterName
        << " " << moduleType
        << " ntau " << n.tau
@@ -415,7 +447,7 @@ HLTTauDQMPath::HLTTauDQMPath(const std::string& pathName, const std::string& hlt
   // Find the position of tau producer, use filters with taus before
   // it for L2 tau efficiency, and filters with taus after it for L3
   // tau efficiency. Here we have to take into account that for
-  // reference-matched case filterIndices_ contains only those filters
+  // reference-matched case filters_ contains only those filters
   // that have saveTags=True, while for searching the first L3 tau
   // filter we have to consider all filters
   const size_t firstL3TauFilterIndex = thePath.firstL3TauFilterIndex(HLTCP);
@@ -541,26 +573,19 @@ bool HLTTauDQMPath::fired(const edm::TriggerResults& triggerResults) const {
 int HLTTauDQMPath::lastPassedFilter(const edm::TriggerResults& triggerResults) const {
 
   if(fired(triggerResults)) {
-    //std::cout << "Event passed" << std::endl;
-    return filterIndices_.size()-1;
+    return filters_.size()-1;
   }
 
-  unsigned int firstFailedFilter = triggerResults.index(pathIndex_);
-  int lastPassedFilter = -1;
-  for(size_t i=0; i<filterIndices_.size(); ++i) {
-    if(std::get<kModuleIndex>(filterIndices_[i]) < firstFailedFilter) {
-      lastPassedFilter = i;
-    }
-    else {
-      //std::cout << "Decision-making filter " << firstFailedFilter << " this " << std::get<kModuleIndex>(filterIndices_[i]) << std::endl;
-      break;
-    }
-  }
-  return lastPassedFilter;
+  // the filters are ordered by their module index in the path
+  const unsigned int firstFailedFilter = triggerResults.index(pathIndex_);
+  auto firstNotPassed = std::partition_point(filters_.begin(), filters_.end(), [&](const Filter& filter) {
+      return filter.moduleIndex < firstFailedFilter;
+    });
+  return static_cast<int>(firstNotPassed - filters_.begin()) - 1;
 }
 
 void HLTTauDQMPath::getFilterObjects(const trigger::TriggerEvent& triggerEvent, size_t i, std::vector<Object>& retval) const {
-  trigger::size_type filterIndex = triggerEvent.filterIndex(edm::InputTag(getFilterName(i), "", hltProcess_));
+  trigger::size_type filterIndex = triggerEvent.filterIndex(filters_[i].tag);
   if(filterIndex != triggerEvent.sizeFilters()) {
     const trigger::Keys& keys = triggerEvent.filterKeys(filterIndex);
     const trigger::Vids& ids = triggerEvent.filterIds(filterIndex);
@@ -573,73 +598,50 @@ void HLTTauDQMPath::getFilterObjects(const trigger::TriggerEvent& triggerEvent,
 }
 
 bool HLTTauDQMPath::offlineMatching(size_t i, const std::vector<Object>& triggerObjects, const HLTTauDQMOfflineObjects& offlineObjects, double dR, std::vector<Object>& matchedTriggerObjects, HLTTauDQMOfflineObjects& matchedOfflineObjects) const {
-  bool isL1 = (i==0 && isFirstL1Seed_);
-  std::vector<bool> offlineMask;
-  if(filterTauN_[i] > 0) {
-    int matchedObjects = 0;
-    offlineMask.resize(offlineObjects.taus.size());
-    std::fill(offlineMask.begin(), offlineMask.end(), true);
-    for(const Object& trgObj: triggerObjects) {
-      //std::cout << "trigger object id " << isL1 << " " << trgObj.id << " " << trigger::TriggerL1Tau << " "<< trigger::TriggerTau << std::endl;
-      if(! ((isL1 && trgObj.id == trigger::TriggerL1Tau) || trgObj.id == trigger::TriggerTau ) )
-        continue;
-      if(deltaRmatch(trgObj.object, offlineObjects.taus, dR, offlineMask, matchedOfflineObjects.taus)) {
-        ++matchedObjects;
-        matchedTriggerObjects.emplace_back(trgObj);
-        //std::cout << "trigger object DR match" << std::endl;
-      }
-    }
-    if(matchedObjects < filterTauN_[i])
-      return false;
-  }
-  if(filterElectronN_[i] > 0) {
-    int matchedObjects = 0;
-    offlineMask.resize(offlineObjects.electrons.size());
-    std::fill(offlineMask.begin(), offlineMask.end(), true);
-    for(const Object& trgObj: triggerObjects) {
-      //std::cout << "trigger object id " << trgObj.id << std::endl;
-      if(! ((isL1 && (trgObj.id == trigger::TriggerL1EG))
-            || trgObj.id == trigger::TriggerElectron || trgObj.id == trigger::TriggerPhoton) )
-        continue;
-      if(deltaRmatch(trgObj.object, offlineObjects.electrons, dR, offlineMask, matchedOfflineObjects.electrons)) {
-        ++matchedObjects;
-        matchedTriggerObjects.emplace_back(trgObj);
-      }
-    }
-    if(matchedObjects < filterElectronN_[i])
-      return false;
+  const Filter& filter = filters_[i];
+  const bool isL1 = (i==0 && isFirstL1Seed_);
+
+  // Partition the trigger objects by type in one pass, keeping their order
+  for(auto& objects: typeObjects_)
+    objects.clear();
+  for(size_t iObj=0; iObj<triggerObjects.size(); ++iObj) {
+    const int id = triggerObjects[iObj].id;
+    if((isL1 && id == trigger::TriggerL1Tau) || id == trigger::TriggerTau)
+      typeObjects_[kTauObjects].push_back(iObj);
+    else if((isL1 && id == trigger::TriggerL1EG) || id == trigger::TriggerElectron || id == trigger::TriggerPhoton)
+      typeObjects_[kElectronObjects].push_back(iObj);
+    else if((isL1 && id == trigger::TriggerL1Mu) || id == trigger::TriggerMuon)
+      typeObjects_[kMuonObjects].push_back(iObj);
+    else if((isL1 && id == trigger::TriggerL1ETM) || id == trigger::TriggerMET)
+      typeObjects_[kMETObjects].push_back(iObj);
   }
-  if(filterMuonN_[i] > 0) {
+
+  auto matchType = [&](size_t type, int nRequired, const std::vector<LV>& refs, const HLTTauDQMOfflineObjects::EtaPhi& refColumns, std::vector<LV>& matchedRefs) {
+    const HLTTauDQMOfflineObjects::EtaPhi& refEtaPhi = etaPhi(refs, refColumns, refEtaPhi_);
+    offlineMask_.assign(refs.size(), true);
     int matchedObjects = 0;
-    offlineMask.resize(offlineObjects.muons.size());
-    std::fill(offlineMask.begin(), offlineMask.end(), true);
-    for(const Object& trgObj: triggerObjects) {
-      //std::cout << "trigger object id " << trgObj.id << std::endl;
-      if(! ((isL1 && trgObj.id == trigger::TriggerL1Mu)
-            || trgObj.id == trigger::TriggerMuon) )
-        continue;
-      if(deltaRmatch(trgObj.object, offlineObjects.muons, dR, offlineMask, matchedOfflineObjects.muons)) {
+    for(size_t iObj: typeObjects_[type]) {
+      const Object& trgObj = triggerObjects[iObj];
+      if(deltaRmatch(trgObj.object, refs, refEtaPhi, dR, offlineMask_, matchedRefs)) {
         ++matchedObjects;
         matchedTriggerObjects.emplace_back(trgObj);
       }
     }
-    if(matchedObjects < filterMuonN_[i])
-      return false;
-  }
-  if(filterMET_[i] > 0) {
-    int matchedObjects = 0;
-    offlineMask.resize(offlineObjects.met.size());
-    std::fill(offlineMask.begin(), offlineMask.end(), true);
-    for(const Object& trgObj: triggerObjects) {
-      if(! ((isL1 && trgObj.id == trigger::TriggerL1ETM)
-            || trgObj.id == trigger::TriggerMET) )
-        continue;
-      ++matchedObjects;
-      matchedTriggerObjects.emplace_back(trgObj);
-    }
-    if(matchedObjects < filterMET_[i]){
+    return matchedObjects >= nRequired;
+  };
+
+  if(filter.nTaus > 0 && !matchType(kTauObjects, filter.nTaus, offlineObjects.taus, offlineObjects.tauEtaPhi, matchedOfflineObjects.taus))
+    return false;
+  if(filter.nElectrons > 0 && !matchType(kElectronObjects, filter.nElectrons, offlineObjects.electrons, offlineObjects.electronEtaPhi, matchedOfflineObjects.electrons))
+    return false;
+  if(filter.nMuons > 0 && !matchType(kMuonObjects, filter.nMuons, offlineObjects.muons, offlineObjects.muonEtaPhi, matchedOfflineObjects.muons))
+    return false;
+  if(filter.nMET > 0) {
+    // MET is not matched in deltaR, all trigger MET objects count
+    for(size_t iObj: typeObjects_[kMETObjects])
+      matchedTriggerObjects.emplace_back(triggerObjects[iObj]);
+    if(static_cast<int>(typeObjects_[kMETObjects].size()) < filter.nMET)
       return false;
-    }
   }
 
   // Sort offline objects by pt
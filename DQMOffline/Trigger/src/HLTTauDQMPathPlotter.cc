@@ -123,7 +123,7 @@ void HLTTauDQMPathPlotter::bookHistograms(DQMStore::IBooker &iBooker) {
     int nmet = 0;
     int lastMatchedMETFilter = -1;
     for(size_t i = 0; i < hltPath_.filtersSize(); ++i){
-        if(hltPath_.getFilterName(i).find("hltMET") < hltPath_.getFilterName(i).length()) lastMatchedMETFilter = i;
+        if(hltPath_.getFilter(i).isMETFilter) lastMatchedMETFilter = i;
     }
     if(lastMatchedMETFilter >= 0) nmet = hltPath_.getFilterMET(lastMatchedMETFilter);
     auto create = [&](const std::string& name) {
@@ -163,10 +163,30 @@ void HLTTauDQMPathPlotter::bookHistograms(DQMStore::IBooker &iBooker) {
 
 HLTTauDQMPathPlotter::~HLTTauDQMPathPlotter() {}
 
+// Offline objects matched to the objects of filter i with hltMatchDr_, null if
+// the matching fails. The filters up to lastMatchedFilter were already matched
+// in this event, their result is reused when it was obtained with the same deltaR.
+const HLTTauDQMOfflineObjects *HLTTauDQMPathPlotter::matchedFilterObjects(size_t i, int lastMatchedFilter, const trigger::TriggerEvent& triggerEvent, const HLTTauDQMOfflineObjects& refCollection) {
+  if(static_cast<int>(i) <= lastMatchedFilter && filterMatchDr_[i] == hltMatchDr_)
+    return &filterMatches_[i];
+
+  triggerObjs_.clear();
+  matchedTriggerObjs_.clear();
+  matchedOfflineObjs_.clear();
+  hltPath_.getFilterObjects(triggerEvent, i, triggerObjs_);
+  if(hltPath_.offlineMatching(i, triggerObjs_, refCollection, hltMatchDr_, matchedTriggerObjs_, matchedOfflineObjs_))
+    return &matchedOfflineObjs_;
+  return nullptr;
+}
+
 void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, const trigger::TriggerEvent& triggerEvent, const HLTTauDQMOfflineObjects& refCollection) {
-  std::vector<HLTTauDQMPath::Object> triggerObjs;
-  std::vector<HLTTauDQMPath::Object> matchedTriggerObjs;
-  HLTTauDQMOfflineObjects matchedOfflineObjs;
+  // the object vectors are kept between events to reuse their memory
+  std::vector<HLTTauDQMPath::Object>& triggerObjs = triggerObjs_;
+  std::vector<HLTTauDQMPath::Object>& matchedTriggerObjs = matchedTriggerObjs_;
+  HLTTauDQMOfflineObjects& matchedOfflineObjs = matchedOfflineObjs_;
+  triggerObjs.clear();
+  matchedTriggerObjs.clear();
+  matchedOfflineObjs.clear();
 
   // Events per filter
   const int lastPassedFilter = hltPath_.lastPassedFilter(triggerResults);
@@ -178,27 +198,29 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
   int firstMatchedMETFilter = -1;
 
   if(doRefAnalysis_) {
+    filterMatches_.resize(hltPath_.filtersSize());
+    filterMatchDr_.resize(hltPath_.filtersSize());
     double matchDr = hltPath_.isFirstFilterL1Seed() ? l1MatchDr_ : hltMatchDr_;
     for(int i=0; i<=lastPassedFilter; ++i) {
       triggerObjs.clear();
       matchedTriggerObjs.clear();
-      matchedOfflineObjs.clear();
+      // the matches are kept for the efficiency numerators below
+      filterMatches_[i].clear();
       hltPath_.getFilterObjects(triggerEvent, i, triggerObjs);
-      //std::cout << "Filter name " << hltPath_.getFilterName(i) << " nobjs " << triggerObjs.size() << " " << "ref size " << refCollection.taus.size() << std::endl;
-      bool matched = hltPath_.offlineMatching(i, triggerObjs, refCollection, matchDr, matchedTriggerObjs, matchedOfflineObjs);
-      //std::cout << "  offline matching: " << matched << " " << matchedTriggerObjs.size() << std::endl;
+      bool matched = hltPath_.offlineMatching(i, triggerObjs, refCollection, matchDr, matchedTriggerObjs, filterMatches_[i]);
+      filterMatchDr_[i] = matchDr;
       matchDr = hltMatchDr_;
       if(!matched)
         break;
 
       hAcceptedEvents_->Fill(i+0.5);
       lastMatchedFilter = i;
-      if(hltPath_.getFilterName(i).find("hltMET") < hltPath_.getFilterName(i).length())      lastMatchedMETFilter = i;
-      if(hltPath_.getFilterType(i) == "HLTMuonL3PreFilter" || hltPath_.getFilterType(i) == "HLTMuonIsoFilter") lastMatchedMuonFilter = i;
-      if(hltPath_.getFilterName(i).find("hltEle") < hltPath_.getFilterName(i).length()) lastMatchedElectronFilter = i;
-      if(hltPath_.getFilterName(i).find("hltPFTau") < hltPath_.getFilterName(i).length() || 
-         hltPath_.getFilterName(i).find("hltDoublePFTau") < hltPath_.getFilterName(i).length())    lastMatchedTauFilter = i;
-      if(firstMatchedMETFilter < 0 && hltPath_.getFilterName(i).find("hltMET") < hltPath_.getFilterName(i).length()) firstMatchedMETFilter = i;
+      const HLTTauDQMPath::Filter& filter = hltPath_.getFilter(i);
+      if(filter.isMETFilter)      lastMatchedMETFilter = i;
+      if(filter.isL3MuonFilter)   lastMatchedMuonFilter = i;
+      if(filter.isElectronFilter) lastMatchedElectronFilter = i;
+      if(filter.isTauFilter)      lastMatchedTauFilter = i;
+      if(firstMatchedMETFilter < 0 && filter.isMETFilter) firstMatchedMETFilter = i;
     }
   }
   else {
@@ -223,13 +245,9 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
 
       // Numerators
       if(static_cast<size_t>(lastMatchedFilter) >= hltPath_.getLastL2TauFilterIndex()) {
-        triggerObjs.clear();
-        matchedTriggerObjs.clear();
-        matchedOfflineObjs.clear();
-        hltPath_.getFilterObjects(triggerEvent, hltPath_.getLastL2TauFilterIndex(), triggerObjs);
-        bool matched = hltPath_.offlineMatching(hltPath_.getLastL2TauFilterIndex(), triggerObjs, refCollection, hltMatchDr_, matchedTriggerObjs, matchedOfflineObjs);
-        if(matched) {
-          for(const LV& tau: matchedOfflineObjs.taus) {
+        const HLTTauDQMOfflineObjects *filterMatched = matchedFilterObjects(hltPath_.getLastL2TauFilterIndex(), lastMatchedFilter, triggerEvent, refCollection);
+        if(filterMatched) {
+          for(const LV& tau: filterMatched->taus) {
             hL2TrigTauEtEffNum_->Fill(tau.pt());
             hL2TrigTauHighEtEffNum_->Fill(tau.pt());
             hL2TrigTauEtaEffNum_->Fill(tau.eta());
@@ -253,13 +271,9 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
 
       // Numerators
       if(static_cast<size_t>(lastMatchedFilter) >= hltPath_.getLastL3TauFilterIndex()) {
-        triggerObjs.clear();
-        matchedTriggerObjs.clear();
-        matchedOfflineObjs.clear();
-        hltPath_.getFilterObjects(triggerEvent, hltPath_.getLastL3TauFilterIndex(), triggerObjs);
-        bool matched = hltPath_.offlineMatching(hltPath_.getLastL3TauFilterIndex(), triggerObjs, refCollection, hltMatchDr_, matchedTriggerObjs, matchedOfflineObjs);
-        if(matched) {
-          for(const LV& tau: matchedOfflineObjs.taus) {
+        const HLTTauDQMOfflineObjects *filterMatched = matchedFilterObjects(hltPath_.getLastL3TauFilterIndex(), lastMatchedFilter, triggerEvent, refCollection);
+        if(filterMatched) {
+          for(const LV& tau: filterMatched->taus) {
             hL3TrigTauEtEffNum_->Fill(tau.pt());
             hL3TrigTauHighEtEffNum_->Fill(tau.pt());
             hL3TrigTauEtaEffNum_->Fill(tau.eta());
@@ -282,13 +296,9 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
 
       // Numerators
       if(static_cast<size_t>(lastMatchedFilter) >= hltPath_.getLastL2ElectronFilterIndex()) {
-        triggerObjs.clear();
-        matchedTriggerObjs.clear();
-        matchedOfflineObjs.clear();
-        hltPath_.getFilterObjects(triggerEvent, hltPath_.getLastL2ElectronFilterIndex(), triggerObjs);
-        bool matched = hltPath_.offlineMatching(hltPath_.getLastL2ElectronFilterIndex(), triggerObjs, refCollection, hltMatchDr_, matchedTriggerObjs, matchedOfflineObjs);
-        if(matched) {
-          for(const LV& electron: matchedOfflineObjs.electrons) {
+        const HLTTauDQMOfflineObjects *filterMatched = matchedFilterObjects(hltPath_.getLastL2ElectronFilterIndex(), lastMatchedFilter, triggerEvent, refCollection);
+        if(filterMatched) {
+          for(const LV& electron: filterMatched->electrons) {
             hL2TrigElectronEtEffNum_->Fill(electron.pt());
             hL2TrigElectronEtaEffNum_->Fill(electron.eta());
             hL2TrigElectronPhiEffNum_->Fill(electron.phi());
@@ -310,13 +320,9 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
        
       // Numerators
       if(static_cast<size_t>(lastMatchedFilter) >= hltPath_.getLastL3ElectronFilterIndex()) {
-        triggerObjs.clear();
-        matchedTriggerObjs.clear();
-        matchedOfflineObjs.clear();
-        hltPath_.getFilterObjects(triggerEvent, hltPath_.getLastL3ElectronFilterIndex(), triggerObjs);
-        bool matched = hltPath_.offlineMatching(hltPath_.getLastL3ElectronFilterIndex(), triggerObjs, refCollection, hltMatchDr_, matchedTriggerObjs, matchedOfflineObjs);
-        if(matched) {
-          for(const LV& electron: matchedOfflineObjs.electrons) {
+        const HLTTauDQMOfflineObjects *filterMatched = matchedFilterObjects(hltPath_.getLastL3ElectronFilterIndex(), lastMatchedFilter, triggerEvent, refCollection);
+        if(filterMatched) {
+          for(const LV& electron: filterMatched->electrons) {
             hL3TrigElectronEtEffNum_->Fill(electron.pt());
             hL3TrigElectronEtaEffNum_->Fill(electron.eta());  
             hL3TrigElectronPhiEffNum_->Fill(electron.phi());
@@ -338,13 +344,9 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
 
       // Numerators
       if(static_cast<size_t>(lastMatchedFilter) >= hltPath_.getLastL2MuonFilterIndex()) {
-        triggerObjs.clear();
-        matchedTriggerObjs.clear();
-        matchedOfflineObjs.clear();
-        hltPath_.getFilterObjects(triggerEvent, hltPath_.getLastL2MuonFilterIndex(), triggerObjs);
-        bool matched = hltPath_.offlineMatching(hltPath_.getLastL2MuonFilterIndex(), triggerObjs, refCollection, hltMatchDr_, matchedTriggerObjs, matchedOfflineObjs);
-        if(matched) {
-          for(const LV& muon: matchedOfflineObjs.muons) {
+        const HLTTauDQMOfflineObjects *filterMatched = matchedFilterObjects(hltPath_.getLastL2MuonFilterIndex(), lastMatchedFilter, triggerEvent, refCollection);
+        if(filterMatched) {
+          for(const LV& muon: filterMatched->muons) {
             hL2TrigMuonEtEffNum_->Fill(muon.pt());
             hL2TrigMuonEtaEffNum_->Fill(muon.eta());
             hL2TrigMuonPhiEffNum_->Fill(muon.phi());
@@ -366,13 +368,9 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
           
       // Numerators
       if(static_cast<size_t>(lastMatchedFilter) >= hltPath_.getLastL3MuonFilterIndex()) {
-        triggerObjs.clear();
-        matchedTriggerObjs.clear();
-        matchedOfflineObjs.clear();
-        hltPath_.getFilterObjects(triggerEvent, hltPath_.getLastL3MuonFilterIndex(), triggerObjs);
-        bool matched = hltPath_.offlineMatching(hltPath_.getLastL3MuonFilterIndex(), triggerObjs, refCollection, hltMatchDr_, matchedTriggerObjs, matchedOfflineObjs);
-        if(matched) {
-          for(const LV& muon: matchedOfflineObjs.muons) {
+        const HLTTauDQMOfflineObjects *filterMatched = matchedFilterObjects(hltPath_.getLastL3MuonFilterIndex(), lastMatchedFilter, triggerEvent, refCollection);
+        if(filterMatched) {
+          for(const LV& muon: filterMatched->muons) {
             hL3TrigMuonEtEffNum_->Fill(muon.pt());
             hL3TrigMuonEtaEffNum_->Fill(muon.eta());
             hL3TrigMuonPhiEffNum_->Fill(muon.phi());   
@@ -390,13 +388,9 @@ void HLTTauDQMPathPlotter::analyze(const edm::TriggerResults& triggerResults, co
 
       // Numerators
       if(static_cast<size_t>(lastMatchedMETFilter) >= hltPath_.getLastL2CaloMETFilterIndex()) {
-        triggerObjs.clear();
-        matchedTriggerObjs.clear(); 
-        matchedOfflineObjs.clear();
-        hltPath_.getFilterObjects(triggerEvent, hltPath_.getLastL2CaloMETFilterIndex(), triggerObjs);
-        bool matched = hltPath_.offlineMatching(hltPath_.getLastL2CaloMETFilterIndex(), triggerObjs, refCollection, hltMatchDr_, matchedTriggerObjs, matchedOfflineObjs);
-	if(matched) {
-          hL2TrigMETEtEffNum_->Fill(matchedOfflineObjs.met[0].pt());
+        const HLTTauDQMOfflineObjects *filterMatched = matchedFilterObjects(hltPath_.getLastL2CaloMETFilterIndex(), lastMatchedFilter, triggerEvent, refCollection);
+	if(filterMatched) {
+          hL2TrigMETEtEffNum_->Fill(filterMatched->met[0].pt());
         }
       }
     }
@@ -29,9 +29,9 @@ void HLTTauDQMPathSummaryPlotter::bookHistograms(DQMStore::IBooker &iBooker) {
 
 void HLTTauDQMPathSummaryPlotter::analyze(const edm::TriggerResults& triggerResults, const trigger::TriggerEvent& triggerEvent, const HLTTauDQMOfflineObjects& refCollection) {
   if(doRefAnalysis_) {
-    std::vector<HLTTauDQMPath::Object> triggerObjs;
-    std::vector<HLTTauDQMPath::Object> matchedTriggerObjs;
-    HLTTauDQMOfflineObjects matchedOfflineObjs;
+    std::vector<HLTTauDQMPath::Object>& triggerObjs = triggerObjs_;
+    std::vector<HLTTauDQMPath::Object>& matchedTriggerObjs = matchedTriggerObjs_;
+    HLTTauDQMOfflineObjects& matchedOfflineObjs = matchedOfflineObjs_;
 
     for(size_t i=0; i<pathObjects_.size(); ++i) {
       const HLTTauDQMPath *path = pathObjects_[i];
@@ -36,29 +36,31 @@ void HLTTauPostProcessor::dqmEndJob(DQMStore::IBooker& iBooker, DQMStore::IGette
     LogDebug("HLTTauDQMOffline") << "Folder " << dqmBaseFolder_ << " does not exist";
     return;
   }
-  iGetter.setCurrentFolder(dqmBaseFolder_);
-  for(const std::string& subfolder: iGetter.getSubdirs()) {
+  HLTFolderHarvester harvester;
+  for(const std::string& subfolder: HLTFolderHarvester::subdirs(iGetter, dqmBaseFolder_)) {
     std::size_t pos = subfolder.rfind("/");
     if(pos == std::string::npos)
       continue;
     ++pos; // position of first letter after /
     if(subfolder.compare(pos, 4, "HLT_") == 0) { // start with HLT_
       LogDebug("HLTTauDQMOffline") << "Processing path " << subfolder.substr(pos);
-      plotFilterEfficiencies(iBooker, iGetter, subfolder);
+      harvester.addFolder(iGetter, subfolder);
     }
   }
+  for(const HLTFolderHarvester::Folder& folder: harvester.folders())
+    plotFilterEfficiencies(iBooker, folder);
 }
 
-void HLTTauPostProcessor::plotFilterEfficiencies(DQMStore::IBooker& iBooker, DQMStore::IGetter& iGetter, const std::string& folder) const {
+void HLTTauPostProcessor::plotFilterEfficiencies(DQMStore::IBooker& iBooker, const HLTFolderHarvester::Folder& folder) const {
   // Get the source
-  const MonitorElement *eventsPerFilter = iGetter.get(folder+"/EventsPerFilter");
+  const MonitorElement *eventsPerFilter = folder.find("EventsPerFilter");
   if(!eventsPerFilter) {
-    LogDebug("HLTTauDQMOffline") << "ME " << folder << "/EventsPerFilter not found";
+    LogDebug("HLTTauDQMOffline") << "ME " << folder.path << "/EventsPerFilter not found";
     return;
   }
 
   // Book efficiency TProfile
-  iBooker.setCurrentFolder(folder);
+  iBooker.setCurrentFolder(folder.path);
   MonitorElement *efficiency = iBooker.bookProfile("EfficiencyRefPrevious", "Efficiency to previous filter", eventsPerFilter->getNbinsX()-1,0,eventsPerFilter->getNbinsX()-1, 100,0,1);
   efficiency->setAxisTitle("Efficiency", 2);
   const TAxis *xaxis = eventsPerFilter->getTH1F()->GetXaxis();
@@ -70,7 +72,7 @@ void HLTTauPostProcessor::plotFilterEfficiencies(DQMStore::IBooker& iBooker, DQM
   TProfile *prev = efficiency->getTProfile();
   for(int i=2; i <= eventsPerFilter->getNbinsX(); ++i) {
     if(eventsPerFilter->getBinContent(i-1) < eventsPerFilter->getBinContent(i)) {
-      LogDebug("HLTTauDQMOffline") << "HLTTauPostProcessor: Encountered denominator < numerator with efficiency plot EfficiencyRefPrevious in folder " << folder << ", bin " << i << " numerator " << eventsPerFilter->getBinContent(i) << " denominator " << eventsPerFilter->getBinContent(i-1);
+      LogDebug("HLTTauDQMOffline") << "HLTTauPostProcessor: Encountered denominator < numerator with efficiency plot EfficiencyRefPrevious in folder " << folder.path << ", bin " << i << " numerator " << eventsPerFilter->getBinContent(i) << " denominator " << eventsPerFilter->getBinContent(i-1);
       continue;
     }
     const std::tuple<float, float> effErr = calcEfficiency(eventsPerFilter->getBinContent(i), eventsPerFilter->getBinContent(i-1));
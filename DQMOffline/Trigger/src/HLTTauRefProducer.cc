@@ -25,11 +25,36 @@
 #include "DataFormats/CaloTowers/interface/CaloTowerFwd.h"
 #include "Math/GenVector/VectorUtil.h"
 
+#include <algorithm>
+#include <cmath>
+
 
 using namespace edm;
 using namespace reco;
 using namespace std;
 
+namespace {
+  //tower isolation cone, and the eta-phi grid used to find the towers inside it:
+  //the cells are at least as wide as the cone so a cone never reaches beyond
+  //the neighbouring cells, towers outside the eta range go in the edge cells
+  const double towerIsolCone = 0.5;
+  const double towerGridEtaMax = 6.;
+  const int towerGridNEta = static_cast<int>(2.*towerGridEtaMax/towerIsolCone);
+  const int towerGridNPhi = static_cast<int>(2.*M_PI/towerIsolCone);
+
+  int towerGridEtaBin(double eta)
+  {
+    int bin = static_cast<int>(std::floor((eta+towerGridEtaMax)/towerIsolCone));
+    return std::min(std::max(bin,0),towerGridNEta-1);
+  }
+
+  int towerGridPhiBin(double phi)
+  {
+    int bin = static_cast<int>(std::floor((phi+M_PI)*towerGridNPhi/(2.*M_PI)));
+    return std::min(std::max(bin,0),towerGridNPhi-1);
+  }
+}
+
 HLTTauRefProducer::HLTTauRefProducer(const edm::ParameterSet& iConfig)
 {
 
@@ -280,24 +305,48 @@ HLTTauRefProducer::doTowers(edm::Event& iEvent,const edm::EventSetup& iES)
       //Retrieve the collection
       edm::Handle<CaloTowerCollection> towers;
       if(iEvent.getByToken(Towers_,towers))
-      for(size_t i = 0 ;i<towers->size();++i)
 	{
-	     if((*towers)[i].pt()>ptMinTower_&&fabs((*towers)[i].eta())<etaMax)
-	      {
-		//calculate isolation
-		double isolET=0;
-		for(unsigned int j=0;j<towers->size();++j)
-		  {
-		    if(ROOT::Math::VectorUtil::DeltaR((*towers)[i].p4(),(*towers)[j].p4())<0.5)
-		      isolET+=(*towers)[j].pt();
-		  }
-		isolET-=(*towers)[i].pt();
-		if(isolET<towerIsol_)
-		  {
-		    LorentzVector vec((*towers)[i].px(),(*towers)[i].py(),(*towers)[i].pz(),(*towers)[i].energy());
-		    product_Towers->push_back(vec);
-		  }
-	      }
+	  //bin the towers so that the isolation only looks at the neighbouring cells
+	  towerGrid_.resize(towerGridNEta*towerGridNPhi);
+	  for(auto& cell : towerGrid_) cell.clear();
+	  towerGridCell_.resize(towers->size());
+	  for(size_t j = 0;j<towers->size();++j)
+	    {
+	      const CaloTower& tower = (*towers)[j];
+	      towerGridCell_[j] = towerGridEtaBin(tower.eta())*towerGridNPhi+towerGridPhiBin(tower.phi());
+	      towerGrid_[towerGridCell_[j]].push_back(j);
+	    }
+
+	  for(size_t i = 0 ;i<towers->size();++i)
+	    {
+	      if((*towers)[i].pt()>ptMinTower_&&fabs((*towers)[i].eta())<etaMax)
+		{
+		  //calculate isolation
+		  const int etaBin = towerGridCell_[i]/towerGridNPhi;
+		  const int phiBin = towerGridCell_[i]%towerGridNPhi;
+		  towerCone_.clear();
+		  for(int iEta = std::max(etaBin-1,0);iEta<=std::min(etaBin+1,towerGridNEta-1);++iEta)
+		    for(int dPhi = -1;dPhi<=1;++dPhi)
+		      {
+			const std::vector<unsigned int>& cell = towerGrid_[iEta*towerGridNPhi+(phiBin+dPhi+towerGridNPhi)%towerGridNPhi];
+			towerCone_.insert(towerCone_.end(),cell.begin(),cell.end());
+		      }
+		  //sum in collection order to get exactly the same isolation as looping over all towers
+		  std::sort(towerCone_.begin(),towerCone_.end());
+		  double isolET=0;
+		  for(unsigned int j : towerCone_)
+		    {
+		      if(ROOT::Math::VectorUtil::DeltaR((*towers)[i].p4(),(*towers)[j].p4())<towerIsolCone)
+			isolET+=(*towers)[j].pt();
+		    }
+		  isolET-=(*towers)[i].pt();
+		  if(isolET<towerIsol_)
+		    {
+		      LorentzVector vec((*towers)[i].px(),(*towers)[i].py(),(*towers)[i].pz(),(*towers)[i].energy());
+		      product_Towers->push_back(vec);
+		    }
+		}
+	    }
 	}
       iEvent.put(std::move(product_Towers),"Towers");
 }
@@ -5,7 +5,8 @@
 #include "DataFormats/HLTReco/interface/TriggerObject.h"
 #include "DQMOffline/Trigger/interface/HeavyIonUCCDQM.h"
 
-HeavyIonUCCDQM::HeavyIonUCCDQM(const edm::ParameterSet& ps)
+HeavyIonUCCDQM::HeavyIonUCCDQM(const edm::ParameterSet& ps):
+	pathMatcher_(ps.getParameter<std::string>("triggerPath"))
 {
 	triggerResults_ = consumes<edm::TriggerResults>(ps.getParameter<edm::InputTag>("triggerResults"));
 	theCaloMet = consumes<reco::CaloMETCollection>(ps.getParameter<edm::InputTag>("caloMet"));
@@ -49,14 +50,7 @@ void HeavyIonUCCDQM::analyze(edm::Event const& e, edm::EventSetup const& eSetup)
 		return;
 	}
 
-	bool hasFired = false;
-	const edm::TriggerNames& trigNames = e.triggerNames(*hltresults);
-	unsigned int numTriggers = trigNames.size();
-	for( unsigned int hltIndex=0; hltIndex<numTriggers; ++hltIndex ) {
-		if (trigNames.triggerName(hltIndex).find(triggerPath_) != std::string::npos && hltresults->wasrun(hltIndex) && hltresults->accept(hltIndex)){
-			hasFired = true;
-		}
-	}
+	const bool hasFired = pathMatcher_.accept(e.triggerNames(*hltresults), *hltresults);
 
 	if (!hasFired) return;
 
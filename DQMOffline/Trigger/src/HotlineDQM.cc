@@ -5,25 +5,51 @@
 #include "DataFormats/HLTReco/interface/TriggerObject.h"
 #include "DQMOffline/Trigger/interface/HotlineDQM.h"
 
+HotlineDQM::Hotline::Hotline(const edm::ParameterSet& ps):
+  triggerPath_(ps.getParameter<std::string>("triggerPath")),
+  pathMatcher_(triggerPath_),
+  triggerFilter_(ps.getParameter<edm::InputTag>("triggerFilter")),
+  useMuons(ps.getParameter<bool>("useMuons")),
+  useMet(ps.getParameter<bool>("useMet")),
+  usePFMet(ps.getParameter<bool>("usePFMet")),
+  useHT(ps.getParameter<bool>("useHT")),
+  usePhotons(ps.getParameter<bool>("usePhotons")),
+  h_MuPt(0), h_PhotonPt(0), h_HT(0), h_MetPt(0), h_PFMetPt(0),
+  h_OnlineMuPt(0), h_OnlinePhotonPt(0), h_OnlineHT(0), h_OnlineMetPt(0), h_OnlinePFMetPt(0)
+{
+}
+
 HotlineDQM::HotlineDQM(const edm::ParameterSet& ps)
 {
 
   edm::LogInfo("HotlineDQM") << "Constructor HotlineDQM::HotlineDQM " << std::endl;
+  // several paths can be monitored by one module, otherwise the module parameters describe the single path
+  const std::vector<edm::ParameterSet> hotlines = ps.getParameter<std::vector<edm::ParameterSet> >("hotlines");
+  if(hotlines.empty()) hotlines_.push_back(Hotline(ps));
+  for(auto const& hotline : hotlines) hotlines_.push_back(Hotline(hotline));
+
   // Get parameters from configuration file
-  theMuonCollection_ = consumes<reco::MuonCollection>(ps.getParameter<edm::InputTag>("muonCollection")); 
-  thePfMETCollection_ = consumes<reco::PFMETCollection>(ps.getParameter<edm::InputTag>("pfMetCollection"));
-  theMETCollection_ = consumes<reco::CaloMETCollection>(ps.getParameter<edm::InputTag>("caloMetCollection"));
-  theCaloJetCollection_ = consumes<reco::CaloJetCollection>(ps.getParameter<edm::InputTag>("caloJetCollection"));
-  thePhotonCollection_ = consumes<reco::PhotonCollection>(ps.getParameter<edm::InputTag>("photonCollection"));
+  if(anyUses(&Hotline::useMuons)) theMuonCollection_ = consumes<reco::MuonCollection>(ps.getParameter<edm::InputTag>("muonCollection")); 
+  if(anyUses(&Hotline::usePFMet)) thePfMETCollection_ = consumes<reco::PFMETCollection>(ps.getParameter<edm::InputTag>("pfMetCollection"));
+  if(anyUses(&Hotline::useMet)) theMETCollection_ = consumes<reco::CaloMETCollection>(ps.getParameter<edm::InputTag>("caloMetCollection"));
+  if(anyUses(&Hotline::useHT)) theCaloJetCollection_ = consumes<reco::CaloJetCollection>(ps.getParameter<edm::InputTag>("caloJetCollection"));
+  if(anyUses(&Hotline::usePhotons)) thePhotonCollection_ = consumes<reco::PhotonCollection>(ps.getParameter<edm::InputTag>("photonCollection"));
   theTrigSummary_ = consumes<trigger::TriggerEvent>(ps.getParameter<edm::InputTag>("trigSummary"));
   triggerResults_ = consumes<edm::TriggerResults>(ps.getParameter<edm::InputTag>("triggerResults"));
-  triggerPath_ = ps.getParameter<std::string>("triggerPath");
-  triggerFilter_ = ps.getParameter<edm::InputTag>("triggerFilter");
-  useMuons = ps.getParameter<bool>("useMuons");
-  useMet = ps.getParameter<bool>("useMet");
-  usePFMet = ps.getParameter<bool>("usePFMet");
-  useHT = ps.getParameter<bool>("useHT");
-  usePhotons = ps.getParameter<bool>("usePhotons");
+}
+
+bool HotlineDQM::anyUses(bool Hotline::* use) const {
+  for(auto const& hotline : hotlines_){
+    if(hotline.*use) return true;
+  }
+  return false;
+}
+
+bool HotlineDQM::anyFiredUses(bool Hotline::* use) const {
+  for(const Hotline* hotline : firedHotlines_){
+    if(hotline->*use) return true;
+  }
+  return false;
 }
 
 HotlineDQM::~HotlineDQM()
@@ -35,21 +61,25 @@ void HotlineDQM::bookHistograms(DQMStore::IBooker & ibooker_, edm::Run const &,
 {
     edm::LogInfo("HotlineDQM") << "HotlineDQM::bookHistograms" << std::endl;
 
-    ibooker_.cd();
-    ibooker_.setCurrentFolder("HLT/Hotline/" + triggerPath_);
+    for(auto& hotline : hotlines_){
+        ibooker_.cd();
+        ibooker_.setCurrentFolder("HLT/Hotline/" + hotline.triggerPath_);
 
-    //online quantities 
-    h_MuPt = ibooker_.book1D("MuPt", "Muon Pt; GeV", 20, 0.0, 2000.0);
-    h_PhotonPt = ibooker_.book1D("PhotonPt", "Photon Pt; GeV", 20, 0.0, 4000.0);
-    h_HT = ibooker_.book1D("HT", "HT; GeV", 20, 0.0, 6000.0);
-    h_MetPt = ibooker_.book1D("MetPt", "Calo MET; GeV", 20, 0.0, 2000);
-    h_PFMetPt = ibooker_.book1D("PFMetPt", "PF MET; GeV", 20, 0.0, 2000);
+        //offline quantities, only those of the path's mode
+        if(hotline.useMuons) hotline.h_MuPt = ibooker_.book1D("MuPt", "Muon Pt; GeV", 20, 0.0, 2000.0);
+        if(hotline.usePhotons) hotline.h_PhotonPt = ibooker_.book1D("PhotonPt", "Photon Pt; GeV", 20, 0.0, 4000.0);
+        if(hotline.useHT) hotline.h_HT = ibooker_.book1D("HT", "HT; GeV", 20, 0.0, 6000.0);
+        if(hotline.useMet) hotline.h_MetPt = ibooker_.book1D("MetPt", "Calo MET; GeV", 20, 0.0, 2000);
+        if(hotline.usePFMet) hotline.h_PFMetPt = ibooker_.book1D("PFMetPt", "PF MET; GeV", 20, 0.0, 2000);
 
-    if(useMuons) h_OnlineMuPt = ibooker_.book1D("OnlineMuPt", "Online Muon Pt; GeV", 20, 0.0, 2000.0);
-    if(usePhotons) h_OnlinePhotonPt = ibooker_.book1D("OnlinePhotonPt", "Online Photon Pt; GeV", 20, 0.0, 4000.0);
-    if(useHT) h_OnlineHT = ibooker_.book1D("OnlineHT", "Online HT; GeV", 20, 0.0, 6000.0);
-    if(useMet) h_OnlineMetPt = ibooker_.book1D("OnlineMetPt", "Online Calo MET; GeV", 20, 0.0, 2000);
-    if(usePFMet) h_OnlinePFMetPt = ibooker_.book1D("OnlinePFMetPt", "Online PF MET; GeV", 20, 0.0, 2000);
+        //online quantities
+
+        if(hotline.useMuons) hotline.h_OnlineMuPt = ibooker_.book1D("OnlineMuPt", "Online Muon Pt; GeV", 20, 0.0, 2000.0);
+        if(hotline.usePhotons) hotline.h_OnlinePhotonPt = ibooker_.book1D("OnlinePhotonPt", "Online Photon Pt; GeV", 20, 0.0, 4000.0);
+        if(hotline.useHT) hotline.h_OnlineHT = ibooker_.book1D("OnlineHT", "Online HT; GeV", 20, 0.0, 6000.0);
+        if(hotline.useMet) hotline.h_OnlineMetPt = ibooker_.book1D("OnlineMetPt", "Online Calo MET; GeV", 20, 0.0, 2000);
+        if(hotline.usePFMet) hotline.h_OnlinePFMetPt = ibooker_.book1D("OnlinePFMetPt", "Online PF MET; GeV", 20, 0.0, 2000);
+    }
 
     ibooker_.cd();
 }
@@ -57,52 +87,6 @@ void HotlineDQM::bookHistograms(DQMStore::IBooker & ibooker_, edm::Run const &,
 void HotlineDQM::analyze(edm::Event const& e, edm::EventSetup const& eSetup){
     edm::LogInfo("HotlineDQM") << "HotlineDQM::analyze" << std::endl;
 
-    //-------------------------------
-    //--- MET
-    //-------------------------------
-    edm::Handle<reco::PFMETCollection> pfMETCollection;
-    e.getByToken(thePfMETCollection_, pfMETCollection);
-    if ( !pfMETCollection.isValid() ){
-        edm::LogError ("HotlineDQM") << "invalid collection: PFMET" << "\n";
-        return;
-    }
-    edm::Handle<reco::CaloMETCollection> caloMETCollection;
-    e.getByToken(theMETCollection_, caloMETCollection);
-    if ( !caloMETCollection.isValid() ){
-        edm::LogError ("HotlineDQM") << "invalid collection: CaloMET" << "\n";
-        return;
-    }
-
-    //-------------------------------
-    //--- Jets
-    //-------------------------------
-    edm::Handle<reco::CaloJetCollection> caloJetCollection;
-    e.getByToken (theCaloJetCollection_,caloJetCollection);
-    if ( !caloJetCollection.isValid() ){
-        edm::LogError ("HotlineDQM") << "invalid collection: CaloJets" << "\n";
-        return;
-    }
-
-    //-------------------------------
-    //--- Muon
-    //-------------------------------
-    edm::Handle<reco::MuonCollection> MuonCollection;
-    e.getByToken (theMuonCollection_, MuonCollection);
-    if ( !MuonCollection.isValid() ){
-        edm::LogError ("HotlineDQM") << "invalid collection: Muons " << "\n";
-        return;
-    }
-
-    //-------------------------------
-    //--- Photon 
-    //-------------------------------
-    edm::Handle<reco::PhotonCollection> PhotonCollection;
-    e.getByToken (thePhotonCollection_, PhotonCollection);
-    if ( !PhotonCollection.isValid() ){
-        edm::LogError ("HotlineDQM") << "invalid collection: Photons " << "\n";
-        return;
-    }
-
     //-------------------------------
     //--- Trigger
     //-------------------------------
@@ -112,6 +96,15 @@ void HotlineDQM::analyze(edm::Event const& e, edm::EventSetup const& eSetup){
         edm::LogError ("HotlineDQM") << "invalid collection: TriggerResults" << "\n";
         return;
     }
+
+    const edm::TriggerNames& trigNames = e.triggerNames(*hltresults);
+    firedHotlines_.clear();
+    for(auto& hotline : hotlines_){
+        if(hotline.pathMatcher_.accept(trigNames, *hltresults)) firedHotlines_.push_back(&hotline);
+    }
+    // nothing else is read unless one of the paths fired
+    if(firedHotlines_.empty()) return;
+
     edm::Handle<trigger::TriggerEvent> triggerSummary;
     e.getByToken(theTrigSummary_, triggerSummary);
     if(!triggerSummary.isValid()) {
@@ -119,85 +112,145 @@ void HotlineDQM::analyze(edm::Event const& e, edm::EventSetup const& eSetup){
         return;
     }
 
-    bool hasFired = false;
-    const edm::TriggerNames& trigNames = e.triggerNames(*hltresults);
-    unsigned int numTriggers = trigNames.size();
-    for( unsigned int hltIndex=0; hltIndex<numTriggers; ++hltIndex ){
-        if (trigNames.triggerName(hltIndex).find(triggerPath_) != std::string::npos && hltresults->wasrun(hltIndex) && hltresults->accept(hltIndex)){
-            hasFired = true;
-        }
-    }
+    for(Hotline* hotline : firedHotlines_) fillOnlineHistograms(*hotline, *triggerSummary);
+    fillOfflineHistograms(e);
+}
 
+void HotlineDQM::fillOnlineHistograms(Hotline& hotline, const trigger::TriggerEvent& triggerSummary){
     //get online objects
     float ptMuon=-1, ptPhoton=-1, met=-1, pfMet=-1, ht = 0;
-    size_t filterIndex = triggerSummary->filterIndex( triggerFilter_ );
-    trigger::TriggerObjectCollection triggerObjects = triggerSummary->getObjects();
-    if( !(filterIndex >= triggerSummary->sizeFilters()) ){
-        const trigger::Keys& keys = triggerSummary->filterKeys( filterIndex );
+    size_t filterIndex = triggerSummary.filterIndex( hotline.triggerFilter_ );
+    const trigger::TriggerObjectCollection& triggerObjects = triggerSummary.getObjects();
+    if( !(filterIndex >= triggerSummary.sizeFilters()) ){
+        const trigger::Keys& keys = triggerSummary.filterKeys( filterIndex );
         for( size_t j = 0; j < keys.size(); ++j ){
-            trigger::TriggerObject foundObject = triggerObjects[keys[j]];
-            if(useMuons && fabs(foundObject.id()) == 13){ //muon
+            const trigger::TriggerObject& foundObject = triggerObjects[keys[j]];
+            if(hotline.useMuons && fabs(foundObject.id()) == 13){ //muon
                 if(foundObject.pt() > ptMuon) ptMuon = foundObject.pt();
             }
-            else if(usePhotons && fabs(foundObject.id()) == 0){ //photon
+            else if(hotline.usePhotons && fabs(foundObject.id()) == 0){ //photon
                 if(foundObject.pt() > ptPhoton) ptPhoton = foundObject.pt();
             }
-            else if(useMet && fabs(foundObject.id()) == 0){ //MET
+            else if(hotline.useMet && fabs(foundObject.id()) == 0){ //MET
                 met = foundObject.pt(); 
             }
-            else if(usePFMet && fabs(foundObject.id()) == 0){ //PFMET
+            else if(hotline.usePFMet && fabs(foundObject.id()) == 0){ //PFMET
                 pfMet = foundObject.pt();
             }
-            else if(useHT && fabs(foundObject.id()) == 89){ //HT
+            else if(hotline.useHT && fabs(foundObject.id()) == 89){ //HT
                 ht = foundObject.pt();
             }
         }
     }
 
-    if(hasFired) {
-        //fill appropriate online histogram
-        if(useMuons) h_OnlineMuPt->Fill(ptMuon);
-        if(usePhotons) h_OnlinePhotonPt->Fill(ptPhoton);
-        if(useMet) h_OnlineMetPt->Fill(met);
-        if(usePFMet) h_OnlinePFMetPt->Fill(pfMet);
-        if(useHT) h_OnlineHT->Fill(ht);
+    //fill appropriate online histogram
+    if(hotline.useMuons) hotline.h_OnlineMuPt->Fill(ptMuon);
+    if(hotline.usePhotons) hotline.h_OnlinePhotonPt->Fill(ptPhoton);
+    if(hotline.useMet) hotline.h_OnlineMetPt->Fill(met);
+    if(hotline.usePFMet) hotline.h_OnlinePFMetPt->Fill(pfMet);
+    if(hotline.useHT) hotline.h_OnlineHT->Fill(ht);
+}
+
+// each collection is read once for the fired hotlines using it, a missing one only skips its histogram
+void HotlineDQM::fillOfflineHistograms(edm::Event const& e){
 
+    //-------------------------------
+    //--- Muon
+    //-------------------------------
+    if(anyFiredUses(&Hotline::useMuons)){
+        edm::Handle<reco::MuonCollection> MuonCollection;
+        e.getByToken (theMuonCollection_, MuonCollection);
+        if ( !MuonCollection.isValid() ){
+            edm::LogError ("HotlineDQM") << "invalid collection: Muons " << "\n";
+        }
         //fill muon pt histogram
-        if(MuonCollection->size() > 0){
+        else if(MuonCollection->size() > 0){
             float maxMuPt = -1.0;
             for(auto &mu : *MuonCollection){
                 if(mu.pt() > maxMuPt) maxMuPt = mu.pt();
             }
-            h_MuPt->Fill(maxMuPt);
+            for(Hotline* hotline : firedHotlines_) if(hotline->useMuons) hotline->h_MuPt->Fill(maxMuPt);
         }
+    }
 
+    //-------------------------------
+    //--- Photon 
+    //-------------------------------
+    if(anyFiredUses(&Hotline::usePhotons)){
+        edm::Handle<reco::PhotonCollection> PhotonCollection;
+        e.getByToken (thePhotonCollection_, PhotonCollection);
+        if ( !PhotonCollection.isValid() ){
+            edm::LogError ("HotlineDQM") << "invalid collection: Photons " << "\n";
+        }
         //fill photon pt histogram
-        if(PhotonCollection->size() > 0){
+        else if(PhotonCollection->size() > 0){
             float maxPhoPt = -1.0;
             for(auto &pho : *PhotonCollection){
                 if(pho.pt() > maxPhoPt) maxPhoPt = pho.pt();
             }
-            h_PhotonPt->Fill(maxPhoPt);
+            for(Hotline* hotline : firedHotlines_) if(hotline->usePhotons) hotline->h_PhotonPt->Fill(maxPhoPt);
         }
+    }
 
+    //-------------------------------
+    //--- Jets
+    //-------------------------------
+    if(anyFiredUses(&Hotline::useHT)){
+        edm::Handle<reco::CaloJetCollection> caloJetCollection;
+        e.getByToken (theCaloJetCollection_,caloJetCollection);
+        if ( !caloJetCollection.isValid() ){
+            edm::LogError ("HotlineDQM") << "invalid collection: CaloJets" << "\n";
+        }
         //fill HT histogram
-        float caloHT = 0.0;
-        for (reco::CaloJetCollection::const_iterator i_calojet = caloJetCollection->begin(); i_calojet != caloJetCollection->end(); ++i_calojet){
-            if (i_calojet->pt() < 40) continue;
-            if (fabs(i_calojet->eta()) > 3.0) continue;
-            caloHT += i_calojet->pt();
+        else {
+            float caloHT = 0.0;
+            for (reco::CaloJetCollection::const_iterator i_calojet = caloJetCollection->begin(); i_calojet != caloJetCollection->end(); ++i_calojet){
+                if (i_calojet->pt() < 40) continue;
+                if (fabs(i_calojet->eta()) > 3.0) continue;
+                caloHT += i_calojet->pt();
+            }
+            for(Hotline* hotline : firedHotlines_) if(hotline->useHT) hotline->h_HT->Fill(caloHT);
         }
-        h_HT->Fill(caloHT);
+    }
 
+    //-------------------------------
+    //--- MET
+    //-------------------------------
+    if(anyFiredUses(&Hotline::useMet)){
+        edm::Handle<reco::CaloMETCollection> caloMETCollection;
+        e.getByToken(theMETCollection_, caloMETCollection);
+        if ( !caloMETCollection.isValid() ){
+            edm::LogError ("HotlineDQM") << "invalid collection: CaloMET" << "\n";
+        }
         //fill CaloMET histogram
-        h_MetPt->Fill(caloMETCollection->front().et()); 
+        else {
+            for(Hotline* hotline : firedHotlines_) if(hotline->useMet) hotline->h_MetPt->Fill(caloMETCollection->front().et());
+        }
+    }
 
+    if(anyFiredUses(&Hotline::usePFMet)){
+        edm::Handle<reco::PFMETCollection> pfMETCollection;
+        e.getByToken(thePfMETCollection_, pfMETCollection);
+        if ( !pfMETCollection.isValid() ){
+            edm::LogError ("HotlineDQM") << "invalid collection: PFMET" << "\n";
+        }
         //fill PFMET histogram
-        h_PFMetPt->Fill(pfMETCollection->front().et());
+        else {
+            for(Hotline* hotline : firedHotlines_) if(hotline->usePFMet) hotline->h_PFMetPt->Fill(pfMETCollection->front().et());
+        }
     }
 }
 
 void HotlineDQM::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription hotline;
+  hotline.add<std::string>("triggerPath","HLT_HT2000_v")->setComment("trigger path name");
+  hotline.add<edm::InputTag>("triggerFilter",edm::InputTag("hltHt2000","","HLT"))->setComment("name of the last filter in the path");
+  hotline.add<bool>("useMuons", false);
+  hotline.add<bool>("usePhotons", false);
+  hotline.add<bool>("useMet", false);
+  hotline.add<bool>("usePFMet", false);
+  hotline.add<bool>("useHT", false);
+
   edm::ParameterSetDescription desc;
   desc.add<edm::InputTag>("photonCollection", edm::InputTag("photons"));
   desc.add<edm::InputTag>("muonCollection", edm::InputTag("muons"));
@@ -213,6 +266,7 @@ void HotlineDQM::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
   desc.add<bool>("useMet", false);
   desc.add<bool>("usePFMet", false);
   desc.add<bool>("useHT", false);
+  desc.addVPSet("hotlines", hotline, std::vector<edm::ParameterSet>())->setComment("paths monitored by this module, if empty the path given by the parameters above");
   descriptions.add("HotlineDQM",desc);
 }
 
@@ -10,6 +10,8 @@
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 
+#include "DQMOffline/Trigger/interface/HLTFolderHarvester.h"
+
 JetMETHLTOfflineClient::JetMETHLTOfflineClient(const edm::ParameterSet& iConfig):conf_(iConfig)
 {
   debug_ = false;
@@ -36,30 +38,27 @@ void JetMETHLTOfflineClient::dqmEndJob(DQMStore::IBooker& ibooker, DQMStore::IGe
   LogDebug("JetMETHLTOfflineClient") << "dqmEndJob" << std::endl;
   if (debug_) std::cout << "dqmEndJob" << std::endl; 
 
-  std::vector<MonitorElement*> hltMEs;
-
-  // Look at all folders, go to the subfolder which includes the string "Eff"
-  std::vector<std::string> fullPathHLTFolders = igetter.getSubdirs();
+  // Snapshot all folders which include the string "Eff" and their subfolders
+  HLTFolderHarvester harvester;
+  std::vector<std::string> fullPathHLTFolders = HLTFolderHarvester::subdirs(igetter, dirName_);
   for(unsigned int i=0;i<fullPathHLTFolders.size();i++) {
     
     // Move on only if the folder name contains "Eff" Or "Trigger Summary"
     if (debug_) std::cout << fullPathHLTFolders[i] << std::endl;
-    if ((fullPathHLTFolders[i].find("Eff")!=std::string::npos)) {
-      ibooker.setCurrentFolder(fullPathHLTFolders[i]);
-    } 
-    else {
-      continue;
-    }
+    if ((fullPathHLTFolders[i].find("Eff")==std::string::npos)) continue;
 
-    // Look at all subfolders, go to the subfolder which includes the string "Eff"
-    std::vector<std::string> fullSubPathHLTFolders = igetter.getSubdirs();
+    std::vector<std::string> fullSubPathHLTFolders = HLTFolderHarvester::subdirs(igetter, fullPathHLTFolders[i]);
     for(unsigned int j=0;j<fullSubPathHLTFolders.size();j++) {
-
       if (debug_) std::cout << fullSubPathHLTFolders[j] << std::endl;      
-      ibooker.setCurrentFolder(fullSubPathHLTFolders[j]);
-      
+      harvester.addFolder(igetter, fullSubPathHLTFolders[j]);
+    }
+  }
+
+  for(const HLTFolderHarvester::Folder& folder: harvester.folders()) {
+      ibooker.setCurrentFolder(folder.path);
+
       // Look at all MonitorElements in this folder
-      hltMEs = igetter.getContents(fullSubPathHLTFolders[j]);
+      const std::vector<MonitorElement*>& hltMEs = folder.contents;
       LogDebug("JetMETHLTOfflineClient")<< "Number of MEs for this HLT path = " << hltMEs.size() << std::endl;
       
       for(unsigned int k=0;k<hltMEs.size();k++) {
@@ -104,7 +103,6 @@ void JetMETHLTOfflineClient::dqmEndJob(DQMStore::IBooker& ibooker, DQMStore::IGe
 	
         
       }       // Loop-k
-    }         // fullSubPath
-  }           // fullPath
+  }           // folders
 }
 
@@ -39,6 +39,7 @@ using namespace trigger;
 JetMETHLTOfflineSource::JetMETHLTOfflineSource(const edm::ParameterSet& iConfig)
   : isSetup_(false)
   , genTriggerEventFlagDCS_(new GenericTriggerEventFlag(iConfig.getParameter<edm::ParameterSet>("genericTriggerEventDCSPSet"),consumesCollector(), *this))
+  , timing_(iConfig)
 {
   LogDebug("JetMETHLTOfflineSource") << "constructor....";
   
@@ -112,6 +113,8 @@ JetMETHLTOfflineSource::~JetMETHLTOfflineSource()
 void
 JetMETHLTOfflineSource::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup)
 { 
+  HLTDQMTiming::Scope analyzeTimer(timing_, 0, iEvent.luminosityBlock());
+
   if (verbose_) {
     cout << endl;
     cout << "============================================================" << endl;
@@ -309,6 +312,20 @@ JetMETHLTOfflineSource::analyze(const edm::Event& iEvent, const edm::EventSetup&
   if(runStandalone_)            fillMEforTriggerNTfired();
 }
 
+//------------------------------------------------------------------------//
+void
+JetMETHLTOfflineSource::endLuminosityBlock(edm::LuminosityBlock const& lumi, edm::EventSetup const& c)
+{
+  rateAllAcc_.flush();
+  correlationAllAcc_.flush();
+  rateAllWrtMuAcc_.flush();
+  correlationAllWrtMuAcc_.flush();
+  rateAllWrtMBAcc_.flush();
+  correlationAllWrtMBAcc_.flush();
+  PVZAcc_.flush();
+  NVerticesAcc_.flush();
+}
+
 //------------------------------------------------------------------------//
 // Trigger summary for all paths
 void 
@@ -356,15 +373,15 @@ JetMETHLTOfflineSource::fillMEforMonTriggerSummary(const Event & iEvent, const e
     if(isHLTPathAccepted(v->getPath())) trigFirst = true;
     if(!trigFirst)continue;
     if(trigFirst){
-      rate_All->Fill(binV);
-      correlation_All->Fill(binV,binV);
+      rateAllAcc_.fill(binV);
+      correlationAllAcc_.fill(binV,binV);
       if(muTrig && runStandalone_){
-	rate_AllWrtMu->Fill(binV);
-	correlation_AllWrtMu->Fill(binV,binV);
+	rateAllWrtMuAcc_.fill(binV);
+	correlationAllWrtMuAcc_.fill(binV,binV);
       }
       if(mbTrig && runStandalone_){
-	rate_AllWrtMB->Fill(binV);
-	correlation_AllWrtMB->Fill(binV,binV);
+	rateAllWrtMBAcc_.fill(binV);
+	correlationAllWrtMBAcc_.fill(binV,binV);
       }
     }
     for(PathInfoCollection::iterator w = v+1; w!= hltPathsAll_.end(); ++w ){
@@ -372,14 +389,14 @@ JetMETHLTOfflineSource::fillMEforMonTriggerSummary(const Event & iEvent, const e
       double binW = TriggerPosition(w->getPath()); 
       if(isHLTPathAccepted(w->getPath()))trigSec = true;
       if(trigSec && trigFirst){
-	correlation_All->Fill(binV,binW);
-	if(muTrig && runStandalone_) correlation_AllWrtMu->Fill(binV,binW);
-	if(mbTrig && runStandalone_) correlation_AllWrtMB->Fill(binV,binW); 
+	correlationAllAcc_.fill(binV,binW);
+	if(muTrig && runStandalone_) correlationAllWrtMuAcc_.fill(binV,binW);
+	if(mbTrig && runStandalone_) correlationAllWrtMBAcc_.fill(binV,binW); 
       }
       if(!trigSec && trigFirst){
-	correlation_All->Fill(binW,binV); 
-	if(muTrig && runStandalone_) correlation_AllWrtMu->Fill(binW,binV);
-	if(mbTrig && runStandalone_) correlation_AllWrtMB->Fill(binW,binV);
+	correlationAllAcc_.fill(binW,binV); 
+	if(muTrig && runStandalone_) correlationAllWrtMuAcc_.fill(binW,binV);
+	if(mbTrig && runStandalone_) correlationAllWrtMBAcc_.fill(binW,binV);
       }
     }
   }
@@ -390,13 +407,13 @@ JetMETHLTOfflineSource::fillMEforMonTriggerSummary(const Event & iEvent, const e
   int vtxcnt=0;
   for (VertexCollection::const_iterator itv=Vtx->begin(); itv!=Vtx->end(); itv++){
     //if(vtxcnt>=20) break;
-    PVZ->Fill(itv->z());
+    PVZAcc_.fill(itv->z());
     //chi2vtx[vtxcnt] = itv->chi2();
     //ndofvtx[vtxcnt] = itv->ndof();
     //ntrkvtx[vtxcnt] = itv->tracksSize();
     vtxcnt++;
   }
-  NVertices->Fill(vtxcnt);
+  NVerticesAcc_.fill(vtxcnt);
 }
 
 //------------------------------------------------------------------------//
@@ -475,6 +492,7 @@ JetMETHLTOfflineSource::fillMEforMonAllTrigger(const Event & iEvent, const edm::
   
   const trigger::TriggerObjectCollection & toc(triggerObj_->getObjects());
   for(PathInfoCollection::iterator v = hltPathsAll_.begin(); v!= hltPathsAll_.end(); ++v ){
+    HLTDQMTiming::Scope pathTimer(timing_, 1 + (v - hltPathsAll_.begin()), iEvent.luminosityBlock());
     if (verbose_)
       cout << "   + Checking path " << v->getPath();
     if(isHLTPathAccepted(v->getPath())==false) {
@@ -805,6 +823,7 @@ JetMETHLTOfflineSource::fillMEforEffAllTrigger(const Event & iEvent, const edm::
   const trigger::TriggerObjectCollection & toc(triggerObj_->getObjects());
 
   for(PathInfoCollection::iterator v = hltPathsEff_.begin(); v!= hltPathsEff_.end(); ++v ){
+    HLTDQMTiming::Scope pathTimer(timing_, 1 + hltPathsAll_.size() + (v - hltPathsEff_.begin()), iEvent.luminosityBlock());
     num++;
     denom++;
     denompassed = false;
@@ -1567,9 +1586,17 @@ JetMETHLTOfflineSource::dqmBeginRun(edm::Run const& run,edm::EventSetup const& c
 void 
 JetMETHLTOfflineSource::bookHistograms(DQMStore::IBooker & iBooker, edm::Run const & run, edm::EventSetup const & c)
 {
+  timing_.beginBooking();
 
   if(!isSetup_){
 
+    timing_.clearScopes();
+    timing_.addScope("analyze");
+    for(PathInfoCollection::iterator v = hltPathsAll_.begin(); v!= hltPathsAll_.end(); ++v )
+      timing_.addScope(v->getPath());
+    for(PathInfoCollection::iterator v = hltPathsEff_.begin(); v!= hltPathsEff_.end(); ++v )
+      timing_.addScope("Eff_" + v->getPath());
+
     iBooker.setCurrentFolder(dirname_);
     
     //-----------------------------------------------------------------
@@ -1614,7 +1641,16 @@ JetMETHLTOfflineSource::bookHistograms(DQMStore::IBooker & iBooker, edm::Run con
 	histonm="JetMET_TriggerRate_Correlation_WrtMBTrigger";
 	histot="JetMET TriggerRate Correlation Wrt MB Trigger;y&&!x;x&&y";
 	correlation_AllWrtMB = iBooker.book2D(histonm.c_str(),histot.c_str(),TrigBins_,TrigMin_,TrigMax_,TrigBins_,TrigMin_,TrigMax_);
+
+	rateAllWrtMuAcc_        = HLTDQMHistoAccumulator(rate_AllWrtMu);
+	rateAllWrtMBAcc_        = HLTDQMHistoAccumulator(rate_AllWrtMB);
+	correlationAllWrtMuAcc_ = HLTDQMHistoAccumulator(correlation_AllWrtMu);
+	correlationAllWrtMBAcc_ = HLTDQMHistoAccumulator(correlation_AllWrtMB);
       }
+      rateAllAcc_        = HLTDQMHistoAccumulator(rate_All);
+      correlationAllAcc_ = HLTDQMHistoAccumulator(correlation_All);
+      PVZAcc_            = HLTDQMHistoAccumulator(PVZ);
+      NVerticesAcc_      = HLTDQMHistoAccumulator(NVertices);
       isSetup_ = true;
     }
     //---Set bin label
@@ -2982,7 +3018,8 @@ JetMETHLTOfflineSource::bookHistograms(DQMStore::IBooker & iBooker, edm::Run con
   }
   // Initialize the GenericTriggerEventFlag
   if ( genTriggerEventFlagDCS_ && genTriggerEventFlagDCS_->on() ) genTriggerEventFlagDCS_->initRun( run, c );
-  
+
+  timing_.bookHistograms(iBooker);
 }
 //------------------------------------------------------------------------//
 const std::string JetMETHLTOfflineSource::getL1ConditionModuleName(const std::string& pathname)
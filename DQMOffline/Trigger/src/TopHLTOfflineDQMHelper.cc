@@ -1,5 +1,6 @@
 #include "DQMOffline/Trigger/interface/TopHLTOfflineDQMHelper.h"
 #include <iostream>
+#include <algorithm>
 /*Originally from DQM/Physics package, written by Roger Wolf and Jeremy Andrea*/
 
 using namespace std;
@@ -177,52 +178,82 @@ CalculateHLT::operator()(const std::vector<reco::Jet>& jets)
   failed_= jets.size()<(unsigned int) maxNJets_;
   if( failed_){ return; }
 
+  failed_= !hadronicTop_(jets, maxNJets_, wMass_);
+  if( failed_){ return; }
+  massTopQuark_= hadronicTop_.massTopQuark();
+  massWBoson_= hadronicTop_.massWBoson();
+}
+
+
+HadronicTopKernel::HadronicTopKernel():
+  massTopQuark_(-1.), massWBoson_(-1.)
+{
+  topIndices_[0]=topIndices_[1]=topIndices_[2]=-1;
+  wIndices_[0]=wIndices_[1]=-1;
+}
+
+
+bool
+HadronicTopKernel::operator()(const std::vector<reco::Jet>& jets, unsigned int nJets, double wMass)
+{
+  if(nJets>jets.size()) nJets=jets.size();
+  if(nJets<3) return false;
+
+  px_.resize(nJets); py_.resize(nJets); pt_.resize(nJets); order_.resize(nJets);
+  for(unsigned int idx=0; idx<nJets; ++idx){
+    px_[idx]=jets[idx].px();
+    py_[idx]=jets[idx].py();
+    pt_[idx]=jets[idx].pt();
+    order_[idx]=idx;
+  }
+  std::stable_sort(order_.begin(), order_.end(), [this](int lhs, int rhs){ return pt_[lhs]>pt_[rhs]; });
+
   // associate those jets with maximum pt of the vectorial 
-  // sum to the hadronic decay chain
+  // sum to the hadronic decay chain; |pt(a+b+c)| <= pt(a)+pt(b)+pt(c) 
+  // and the jets come by decreasing pt, so a loop can stop once the 
+  // scalar sum drops below the best vectorial one
   double maxPt=-1.;
-  std::vector<int> maxPtIndices;
-  maxPtIndices.push_back(-1);
-  maxPtIndices.push_back(-1);
-  maxPtIndices.push_back(-1);
-  for(int idx=0; idx<maxNJets_; ++idx){
-    for(int jdx=0; jdx<maxNJets_; ++jdx){ if(jdx<=idx) continue;
-      for(int kdx=0; kdx<maxNJets_; ++kdx){ if(kdx==idx || kdx==jdx) continue;
-	reco::Particle::LorentzVector sum = jets[idx].p4()+jets[jdx].p4()+jets[kdx].p4();
-	if( maxPt<0. || maxPt<sum.pt() ){
-	  maxPt=sum.pt();
-	  maxPtIndices.clear();
-	  maxPtIndices.push_back(idx);
-	  maxPtIndices.push_back(jdx);
-	  maxPtIndices.push_back(kdx);
+  int best[3]={-1,-1,-1};
+  const int n=nJets;
+  for(int i=0; i<n-2; ++i){
+    if(maxPt>=0. && pt_[order_[i]]+pt_[order_[i+1]]+pt_[order_[i+2]]<maxPt) break;
+    for(int j=i+1; j<n-1; ++j){
+      if(maxPt>=0. && pt_[order_[i]]+pt_[order_[j]]+pt_[order_[j+1]]<maxPt) break;
+      for(int k=j+1; k<n; ++k){
+	if(maxPt>=0. && pt_[order_[i]]+pt_[order_[j]]+pt_[order_[k]]<maxPt) break;
+	// sum in collection order, as the p4 sum of the jets would
+	int triplet[3]={order_[i], order_[j], order_[k]};
+	std::sort(triplet, triplet+3);
+	double px=px_[triplet[0]]+px_[triplet[1]]+px_[triplet[2]];
+	double py=py_[triplet[0]]+py_[triplet[1]]+py_[triplet[2]];
+	double sumPt=sqrt(px*px+py*py);
+	// on ties keep the combination of the lowest jet indices
+	if( maxPt<sumPt || (maxPt==sumPt && std::lexicographical_compare(triplet, triplet+3, best, best+3)) ){
+	  maxPt=sumPt;
+	  best[0]=triplet[0]; best[1]=triplet[1]; best[2]=triplet[2];
 	}
       }
     }
   }
-  massTopQuark_= (jets[maxPtIndices[0]].p4()+
-		  jets[maxPtIndices[1]].p4()+
-		  jets[maxPtIndices[2]].p4()).mass();
+  topIndices_[0]=best[0]; topIndices_[1]=best[1]; topIndices_[2]=best[2];
+  massTopQuark_= (jets[best[0]].p4()+
+		  jets[best[1]].p4()+
+		  jets[best[2]].p4()).mass();
 
   // associate those jets that get closest to the W mass
   // with their invariant mass to the W boson
   double wDist =-1.;
-  std::vector<int> wMassIndices;
-  wMassIndices.push_back(-1);
-  wMassIndices.push_back(-1);
-  for(unsigned idx=0; idx<maxPtIndices.size(); ++idx){  
-    for(unsigned jdx=0; jdx<maxPtIndices.size(); ++jdx){  
-      if( jdx==idx || maxPtIndices[idx]>maxPtIndices[jdx] ) continue;
-	reco::Particle::LorentzVector sum = jets[maxPtIndices[idx]].p4()+jets[maxPtIndices[jdx]].p4();
-	if( wDist<0. || wDist>fabs(sum.mass()-wMass_) ){
-	  wDist=fabs(sum.mass()-wMass_);
-	  wMassIndices.clear();
-	  wMassIndices.push_back(maxPtIndices[idx]);
-	  wMassIndices.push_back(maxPtIndices[jdx]);
-	}
+  for(int idx=0; idx<3; ++idx){  
+    for(int jdx=idx+1; jdx<3; ++jdx){  
+      reco::Particle::LorentzVector sum = jets[best[idx]].p4()+jets[best[jdx]].p4();
+      if( wDist<0. || wDist>fabs(sum.mass()-wMass) ){
+	wDist=fabs(sum.mass()-wMass);
+	wIndices_[0]=best[idx];
+	wIndices_[1]=best[jdx];
+      }
     }
   }
-  massWBoson_= (jets[wMassIndices[0]].p4()+
-		jets[wMassIndices[1]].p4()).mass();
+  massWBoson_= (jets[wIndices_[0]].p4()+
+		jets[wIndices_[1]].p4()).mass();
+  return true;
 }
-
-
-
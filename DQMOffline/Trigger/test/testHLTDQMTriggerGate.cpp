@@ -0,0 +1,78 @@
+#include "DQMOffline/Trigger/interface/HLTDQMTriggerGate.h"
+
+#include "DataFormats/Common/interface/HLTGlobalStatus.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+// the path decisions of HLTDQMTriggerGate against those of GenericTriggerEventFlag
+class TestHLTDQMTriggerGate : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestHLTDQMTriggerGate);
+  CPPUNIT_TEST(singlePath);
+  CPPUNIT_TEST(wildcard);
+  CPPUNIT_TEST(unknownPath);
+  CPPUNIT_TEST(negation);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+  void tearDown() {}
+
+  void singlePath();
+  void wildcard();
+  void unknownPath();
+  void negation();
+
+private:
+  // paths 0: pass, 1: fail, 2: exception
+  static edm::TriggerResults results() {
+    edm::HLTGlobalStatus status(3);
+    status.at(0) = edm::HLTPathStatus(edm::hlt::Pass);
+    status.at(1) = edm::HLTPathStatus(edm::hlt::Fail);
+    status.at(2) = edm::HLTPathStatus(edm::hlt::Exception);
+    return edm::TriggerResults(status, edm::ParameterSetID());
+  }
+
+  static HLTDQMTriggerGate::PathTest test(const std::vector<unsigned int>& indices, bool negate) {
+    HLTDQMTriggerGate::PathTest test;
+    test.indices = indices;
+    test.negate = negate;
+    return test;
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestHLTDQMTriggerGate);
+
+void TestHLTDQMTriggerGate::singlePath() {
+  const edm::TriggerResults hlt = results();
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({0}, false), hlt, false));
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({1}, false), hlt, true));
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({2}, false), hlt, false));
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({2}, false), hlt, true));
+}
+
+// the paths matching a wildcard are ORed, a path in error counting as errorReply
+void TestHLTDQMTriggerGate::wildcard() {
+  const edm::TriggerResults hlt = results();
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({2, 0}, false), hlt, false));
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({2, 1}, false), hlt, false));
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({1, 2}, false), hlt, true));
+}
+
+void TestHLTDQMTriggerGate::unknownPath() {
+  const edm::TriggerResults hlt = results();
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({}, false), hlt, false));
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({}, false), hlt, true));
+}
+
+// "~" is applied after the errorReply substitution
+void TestHLTDQMTriggerGate::negation() {
+  const edm::TriggerResults hlt = results();
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({0}, true), hlt, false));
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({1}, true), hlt, false));
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({2}, true), hlt, false));
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({2}, true), hlt, true));
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({}, true), hlt, false));
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({}, true), hlt, true));
+  CPPUNIT_ASSERT(!HLTDQMTriggerGate::acceptPathTest(test({2, 0}, true), hlt, false));
+  CPPUNIT_ASSERT( HLTDQMTriggerGate::acceptPathTest(test({2, 1}, true), hlt, false));
+}